@@ -0,0 +1,124 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "qgstbenchmark.h"
+#include "hugepagearena.h"
+#include <QGst/Allocator>
+#include <QGst/Memory>
+#include <QGst/Buffer>
+#include <QGst/BufferPool>
+#include <QGst/Caps>
+
+/* Compares the system memory allocator with the huge page arena of the
+ * hugepage-arena example, for the allocation patterns of a video pipeline:
+ * allocating and freeing whole frames, and writing every page of them. */
+class AllocatorBenchmark : public QGstBenchmark
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void allocFreeBenchmark_data() { addAllocatorColumn(); }
+    void allocFreeBenchmark();
+    void touchPagesBenchmark_data() { addAllocatorColumn(); }
+    void touchPagesBenchmark();
+    void poolAcquireBenchmark_data() { addAllocatorColumn(); }
+    void poolAcquireBenchmark();
+
+private:
+    static void addAllocatorColumn();
+    static QGst::AllocatorPtr createAllocator(const QString & name);
+};
+
+//one 1080p I420 frame
+static const size_t FrameSize = 1920 * 1080 * 3 / 2;
+static const size_t PageSize = 4096;
+
+void AllocatorBenchmark::addAllocatorColumn()
+{
+    QTest::addColumn<QString>("allocator");
+    QTest::newRow("SystemMemory") << QString("SystemMemory");
+    QTest::newRow("HugePageArena") << QString("HugePageArena");
+}
+
+QGst::AllocatorPtr AllocatorBenchmark::createAllocator(const QString & name)
+{
+    if (name == QLatin1String("HugePageArena")) {
+        return QGst::CustomAllocator::create(new HugePageArena(FrameSize, 4));
+    }
+    return QGst::Allocator::getSystemMemory();
+}
+
+void AllocatorBenchmark::allocFreeBenchmark()
+{
+    QFETCH(QString, allocator);
+    QGst::AllocatorPtr a = createAllocator(allocator);
+
+    QBENCHMARK {
+        for (int i = 0; i < Iterations; ++i) {
+            QGst::MemoryPtr memory = a->alloc(FrameSize);
+            a->free(memory);
+        }
+    }
+}
+
+void AllocatorBenchmark::touchPagesBenchmark()
+{
+    QFETCH(QString, allocator);
+    QGst::AllocatorPtr a = createAllocator(allocator);
+    QGst::MemoryPtr memory = a->alloc(FrameSize);
+    QVERIFY(memory);
+
+    QGst::MapInfo info;
+    QVERIFY(memory->map(info, QGst::MapWrite));
+
+    QBENCHMARK {
+        for (int i = 0; i < Iterations; ++i) {
+            for (size_t offset = 0; offset < info.size(); offset += PageSize) {
+                info.data()[offset] = static_cast<quint8>(i);
+            }
+        }
+    }
+
+    memory->unmap(info);
+}
+
+void AllocatorBenchmark::poolAcquireBenchmark()
+{
+    QFETCH(QString, allocator);
+    QGst::BufferPoolPtr pool = QGst::BufferPool::create();
+    QGst::BufferPoolConfig config = pool->config();
+    config.setParams(QGst::CapsPtr(), FrameSize, 2, 4);
+    config.setAllocator(createAllocator(allocator));
+    QVERIFY(pool->setConfig(config));
+    QVERIFY(pool->setActive(true));
+
+    QBENCHMARK {
+        for (int i = 0; i < Iterations; ++i) {
+            QGst::BufferPtr buffer = pool->acquireBuffer();
+            //every buffer is written once, like a decoder would do
+            QGst::MapInfo info;
+            buffer->map(info, QGst::MapWrite);
+            info.data()[0] = static_cast<quint8>(i);
+            buffer->unmap(info);
+        }
+    }
+
+    pool->setActive(false);
+}
+
+QTEST_APPLESS_MAIN(AllocatorBenchmark)
+
+#include "moc_qgstbenchmark.cpp"
+#include "allocatorbenchmark.moc"
@@ -0,0 +1,143 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "qgstbenchmark.h"
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QEventLoop>
+#include <QtCore/QTimer>
+#include <QGlib/Connect>
+#include <QGlib/Signal>
+#include <QGst/Bus>
+#include <QGst/Message>
+#include <QGst/Structure>
+
+class BusBenchmark : public QGstBenchmark
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void watchLatencyBenchmark_data();
+    void watchLatencyBenchmark();
+
+private:
+    void onMessage(const QGst::MessagePtr &);
+
+    QEventLoop m_eventLoop;
+    QElapsedTimer *m_timer;
+    qint64 m_latency;
+};
+
+class LatencyPostThread : public QThread
+{
+public:
+    QGst::BusPtr bus;
+    QElapsedTimer timer;
+
+protected:
+    virtual void run()
+    {
+        msleep(7); //let the receiving event loop go idle first
+        timer.start();
+        bus->post(QGst::ApplicationMessage::create(bus, QGst::Structure("latency")));
+    }
+};
+
+/* Pops the bus from a 50 ms timer, like the signal watch used to do */
+class PollingBusWatch : public QObject
+{
+    Q_OBJECT
+public:
+    PollingBusWatch(const QGst::BusPtr & bus)
+        : QObject(), m_bus(bus)
+    {
+        QTimer *timer = new QTimer(this);
+        connect(timer, SIGNAL(timeout()), this, SLOT(dispatch()));
+        timer->start(50);
+    }
+
+private Q_SLOTS:
+    void dispatch()
+    {
+        QGst::MessagePtr msg;
+        while (!(msg = m_bus->pop()).isNull()) {
+            QGlib::emit<void>(m_bus, "message", msg);
+        }
+    }
+
+private:
+    QGst::BusPtr m_bus;
+};
+
+void BusBenchmark::onMessage(const QGst::MessagePtr & msg)
+{
+    Q_UNUSED(msg);
+    m_latency = m_timer->nsecsElapsed();
+    m_eventLoop.exit(1);
+}
+
+void BusBenchmark::watchLatencyBenchmark_data()
+{
+    QTest::addColumn<bool>("polling");
+    QTest::newRow("signal watch") << false;
+    QTest::newRow("50ms polling timer") << true;
+}
+
+/* Measures the average time between posting a message from another
+ * thread and receiving it in a slot connected to the "message" signal. */
+void BusBenchmark::watchLatencyBenchmark()
+{
+    QFETCH(bool, polling);
+    const int iterations = 20;
+
+    LatencyPostThread thread;
+    thread.bus = QGst::Bus::create();
+    m_timer = &thread.timer;
+
+    PollingBusWatch *pollingWatch = NULL;
+    if (polling) {
+        pollingWatch = new PollingBusWatch(thread.bus);
+    } else {
+        thread.bus->addSignalWatch();
+    }
+    QGlib::connect(thread.bus, "message", this, &BusBenchmark::onMessage);
+
+    QTimer timeout;
+    timeout.setSingleShot(true);
+    connect(&timeout, SIGNAL(timeout()), &m_eventLoop, SLOT(quit()));
+
+    qint64 total = 0;
+    for (int i = 0; i < iterations; ++i) {
+        thread.start();
+        timeout.start(5000);
+        QCOMPARE(m_eventLoop.exec(), 1);
+        timeout.stop();
+        thread.wait();
+        total += m_latency;
+    }
+
+    QGlib::disconnect(thread.bus, "message", this);
+    if (polling) {
+        delete pollingWatch;
+    } else {
+        thread.bus->removeSignalWatch();
+    }
+
+    QTest::setBenchmarkResult(total / iterations / 1000000.0, QTest::WalltimeMilliseconds);
+}
+
+QTEST_MAIN(BusBenchmark)
+
+#include "moc_qgstbenchmark.cpp"
+#include "busbenchmark.moc"
@@ -0,0 +1,80 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "qgstbenchmark.h"
+#include <QGst/Bin>
+
+class PropertiesBenchmark : public QGstBenchmark
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void getPropertyBenchmark_data();
+    void getPropertyBenchmark();
+};
+
+void PropertiesBenchmark::getPropertyBenchmark_data()
+{
+    QTest::addColumn<Implementation>("implementation");
+    QTest::newRow("QtGStreamer") << QtGStreamer;
+    QTest::newRow("QtGStreamer, PropertyHandle") << QtGStreamerHandle;
+    QTest::newRow("C") << C;
+}
+
+void PropertiesBenchmark::getPropertyBenchmark()
+{
+    QFETCH(Implementation, implementation);
+    QGst::BinPtr bin = QGst::Bin::create();
+    bool value = false;
+
+    switch (implementation) {
+    case QtGStreamer:
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                value ^= bin->property("async-handling").get<bool>();
+            }
+        }
+        break;
+    case QtGStreamerHandle:
+    {
+        QGlib::PropertyHandle asyncHandling = bin->propertyHandle("async-handling");
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                value ^= bin->property<bool>(asyncHandling);
+            }
+        }
+        break;
+    }
+    case C:
+    {
+        GstBin *gbin = bin;
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                gboolean asyncHandling;
+                g_object_get(gbin, "async-handling", &asyncHandling, NULL);
+                value ^= static_cast<bool>(asyncHandling);
+            }
+        }
+        break;
+    }
+    }
+
+    QCOMPARE(value, false);
+}
+
+QTEST_APPLESS_MAIN(PropertiesBenchmark)
+
+#include "moc_qgstbenchmark.cpp"
+#include "propertiesbenchmark.moc"
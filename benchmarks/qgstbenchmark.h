@@ -0,0 +1,63 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef QGSTBENCHMARK_H
+#define QGSTBENCHMARK_H
+
+#include <QtTest/QtTest>
+#include <QtCore/QThread>
+#include <QGst/Init>
+#include <gst/gst.h>
+
+/* Every benchmark runs the same operation once through the bindings and once
+ * through the plain GLib/GStreamer C API, so that the overhead of the bindings
+ * can be read directly from the results. The "C" row is the baseline. */
+enum Implementation { QtGStreamer, QtGStreamerHandle, C };
+Q_DECLARE_METATYPE(Implementation)
+
+/* Number of operations done in each QBENCHMARK iteration. Keeping it constant
+ * makes the results of different runs comparable. */
+static const int Iterations = 1000;
+
+class QGstBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase() { QGst::init(); }
+    void cleanupTestCase() { QGst::cleanup(); }
+
+protected:
+    static void addImplementationColumn()
+    {
+        QTest::addColumn<Implementation>("implementation");
+        QTest::newRow("QtGStreamer") << QtGStreamer;
+        QTest::newRow("C") << C;
+    }
+
+    /* Rows for 1, 2, 4... threads up to QThread::idealThreadCount(). With
+     * perfect scaling the time of a row stays the same as in the first one. */
+    static void addThreadCountColumn()
+    {
+        QTest::addColumn<int>("threads");
+        const int ideal = qMax(1, QThread::idealThreadCount());
+        for (int n = 1; n < ideal; n *= 2) {
+            QTest::newRow(QByteArray::number(n) + " threads") << n;
+        }
+        QTest::newRow(QByteArray::number(ideal) + " threads") << ideal;
+    }
+};
+
+#endif
@@ -0,0 +1,192 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "qgstbenchmark.h"
+#include <QGlib/Signal>
+#include <QGlib/Connect>
+#include <QGst/Bin>
+#include <QtCore/QThread>
+
+class SignalsBenchmark : public QGstBenchmark
+{
+    Q_OBJECT
+public:
+    SignalsBenchmark() : m_calls(0) {}
+
+private Q_SLOTS:
+    void emitBenchmark_data();
+    void emitBenchmark();
+    void connectDisconnectBenchmark_data() { addImplementationColumn(); }
+    void connectDisconnectBenchmark();
+    void closureInvocationBenchmark_data() { addImplementationColumn(); }
+    void closureInvocationBenchmark();
+    void connectContentionBenchmark_data() { addThreadCountColumn(); }
+    void connectContentionBenchmark();
+
+private:
+    void onNotify(const QGlib::ParamSpecPtr &) { ++m_calls; }
+    static void onNotifyC(GObject *, GParamSpec *, int *calls) { ++*calls; }
+
+    int m_calls;
+};
+
+void SignalsBenchmark::emitBenchmark_data()
+{
+    QTest::addColumn<Implementation>("implementation");
+    QTest::newRow("QtGStreamer") << QtGStreamer;
+    QTest::newRow("QtGStreamer, SignalHandle") << QtGStreamerHandle;
+    QTest::newRow("C") << C;
+}
+
+void SignalsBenchmark::emitBenchmark()
+{
+    QFETCH(Implementation, implementation);
+    QGst::BinPtr bin = QGst::Bin::create();
+    QGlib::ParamSpecPtr param = bin->findProperty("name");
+
+    switch (implementation) {
+    case QtGStreamer:
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                QGlib::emit<void>(bin, "notify::name", param);
+            }
+        }
+        break;
+    case QtGStreamerHandle:
+    {
+        QGlib::SignalHandle notify(QGlib::GetType<QGst::Bin>(), "notify::name");
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                QGlib::emit<void>(notify, bin, param);
+            }
+        }
+        break;
+    }
+    case C:
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                g_signal_emit_by_name(static_cast<GstBin*>(bin), "notify::name",
+                                      static_cast<GParamSpec*>(param));
+            }
+        }
+        break;
+    }
+}
+
+void SignalsBenchmark::connectDisconnectBenchmark()
+{
+    QFETCH(Implementation, implementation);
+    QGst::BinPtr bin = QGst::Bin::create();
+
+    if (implementation == C) {
+        GstBin *gbin = bin;
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                gulong id = g_signal_connect(gbin, "notify::name",
+                                             G_CALLBACK(&SignalsBenchmark::onNotifyC), &m_calls);
+                g_signal_handler_disconnect(gbin, id);
+            }
+        }
+    } else {
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                QGlib::connect(bin, "notify::name", this, &SignalsBenchmark::onNotify);
+                QGlib::disconnect(bin, "notify::name", this, &SignalsBenchmark::onNotify);
+            }
+        }
+    }
+}
+
+/* The signal is emitted the same way in both cases, so the difference
+ * is the cost of marshalling the arguments to the C++ slot. */
+void SignalsBenchmark::closureInvocationBenchmark()
+{
+    QFETCH(Implementation, implementation);
+    QGst::BinPtr bin = QGst::Bin::create();
+    GObject *object = G_OBJECT(static_cast<GstBin*>(bin));
+
+    if (implementation == C) {
+        g_signal_connect(object, "notify::name",
+                         G_CALLBACK(&SignalsBenchmark::onNotifyC), &m_calls);
+    } else {
+        QGlib::connect(bin, "notify::name", this, &SignalsBenchmark::onNotify);
+    }
+
+    m_calls = 0;
+    QBENCHMARK {
+        for (int i = 0; i < Iterations; ++i) {
+            g_object_notify(object, "name");
+        }
+    }
+    QVERIFY(m_calls >= Iterations);
+}
+
+class ConnectThread : public QThread
+{
+public:
+    void onNotify(const QGlib::ParamSpecPtr &) {}
+
+    int count;
+    int connected;
+
+protected:
+    virtual void run()
+    {
+        QGst::BinPtr bin = QGst::Bin::create();
+        connected = 0;
+        for (int i = 0; i < count; ++i) {
+            if (QGlib::connect(bin, "notify::name", this, &ConnectThread::onNotify)) {
+                ++connected;
+            }
+            QGlib::disconnect(bin, "notify::name", this, &ConnectThread::onNotify);
+        }
+    }
+};
+
+/* Connects and disconnects the same total number of handlers, split between
+ * threads that each use their own sender and receiver. The connections of
+ * unrelated senders live in different shards of the connections store, so
+ * the threads should not contend with each other. */
+void SignalsBenchmark::connectContentionBenchmark()
+{
+    QFETCH(int, threads);
+
+    QList<ConnectThread*> workers;
+    for (int i = 0; i < threads; ++i) {
+        ConnectThread *worker = new ConnectThread;
+        worker->count = 100 * Iterations / threads;
+        workers.append(worker);
+    }
+
+    QBENCHMARK_ONCE {
+        Q_FOREACH(ConnectThread *worker, workers) {
+            worker->start();
+        }
+        Q_FOREACH(ConnectThread *worker, workers) {
+            worker->wait();
+        }
+    }
+
+    Q_FOREACH(ConnectThread *worker, workers) {
+        QCOMPARE(worker->connected, worker->count);
+    }
+    qDeleteAll(workers);
+}
+
+QTEST_APPLESS_MAIN(SignalsBenchmark)
+
+#include "moc_qgstbenchmark.cpp"
+#include "signalsbenchmark.moc"
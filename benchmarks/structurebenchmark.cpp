@@ -0,0 +1,116 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "qgstbenchmark.h"
+#include <QGst/Structure>
+#include <QGst/Caps>
+
+class StructureBenchmark : public QGstBenchmark
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void getFieldBenchmark_data() { addImplementationColumn(); }
+    void getFieldBenchmark();
+    void setFieldBenchmark_data() { addImplementationColumn(); }
+    void setFieldBenchmark();
+    void capsFieldBenchmark_data() { addImplementationColumn(); }
+    void capsFieldBenchmark();
+};
+
+void StructureBenchmark::getFieldBenchmark()
+{
+    QFETCH(Implementation, implementation);
+    QGst::Structure s("video/x-raw");
+    s.setValue("width", 640);
+    int sum = 0;
+
+    if (implementation == C) {
+        const GstStructure *structure = s;
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                int width;
+                gst_structure_get_int(structure, "width", &width);
+                sum += width;
+            }
+        }
+    } else {
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                sum += s.value("width").get<int>();
+            }
+        }
+    }
+
+    QVERIFY(sum != 0);
+}
+
+void StructureBenchmark::setFieldBenchmark()
+{
+    QFETCH(Implementation, implementation);
+    QGst::Structure s("video/x-raw");
+
+    if (implementation == C) {
+        GstStructure *structure = s;
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                gst_structure_set(structure, "width", G_TYPE_INT, i, NULL);
+            }
+        }
+    } else {
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                s.setValue("width", i);
+            }
+        }
+    }
+
+    QVERIFY(s.hasField("width"));
+}
+
+void StructureBenchmark::capsFieldBenchmark()
+{
+    QFETCH(Implementation, implementation);
+    QGst::CapsPtr caps = QGst::Caps::fromString("video/x-raw, width=640, height=480");
+    int area = 0;
+
+    if (implementation == C) {
+        const GstCaps *gcaps = caps;
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                const GstStructure *structure = gst_caps_get_structure(gcaps, 0);
+                int width, height;
+                gst_structure_get_int(structure, "width", &width);
+                gst_structure_get_int(structure, "height", &height);
+                area += width * height;
+            }
+        }
+    } else {
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                QGst::StructurePtr structure = caps->internalStructure(0);
+                area += structure->value("width").get<int>()
+                      * structure->value("height").get<int>();
+            }
+        }
+    }
+
+    QVERIFY(area != 0);
+}
+
+QTEST_APPLESS_MAIN(StructureBenchmark)
+
+#include "moc_qgstbenchmark.cpp"
+#include "structurebenchmark.moc"
@@ -0,0 +1,204 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "qgstbenchmark.h"
+#include <QGlib/Value>
+#include <QGst/Bin>
+#include <cstring>
+
+class ValueBenchmark : public QGstBenchmark
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void intBenchmark_data() { addImplementationColumn(); }
+    void intBenchmark();
+    void stringBenchmark_data() { addImplementationColumn(); }
+    void stringBenchmark();
+    void enumBenchmark_data() { addImplementationColumn(); }
+    void enumBenchmark();
+    void objectBenchmark_data() { addImplementationColumn(); }
+    void objectBenchmark();
+    void getContentionBenchmark_data() { addThreadCountColumn(); }
+    void getContentionBenchmark();
+};
+
+void ValueBenchmark::intBenchmark()
+{
+    QFETCH(Implementation, implementation);
+    int sum = 0;
+
+    if (implementation == C) {
+        GValue value = G_VALUE_INIT;
+        g_value_init(&value, G_TYPE_INT);
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                g_value_set_int(&value, i);
+                sum += g_value_get_int(&value);
+            }
+        }
+        g_value_unset(&value);
+    } else {
+        QGlib::Value value = QGlib::Value::create(0);
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                value.set(i);
+                sum += value.get<int>();
+            }
+        }
+    }
+
+    QVERIFY(sum != 0);
+}
+
+void ValueBenchmark::stringBenchmark()
+{
+    QFETCH(Implementation, implementation);
+    int length = 0;
+
+    if (implementation == C) {
+        GValue value = G_VALUE_INIT;
+        g_value_init(&value, G_TYPE_STRING);
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                g_value_set_string(&value, "Hello world");
+                length += strlen(g_value_get_string(&value));
+            }
+        }
+        g_value_unset(&value);
+    } else {
+        const QString string = QLatin1String("Hello world");
+        QGlib::Value value = QGlib::Value::create(QString());
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                value.set(string);
+                length += value.get<QString>().length();
+            }
+        }
+    }
+
+    QVERIFY(length != 0);
+}
+
+void ValueBenchmark::enumBenchmark()
+{
+    QFETCH(Implementation, implementation);
+    int sum = 0;
+
+    if (implementation == C) {
+        GValue value = G_VALUE_INIT;
+        g_value_init(&value, GST_TYPE_STATE);
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                g_value_set_enum(&value, GST_STATE_PLAYING);
+                sum += g_value_get_enum(&value);
+            }
+        }
+        g_value_unset(&value);
+    } else {
+        QGlib::Value value = QGlib::Value::create(QGst::StateNull);
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                value.set(QGst::StatePlaying);
+                sum += value.get<QGst::State>();
+            }
+        }
+    }
+
+    QVERIFY(sum != 0);
+}
+
+void ValueBenchmark::objectBenchmark()
+{
+    QFETCH(Implementation, implementation);
+    QGst::BinPtr bin = QGst::Bin::create();
+    int found = 0;
+
+    if (implementation == C) {
+        GValue value = G_VALUE_INIT;
+        g_value_init(&value, GST_TYPE_ELEMENT);
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                g_value_set_object(&value, static_cast<GstBin*>(bin));
+                found += g_value_get_object(&value) != NULL;
+            }
+        }
+        g_value_unset(&value);
+    } else {
+        QGlib::Value value = QGlib::Value::create(QGst::ElementPtr());
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                value.set<QGst::ElementPtr>(bin);
+                found += !value.get<QGst::ElementPtr>().isNull();
+            }
+        }
+    }
+
+    QVERIFY(found != 0);
+}
+
+
+class GetValueThread : public QThread
+{
+public:
+    QGlib::Value intValue;
+    QGlib::Value enumValue;
+    int sum;
+
+protected:
+    virtual void run()
+    {
+        sum = 0;
+        for (int i = 0; i < 100 * Iterations; ++i) {
+            sum += intValue.get<int>();
+            sum += enumValue.get<QGst::State>();
+        }
+    }
+};
+
+/* Every thread reads its own values. get<int>() takes the fundamental
+ * type fast path and get<QGst::State>() the vtable cache, so neither
+ * should take a lock. */
+void ValueBenchmark::getContentionBenchmark()
+{
+    QFETCH(int, threads);
+
+    QList<GetValueThread*> workers;
+    for (int i = 0; i < threads; ++i) {
+        GetValueThread *worker = new GetValueThread;
+        worker->intValue = QGlib::Value(1);
+        worker->enumValue = QGlib::Value::create(QGst::StatePlaying);
+        workers.append(worker);
+    }
+
+    QBENCHMARK {
+        Q_FOREACH(GetValueThread *worker, workers) {
+            worker->start();
+        }
+        Q_FOREACH(GetValueThread *worker, workers) {
+            worker->wait();
+        }
+    }
+
+    Q_FOREACH(GetValueThread *worker, workers) {
+        QCOMPARE(worker->sum, 100 * Iterations * (1 + QGst::StatePlaying));
+    }
+    qDeleteAll(workers);
+}
+
+QTEST_APPLESS_MAIN(ValueBenchmark)
+
+#include "moc_qgstbenchmark.cpp"
+#include "valuebenchmark.moc"
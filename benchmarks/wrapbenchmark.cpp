@@ -0,0 +1,273 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "qgstbenchmark.h"
+#include <QtCore/QThread>
+#include <QGst/Bin>
+#include <QGst/Buffer>
+#include <QGst/ChildProxy>
+
+class WrapBenchmark : public QGstBenchmark
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void wrapObjectBenchmark_data() { addImplementationColumn(); }
+    void wrapObjectBenchmark();
+    void wrapMiniObjectBenchmark_data() { addImplementationColumn(); }
+    void wrapMiniObjectBenchmark();
+    void wrapInterfaceBenchmark_data() { addImplementationColumn(); }
+    void wrapInterfaceBenchmark();
+    void wrapperAllocationBenchmark_data() { addImplementationColumn(); }
+    void wrapperAllocationBenchmark();
+    void objectStoreContentionBenchmark_data();
+    void objectStoreContentionBenchmark();
+    void wrapContentionBenchmark_data();
+    void wrapContentionBenchmark();
+};
+
+void WrapBenchmark::wrapObjectBenchmark()
+{
+    QFETCH(Implementation, implementation);
+    GstElement *bin = gst_bin_new(NULL);
+    gst_object_ref_sink(bin);
+
+    if (implementation == C) {
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                gst_object_unref(gst_object_ref(bin));
+            }
+        }
+    } else {
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                QGst::BinPtr::wrap(GST_BIN(bin));
+            }
+        }
+    }
+
+    gst_object_unref(bin);
+}
+
+void WrapBenchmark::wrapMiniObjectBenchmark()
+{
+    QFETCH(Implementation, implementation);
+    GstBuffer *buffer = gst_buffer_new();
+
+    if (implementation == C) {
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                gst_buffer_unref(gst_buffer_ref(buffer));
+            }
+        }
+    } else {
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                QGst::BufferPtr::wrap(buffer);
+            }
+        }
+    }
+
+    gst_buffer_unref(buffer);
+}
+
+void WrapBenchmark::wrapInterfaceBenchmark()
+{
+    QFETCH(Implementation, implementation);
+    GstElement *bin = gst_bin_new(NULL);
+    gst_object_ref_sink(bin);
+
+    if (implementation == C) {
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                GstChildProxy *proxy = GST_CHILD_PROXY(gst_object_ref(bin));
+                gst_object_unref(proxy);
+            }
+        }
+    } else {
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                QGst::ChildProxyPtr::wrap(GST_CHILD_PROXY(bin));
+            }
+        }
+    }
+
+    gst_object_unref(bin);
+}
+
+/* Every native buffer gets a new wrapper, which is destroyed together with
+ * the buffer, like the buffers that an appsink delivers at frame rate. */
+void WrapBenchmark::wrapperAllocationBenchmark()
+{
+    QFETCH(Implementation, implementation);
+
+    if (implementation == C) {
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                gst_buffer_unref(gst_buffer_new());
+            }
+        }
+    } else {
+        QBENCHMARK {
+            for (int i = 0; i < Iterations; ++i) {
+                QGst::BufferPtr::wrap(gst_buffer_new(), false);
+            }
+        }
+    }
+}
+
+/* Each thread keeps taking and dropping references to a buffer. With a buffer
+ * per thread this measures how well the ObjectStore scales, while with a
+ * buffer shared by all threads it measures the worst case contention. */
+class RefThread : public QThread
+{
+public:
+    RefThread(Implementation implementation, GstBuffer *buffer)
+        : m_implementation(implementation), m_buffer(buffer) {}
+
+protected:
+    virtual void run();
+
+private:
+    Implementation m_implementation;
+    GstBuffer *m_buffer;
+};
+
+void RefThread::run()
+{
+    if (m_implementation == C) {
+        for (int i = 0; i < 100 * Iterations; ++i) {
+            gst_buffer_unref(gst_buffer_ref(m_buffer));
+        }
+    } else {
+        QGst::BufferPtr buffer = QGst::BufferPtr::wrap(m_buffer);
+        for (int i = 0; i < 100 * Iterations; ++i) {
+            QGst::BufferPtr copy = buffer;
+        }
+    }
+}
+
+void WrapBenchmark::objectStoreContentionBenchmark_data()
+{
+    QTest::addColumn<Implementation>("implementation");
+    QTest::addColumn<bool>("shared");
+    QTest::newRow("QtGStreamer, buffer per thread") << QtGStreamer << false;
+    QTest::newRow("C, buffer per thread") << C << false;
+    QTest::newRow("QtGStreamer, shared buffer") << QtGStreamer << true;
+    QTest::newRow("C, shared buffer") << C << true;
+}
+
+void WrapBenchmark::objectStoreContentionBenchmark()
+{
+    QFETCH(Implementation, implementation);
+    QFETCH(bool, shared);
+    const int threadCount = qMax(2, QThread::idealThreadCount());
+
+    QList<GstBuffer*> buffers;
+    QList<RefThread*> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        if (!shared || buffers.isEmpty()) {
+            buffers.append(gst_buffer_new());
+        }
+        threads.append(new RefThread(implementation, buffers.last()));
+    }
+
+    QBENCHMARK_ONCE {
+        Q_FOREACH(RefThread *thread, threads) {
+            thread->start();
+        }
+        Q_FOREACH(RefThread *thread, threads) {
+            thread->wait();
+        }
+    }
+
+    qDeleteAll(threads);
+    Q_FOREACH(GstBuffer *buffer, buffers) {
+        gst_buffer_unref(buffer);
+    }
+}
+
+/* Each thread keeps wrapping its own buffer. Looking up the cached wrapper
+ * must not serialize the threads, so with perfect scaling the time of every
+ * row stays the same as with one thread. */
+class WrapThread : public QThread
+{
+public:
+    explicit WrapThread(Implementation implementation)
+        : m_implementation(implementation), m_buffer(gst_buffer_new()) {}
+    virtual ~WrapThread() { gst_buffer_unref(m_buffer); }
+
+protected:
+    virtual void run();
+
+private:
+    Implementation m_implementation;
+    GstBuffer *m_buffer;
+};
+
+void WrapThread::run()
+{
+    if (m_implementation == C) {
+        for (int i = 0; i < 100 * Iterations; ++i) {
+            gst_buffer_unref(gst_buffer_ref(m_buffer));
+        }
+    } else {
+        for (int i = 0; i < 100 * Iterations; ++i) {
+            QGst::BufferPtr::wrap(m_buffer);
+        }
+    }
+}
+
+void WrapBenchmark::wrapContentionBenchmark_data()
+{
+    QTest::addColumn<Implementation>("implementation");
+    QTest::addColumn<int>("threads");
+    const int ideal = qMax(1, QThread::idealThreadCount());
+    for (int n = 1; ; n = qMin(2 * n, ideal)) {
+        QTest::newRow(QByteArray("QtGStreamer, ") + QByteArray::number(n) + " threads")
+            << QtGStreamer << n;
+        QTest::newRow(QByteArray("C, ") + QByteArray::number(n) + " threads") << C << n;
+        if (n == ideal) {
+            break;
+        }
+    }
+}
+
+void WrapBenchmark::wrapContentionBenchmark()
+{
+    QFETCH(Implementation, implementation);
+    QFETCH(int, threads);
+
+    QList<WrapThread*> wrapThreads;
+    for (int i = 0; i < threads; ++i) {
+        wrapThreads.append(new WrapThread(implementation));
+    }
+
+    QBENCHMARK_ONCE {
+        Q_FOREACH(WrapThread *thread, wrapThreads) {
+            thread->start();
+        }
+        Q_FOREACH(WrapThread *thread, wrapThreads) {
+            thread->wait();
+        }
+    }
+
+    qDeleteAll(wrapThreads);
+}
+
+QTEST_APPLESS_MAIN(WrapBenchmark)
+
+#include "moc_qgstbenchmark.cpp"
+#include "wrapbenchmark.moc"
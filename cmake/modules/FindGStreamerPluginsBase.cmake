@@ -37,7 +37,9 @@ macro(_find_gst_plugins_base_component _name _header)
 endmacro()
 
 foreach(_component ${GStreamerPluginsBase_FIND_COMPONENTS})
-    if (${_component} STREQUAL "app")
+    if (${_component} STREQUAL "allocators")
+        _find_gst_plugins_base_component(ALLOCATORS allocators.h)
+    elseif (${_component} STREQUAL "app")
         _find_gst_plugins_base_component(APP gstappsrc.h)
     elseif (${_component} STREQUAL "audio")
         _find_gst_plugins_base_component(AUDIO audio.h)
@@ -33,7 +33,9 @@ BaseDelegate::BaseDelegate(GstElement * sink, QObject * parent)
     , m_isActive(false)
     , m_buffer(NULL)
     , m_sink(sink)
+    , m_updateSignalId(g_signal_lookup("update", G_OBJECT_TYPE(sink)))
 {
+    Q_ASSERT(m_updateSignalId != 0);
 }
 
 BaseDelegate::~BaseDelegate()
@@ -193,5 +195,5 @@ bool BaseDelegate::event(QEvent *event)
 
 void BaseDelegate::update()
 {
-    g_signal_emit_by_name(m_sink, "update");
+    g_signal_emit(m_sink, m_updateSignalId, 0);
 }
@@ -144,6 +144,9 @@ protected:
 
     // the video sink element
     GstElement * const m_sink;
+
+    // the id of the sink's "update" signal, resolved once for update()
+    const guint m_updateSignalId;
 };
 
 #endif // BASEDELEGATE_H
@@ -23,6 +23,10 @@
 #include <QOpenGLFunctions>
 #include <QtQuick/QSGMaterialShader>
 
+#ifndef GL_UNPACK_ROW_LENGTH
+# define GL_UNPACK_ROW_LENGTH 0x0CF2
+#endif
+
 static const char * const qtvideosink_glsl_vertexShader =
     "uniform highp mat4 qt_Matrix;                      \n"
     "attribute highp vec4 qt_VertexPosition;            \n"
@@ -221,9 +225,7 @@ VideoMaterial *VideoMaterial::create(const BufferFormat & format)
     case GST_VIDEO_FORMAT_I420:
     case GST_VIDEO_FORMAT_YV12:
         material = new VideoMaterialImpl<qtvideosink_glsl_yuvPlanarFragmentShader>;
-        material->initYuv420PTextureInfo(
-            (format.videoFormat() == GST_VIDEO_FORMAT_YV12) /* uvSwapped */,
-            format.frameSize());
+        material->initYuv420PTextureInfo(format.frameSize());
         break;
 
     default:
@@ -231,6 +233,7 @@ VideoMaterial *VideoMaterial::create(const BufferFormat & format)
         break;
     }
 
+    material->m_videoInfo = format.videoInfo();
     material->init(format.colorMatrix());
     return material;
 }
@@ -238,6 +241,7 @@ VideoMaterial *VideoMaterial::create(const BufferFormat & format)
 VideoMaterial::VideoMaterial() :
     m_frame(0),
     m_textureCount(0),
+    m_hasUnpackRowLength(false),
     m_format(GST_VIDEO_FORMAT_UNKNOWN),
     m_textureFormat(0),
     m_textureInternalFormat(0),
@@ -245,6 +249,7 @@ VideoMaterial::VideoMaterial() :
     m_colorMatrixType(GST_VIDEO_COLOR_MATRIX_UNKNOWN)
 {
     memset(m_textureIds, 0, sizeof(m_textureIds));
+    gst_video_info_init(&m_videoInfo);
     setFlag(Blending, false);
 }
 
@@ -290,35 +295,36 @@ void VideoMaterial::initRgbTextureInfo(
     m_textureCount = 1;
     m_textureWidths[0] = size.width();
     m_textureHeights[0] = size.height();
-    m_textureOffsets[0] = 0;
 }
 
-void VideoMaterial::initYuv420PTextureInfo(bool uvSwapped, const QSize &size)
+void VideoMaterial::initYuv420PTextureInfo(const QSize &size)
 {
-    int bytesPerLine = (size.width() + 3) & ~3;
-    int bytesPerLine2 = (size.width() / 2 + 3) & ~3;
-
     m_textureInternalFormat = GL_LUMINANCE;
     m_textureFormat = GL_LUMINANCE;
     m_textureType = GL_UNSIGNED_BYTE;
     m_textureCount = 3;
-    m_textureWidths[0] = bytesPerLine;
+    m_textureWidths[0] = size.width();
     m_textureHeights[0] = size.height();
-    m_textureOffsets[0] = 0;
-    m_textureWidths[1] = bytesPerLine2;
-    m_textureHeights[1] = size.height() / 2;
-    m_textureOffsets[1] = bytesPerLine * size.height();
-    m_textureWidths[2] = bytesPerLine2;
-    m_textureHeights[2] = size.height() / 2;
-    m_textureOffsets[2] = bytesPerLine * size.height() + bytesPerLine2 * size.height()/2;
-
-    if (uvSwapped)
-      qSwap (m_textureOffsets[1], m_textureOffsets[2]);
+    m_textureWidths[1] = (size.width() + 1) / 2;
+    m_textureHeights[1] = (size.height() + 1) / 2;
+    m_textureWidths[2] = (size.width() + 1) / 2;
+    m_textureHeights[2] = (size.height() + 1) / 2;
 }
 
 void VideoMaterial::init(GstVideoColorMatrix colorMatrixType)
 {
     glGenTextures(m_textureCount, m_textureIds);
+
+    //GL_UNPACK_ROW_LENGTH is core in desktop GL and GLES 3, but not in GLES 2
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+#ifdef QT_OPENGL_ES
+    m_hasUnpackRowLength = context->format().majorVersion() >= 3
+                        || context->hasExtension("GL_EXT_unpack_subimage");
+#else
+    Q_UNUSED(context);
+    m_hasUnpackRowLength = true;
+#endif
+
     m_colorMatrixType = colorMatrixType;
     updateColors(0, 0, 0, 0);
 }
@@ -412,15 +418,18 @@ void VideoMaterial::bind()
     m_frameMutex.unlock();
 
     if (frame) {
-        GstMapInfo info;
-        gst_buffer_map(frame, &info, GST_MAP_READ);
-        functions->glActiveTexture(GL_TEXTURE1);
-        bindTexture(1, info.data);
-        functions->glActiveTexture(GL_TEXTURE2);
-        bindTexture(2, info.data);
-        functions->glActiveTexture(GL_TEXTURE0); // Finish with 0 as default texture unit
-        bindTexture(0, info.data);
-        gst_buffer_unmap(frame, &info);
+        //map through the video meta, if any, to find where each plane
+        //really starts, instead of assuming a tightly packed frame
+        GstVideoFrame videoFrame;
+        if (gst_video_frame_map(&videoFrame, &m_videoInfo, frame, GST_MAP_READ)) {
+            functions->glActiveTexture(GL_TEXTURE1);
+            bindTexture(1, &videoFrame);
+            functions->glActiveTexture(GL_TEXTURE2);
+            bindTexture(2, &videoFrame);
+            functions->glActiveTexture(GL_TEXTURE0); // Finish with 0 as default texture unit
+            bindTexture(0, &videoFrame);
+            gst_video_frame_unmap(&videoFrame);
+        }
         gst_buffer_unref(frame);
     } else {
         functions->glActiveTexture(GL_TEXTURE1);
@@ -432,19 +441,53 @@ void VideoMaterial::bind()
     }
 }
 
-void VideoMaterial::bindTexture(int i, const quint8 *data)
+/* Planar formats have one texture per component, in Y, U, V order,
+ * whatever the order of the planes in memory (I420 vs YV12).
+ * Packed formats have a single texture for plane 0. */
+void VideoMaterial::bindTexture(int i, GstVideoFrame *frame)
 {
+    if (i >= m_textureCount) {
+        glBindTexture(GL_TEXTURE_2D, m_textureIds[i]);
+        return;
+    }
+
+    const quint8 *data;
+    int stride;
+    if (m_textureCount == 1) {
+        data = static_cast<const quint8 *>(GST_VIDEO_FRAME_PLANE_DATA(frame, 0));
+        stride = GST_VIDEO_FRAME_PLANE_STRIDE(frame, 0);
+    } else {
+        data = static_cast<const quint8 *>(GST_VIDEO_FRAME_COMP_DATA(frame, i));
+        stride = GST_VIDEO_FRAME_COMP_STRIDE(frame, i);
+    }
+    const int pixelStride = GST_VIDEO_FRAME_COMP_PSTRIDE(frame, i);
+    const int width = m_textureWidths[i];
+    const int height = m_textureHeights[i];
+
     glBindTexture(GL_TEXTURE_2D, m_textureIds[i]);
-    glTexImage2D(
-        GL_TEXTURE_2D,
-        0,
-        m_textureInternalFormat,
-        m_textureWidths[i],
-        m_textureHeights[i],
-        0,
-        m_textureFormat,
-        m_textureType,
-        data + m_textureOffsets[i]);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    //the rows of the frame may be padded beyond the visible width, e.g. by a
+    //decoder or a video meta, so the stride has to be given to GL explicitly
+    if (stride == width * pixelStride) {
+        glTexImage2D(GL_TEXTURE_2D, 0, m_textureInternalFormat, width, height, 0,
+                     m_textureFormat, m_textureType, data);
+    } else if (m_hasUnpackRowLength && stride % pixelStride == 0) {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, stride / pixelStride);
+        glTexImage2D(GL_TEXTURE_2D, 0, m_textureInternalFormat, width, height, 0,
+                     m_textureFormat, m_textureType, data);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    } else {
+        //without GL_UNPACK_ROW_LENGTH, upload one row at a time
+        glTexImage2D(GL_TEXTURE_2D, 0, m_textureInternalFormat, width, height, 0,
+                     m_textureFormat, m_textureType, NULL);
+        for (int y = 0; y < height; ++y) {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, width, 1,
+                            m_textureFormat, m_textureType, data + y * stride);
+        }
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
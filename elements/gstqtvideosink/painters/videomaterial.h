@@ -46,11 +46,11 @@ protected:
     VideoMaterial();
     void initRgbTextureInfo(GLenum internalFormat, GLuint format,
                             GLenum type, const QSize &size);
-    void initYuv420PTextureInfo(bool uvSwapped, const QSize &size);
+    void initYuv420PTextureInfo(const QSize &size);
     void init(GstVideoColorMatrix colorMatrixType);
 
 private:
-    void bindTexture(int i, const quint8 *data);
+    void bindTexture(int i, GstVideoFrame *frame);
 
 
     GstBuffer *m_frame;
@@ -61,10 +61,11 @@ private:
     GLuint m_textureIds[Num_Texture_IDs];
     int m_textureWidths[Num_Texture_IDs];
     int m_textureHeights[Num_Texture_IDs];
-    int m_textureOffsets[Num_Texture_IDs];
+    bool m_hasUnpackRowLength;
     QSize m_textureSize;
 
     GstVideoFormat m_format;
+    GstVideoInfo m_videoInfo;
     GLenum m_textureFormat;
     GLuint m_textureInternalFormat;
     GLenum m_textureType;
@@ -0,0 +1,122 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "hugepagearena.h"
+#include <cstdlib>
+#include <sys/mman.h>
+
+static const size_t HugePageSize = 2 * 1024 * 1024;
+
+static size_t roundUp(size_t size, size_t multiple)
+{
+    return (size + multiple - 1) / multiple * multiple;
+}
+
+HugePageArena::HugePageArena(size_t slotSize, int slotCount)
+    : QGst::CustomAllocator("HugePageArenaMemory"),
+      m_arena(NULL), m_arenaSize(0), m_slotSize(roundUp(slotSize, 64)),
+      m_slotCount(slotCount), m_hugePages(false), m_heapAllocations(0)
+{
+    m_arenaSize = roundUp(m_slotSize * m_slotCount, HugePageSize);
+
+    void *arena = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    //explicit huge pages; only works if the administrator has reserved some
+    arena = mmap(NULL, m_arenaSize, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    m_hugePages = (arena != MAP_FAILED);
+#endif
+
+    if (arena == MAP_FAILED) {
+        arena = mmap(NULL, m_arenaSize, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#ifdef MADV_HUGEPAGE
+        //transparent huge pages, if enabled in "madvise" mode
+        if (arena != MAP_FAILED) {
+            m_hugePages = (madvise(arena, m_arenaSize, MADV_HUGEPAGE) == 0);
+        }
+#endif
+    }
+
+    if (arena == MAP_FAILED) {
+        m_arenaSize = 0;
+        m_slotCount = 0;
+        return;
+    }
+
+    m_arena = static_cast<quint8*>(arena);
+    m_freeSlots.reserve(m_slotCount);
+    for (int i = m_slotCount - 1; i >= 0; --i) {
+        m_freeSlots.append(i);
+    }
+}
+
+HugePageArena::~HugePageArena()
+{
+    //by now all memory has been freed, GStreamer keeps
+    //the allocator alive while any of its memory is in use
+    if (m_arena) {
+        munmap(m_arena, m_arenaSize);
+    }
+}
+
+int HugePageArena::freeSlotCount() const
+{
+    QMutexLocker locker(&m_lock);
+    return m_freeSlots.size();
+}
+
+int HugePageArena::heapAllocationCount() const
+{
+    QMutexLocker locker(&m_lock);
+    return m_heapAllocations;
+}
+
+bool HugePageArena::inArena(const quint8 *data) const
+{
+    return m_arena && data >= m_arena && data < m_arena + m_arenaSize;
+}
+
+bool HugePageArena::alloc(Block & block, size_t size, size_t align)
+{
+    Q_UNUSED(align); //slots are 64-byte aligned and the base class aligns the rest
+
+    {
+        QMutexLocker locker(&m_lock);
+        if (size <= m_slotSize && !m_freeSlots.isEmpty()) {
+            int slot = m_freeSlots.last();
+            m_freeSlots.pop_back();
+            block.data = m_arena + slot * m_slotSize;
+            block.size = m_slotSize;
+            return true;
+        }
+        m_heapAllocations++;
+    }
+
+    block.data = static_cast<quint8*>(::malloc(size));
+    block.size = size;
+    return block.data != NULL;
+}
+
+void HugePageArena::free(Block & block)
+{
+    if (inArena(block.data)) {
+        QMutexLocker locker(&m_lock);
+        m_freeSlots.append((block.data - m_arena) / m_slotSize);
+    } else {
+        ::free(block.data);
+    }
+}
@@ -0,0 +1,59 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef HUGEPAGEARENA_H
+#define HUGEPAGEARENA_H
+
+#include <QtCore/QMutex>
+#include <QtCore/QVector>
+#include <QGst/Allocator>
+
+/* An allocator that hands out fixed-size slots of one big arena that is
+ * backed by huge pages when the system allows it. Requests that do not
+ * fit in a slot, or that arrive while all slots are in use, are served
+ * from the heap instead. */
+class HugePageArena : public QGst::CustomAllocator
+{
+public:
+    HugePageArena(size_t slotSize, int slotCount);
+    virtual ~HugePageArena();
+
+    bool isValid() const { return m_arena != NULL; }
+    bool usesHugePages() const { return m_hugePages; }
+
+    size_t slotSize() const { return m_slotSize; }
+    int slotCount() const { return m_slotCount; }
+    int freeSlotCount() const;
+    int heapAllocationCount() const;
+
+protected:
+    virtual bool alloc(Block & block, size_t size, size_t align);
+    virtual void free(Block & block);
+
+private:
+    bool inArena(const quint8 *data) const;
+
+    mutable QMutex m_lock;
+    quint8 *m_arena;
+    size_t m_arenaSize;
+    size_t m_slotSize;
+    int m_slotCount;
+    bool m_hugePages;
+    QVector<int> m_freeSlots;
+    int m_heapAllocations;
+};
+
+#endif
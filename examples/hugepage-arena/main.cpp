@@ -0,0 +1,89 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <iostream>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QList>
+#include <QGst/Init>
+#include <QGst/Buffer>
+#include <QGst/BufferPool>
+#include <QGst/Caps>
+#include <QGst/Query>
+#include "hugepagearena.h"
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+    QGst::init(&argc, &argv);
+
+    {
+        //room for eight 720p I420 frames
+        const uint frameSize = 1280 * 720 * 3 / 2;
+        HugePageArena *arena = new HugePageArena(frameSize, 8);
+        if (!arena->isValid()) {
+            std::cerr << "Failed to map the arena" << std::endl;
+            delete arena;
+            return 1;
+        }
+        std::cout << "Arena of " << arena->slotCount() << " slots of "
+                  << arena->slotSize() << " bytes, "
+                  << (arena->usesHugePages() ? "using" : "not using")
+                  << " huge pages" << std::endl;
+
+        //the GstAllocator owns the arena from now on
+        QGst::AllocatorPtr allocator = QGst::CustomAllocator::create(arena);
+
+        //make it available to any element that looks it up by name
+        QGst::Allocator::registerAllocator("hugepage-arena", allocator);
+
+        //this is how a sink would offer it to upstream elements
+        //when it answers an allocation query
+        QGst::CapsPtr caps = QGst::Caps::fromString(
+                "video/x-raw, format=(string)I420, width=(int)1280, height=(int)720");
+        QGst::AllocationQueryPtr query = QGst::AllocationQuery::create(caps, true);
+        query->addAllocationParam(allocator, QGst::AllocationParams());
+
+        //a buffer pool that draws its memory from the arena
+        QGst::BufferPoolPtr pool = QGst::BufferPool::create();
+        QGst::BufferPoolConfig config = pool->config();
+        config.setParams(caps, frameSize, 4, 8);
+        config.setAllocator(query->allocator(0), query->allocationParams(0));
+        if (!pool->setConfig(config) || !pool->setActive(true)) {
+            std::cerr << "Failed to configure the buffer pool" << std::endl;
+            return 1;
+        }
+
+        QList<QGst::BufferPtr> buffers;
+        for (int i = 0; i < 8; ++i) {
+            buffers.append(pool->acquireBuffer());
+        }
+        std::cout << "Acquired " << buffers.size() << " buffers, "
+                  << arena->freeSlotCount() << " slots left, "
+                  << arena->heapAllocationCount() << " heap allocations" << std::endl;
+
+        //an allocation that does not fit in a slot comes from the heap
+        QGst::MemoryPtr big = allocator->alloc(frameSize * 2);
+        std::cout << "Oversized allocation served from the heap: "
+                  << arena->heapAllocationCount() << " heap allocations" << std::endl;
+
+        big.clear();
+        buffers.clear();
+        pool->setActive(false);
+    }
+
+    QGst::cleanup();
+    return 0;
+}
@@ -17,8 +17,10 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "connect.h"
+#include <cstring>
 #include <glib-object.h>
 #include <QtCore/QHash>
+#include <QtCore/QList>
 #include <QtCore/QMutex>
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
@@ -37,19 +39,25 @@ static void c_marshaller(GClosure *closure, GValue *returnValue, uint paramValue
 
     ClosureDataBase *cdata = static_cast<ClosureDataBase*>(closure->data);
 
-    QList<Value> params;
     //the signal sender is always the first argument. if we are instructed not to pass it
-    //as an argument to the slot, begin converting from paramValues[1]
-    for(uint i = cdata->passSender ? 0 : 1; i<paramValuesCount; ++i) {
-        params.append(Value(&paramValues[i]));
-    }
+    //as an argument to the slot, begin from paramValues[1]. The slot arguments are
+    //converted directly from the GValues of the emission, without copying them.
+    const uint firstParam = (cdata->passSender || paramValuesCount == 0) ? 0 : 1;
+    ValueArrayView params(paramValues + firstParam, paramValuesCount - firstParam);
+
+    //an invalid value stands for the return value of signals that return void
+    GValue voidValue;
+    std::memset(&voidValue, 0, sizeof(GValue));
+    ValueArrayView returnView(returnValue ? returnValue : &voidValue, 1);
 
     try {
-        Value result(returnValue);
+        //setting the result detaches it from returnValue, so it is copied back below
+        Value & result = returnView.at(0);
         cdata->marshaller(result, params);
 
-        if (returnValue && G_IS_VALUE(returnValue)) {
-            g_value_copy(result, returnValue);
+        const GValue *resultValue = static_cast<const Value &>(result);
+        if (returnValue && G_IS_VALUE(returnValue) && resultValue != returnValue) {
+            g_value_copy(resultValue, returnValue);
         }
     } catch (const std::exception & e) {
         QString signalName;
@@ -67,7 +75,7 @@ static void c_marshaller(GClosure *closure, GValue *returnValue, uint paramValue
             }
         }
 
-        QString instanceName = params.at(0).get<QString>();
+        QString instanceName = params.size() > 0 ? params.at(0).get<QString>() : QString();
 
         //attempt to determine the cause of the failure
         QString msg;
@@ -150,11 +158,23 @@ bool QObjectDestroyNotifier::disconnect(void* receiver, QObject *notificationRec
 //END ******** QObjectDestroyNotifier ********
 //BEGIN ******** ConnectionsStore ********
 
+/* The store is split in ShardCount shards, so that connecting and disconnecting
+ * on unrelated objects does not contend on a single lock. The connections of a
+ * sender are kept in a hash in the shard that the sender's address maps to and are
+ * protected by the connections lock of that shard. They are looked up only by the
+ * sender's address, never by dereferencing the sender, because onReceiverDestroyed()
+ * looks up senders that it does not hold a reference on and that may already have been
+ * finalized by another thread. The receivers are kept in the shard that the
+ * receiver's address maps to and are protected by its receivers lock.
+ *
+ * A receivers lock may be taken while holding a connections lock, but not the
+ * other way around, and no thread ever holds two locks of the same kind.
+ */
 class ConnectionsStore : public QObject
 {
     Q_OBJECT
 public:
-    inline ConnectionsStore() : QObject(), m_handlerIdInRemoval(0) {}
+    inline ConnectionsStore() : QObject() {}
 
     ulong connect(void *instance, uint signal, Quark detail,
                   void *receiver, const DestroyNotifierIfacePtr & notifier,
@@ -164,15 +184,30 @@ public:
                     void *receiver, uint slotHash, ulong handlerId);
 
 private:
+    /* The data of the closure's finalize notifier. inRemoval is set by disconnectHandler()
+     * while the connections lock is held, so that the notifier does not try to take it again */
+    struct ClosureWatch
+    {
+        inline ClosureWatch(void *instance, ulong handlerId)
+            : instance(instance), handlerId(handlerId), inRemoval(false)
+        {
+        }
+
+        void *instance;
+        ulong handlerId;
+        bool inRemoval;
+    };
+
     struct Connection
     {
         inline Connection(uint signal, Quark detail, void *receiver,
-                          uint slotHash, ulong handlerId)
+                          uint slotHash, ulong handlerId, ClosureWatch *watch)
             : signal(signal),
               detail(detail),
               receiver(receiver),
               slotHash(slotHash),
-              handlerId(handlerId)
+              handlerId(handlerId),
+              watch(watch)
         {
         }
 
@@ -181,26 +216,9 @@ private:
         void *receiver;
         uint slotHash;
         ulong handlerId;
+        ClosureWatch *watch;
     };
 
-    bool lookupAndExec(void *instance, uint signal, Quark detail, void *receiver, uint slotHash,
-                       ulong handlerId, void (ConnectionsStore::*func)(void*, const Connection &));
-
-    void disconnectHandler(void *instance, const Connection & c);
-    void disconnectAndDestroyRcvrWatch(void *instance, const Connection & c);
-
-    void setupClosureWatch(void *instance, ulong handlerId, GClosure *closure);
-    void onClosureDestroyedAction(void *instance, ulong handlerId);
-    static void onClosureDestroyed(void *data, GClosure *closure);
-
-    void setupReceiverWatch(void *instance, void *receiver, const DestroyNotifierIfacePtr & notifier);
-    void destroyReceiverWatch(void *instance, const Connection & c);
-
-private Q_SLOTS:
-    void onReceiverDestroyed(void *receiver);
-    void onReceiverDestroyed(QObject *receiver);
-
-private:
     //tags
     struct sequential {};
     struct by_handlerId {};
@@ -241,12 +259,47 @@ private:
         QHash<void*, int> senders; //<sender, refcount>
     };
 
-    QMutex m_mutex;
-    QHash<void*, ConnectionsContainer> m_connections; // <sender, connections>
-    QHash<void*, ReceiverData> m_receivers; // <receiver, data>
+    enum { ShardCount = 64 };
+
+    struct Shard
+    {
+        QMutex connectionsMutex;
+        QHash<void*, ConnectionsContainer*> connections; // <sender, connections>
+
+        QMutex receiversMutex;
+        QHash<void*, ReceiverData> receivers; // <receiver, data>
+    };
+
+    inline Shard & shardOf(void *ptr)
+    {
+        //discard the alignment bits of the address
+        const quintptr p = reinterpret_cast<quintptr>(ptr);
+        return m_shards[uint((p >> 4) ^ (p >> 12)) % ShardCount];
+    }
+
+    //these must be called with the connections lock of the instance's shard held
+    ConnectionsContainer *findConnections(void *instance);
+    ConnectionsContainer *findOrCreateConnections(void *instance);
+    void removeConnections(void *instance);
+
+    bool lookupAndExec(void *instance, uint signal, Quark detail, void *receiver, uint slotHash,
+                       ulong handlerId, void (ConnectionsStore::*func)(void*, const Connection &));
+
+    void disconnectHandler(void *instance, const Connection & c);
+    void disconnectAndDestroyRcvrWatch(void *instance, const Connection & c);
+
+    void onClosureDestroyedAction(void *instance, ulong handlerId);
+    static void onClosureDestroyed(void *data, GClosure *closure);
+
+    void setupReceiverWatch(void *instance, void *receiver, const DestroyNotifierIfacePtr & notifier);
+    void destroyReceiverWatch(void *instance, const Connection & c);
+
+private Q_SLOTS:
+    void onReceiverDestroyed(void *receiver);
+    void onReceiverDestroyed(QObject *receiver);
 
-    QMutex m_handlerIdInRemovalMutex;
-    ulong m_handlerIdInRemoval;
+private:
+    Shard m_shards[ShardCount];
 };
 
 Q_GLOBAL_STATIC(ConnectionsStore, s_connectionsStore)
@@ -255,21 +308,24 @@ ulong ConnectionsStore::connect(void *instance, uint signal, Quark detail,
                                 void *receiver, const DestroyNotifierIfacePtr & notifier,
                                 uint slotHash, ClosureDataBase *closureData, ConnectFlags flags)
 {
-    QMutexLocker l(&m_mutex);
     GClosure *closure = createCppClosure(closureData);
+    QMutexLocker l(&shardOf(instance).connectionsMutex);
 
     ulong handlerId = g_signal_connect_closure_by_id(instance, signal, detail, closure,
                                                      (flags & ConnectAfter) ? TRUE : FALSE);
 
     if (handlerId) {
-        m_connections[instance].get<sequential>().push_back(
-            Connection(signal, detail, receiver, slotHash, handlerId)
+        ClosureWatch *watch = new ClosureWatch(instance, handlerId);
+        g_closure_add_finalize_notifier(closure, watch, &ConnectionsStore::onClosureDestroyed);
+
+        findOrCreateConnections(instance)->get<sequential>().push_back(
+            Connection(signal, detail, receiver, slotHash, handlerId, watch)
         );
 
-        setupClosureWatch(instance, handlerId, closure);
         setupReceiverWatch(instance, receiver, notifier);
     }
 
+    l.unlock();
     g_closure_unref(closure);
     return handlerId;
 }
@@ -277,31 +333,50 @@ ulong ConnectionsStore::connect(void *instance, uint signal, Quark detail,
 bool ConnectionsStore::disconnect(void *instance, uint signal, Quark detail,
                                   void *receiver, uint slotHash, ulong handlerId)
 {
-    QMutexLocker l(&m_mutex);
+    QMutexLocker l(&shardOf(instance).connectionsMutex);
     return lookupAndExec(instance, signal, detail, receiver, slotHash, handlerId,
                          &ConnectionsStore::disconnectAndDestroyRcvrWatch);
 }
 
+ConnectionsStore::ConnectionsContainer *ConnectionsStore::findConnections(void *instance)
+{
+    return shardOf(instance).connections.value(instance);
+}
+
+ConnectionsStore::ConnectionsContainer *ConnectionsStore::findOrCreateConnections(void *instance)
+{
+    ConnectionsContainer *container = findConnections(instance);
+    if (!container) {
+        container = new ConnectionsContainer;
+        shardOf(instance).connections.insert(instance, container);
+    }
+    return container;
+}
+
+void ConnectionsStore::removeConnections(void *instance)
+{
+    delete shardOf(instance).connections.take(instance);
+}
+
 bool ConnectionsStore::lookupAndExec(void *instance, uint signal, Quark detail,
                                      void *receiver, uint slotHash, ulong handlerId,
                                      void (ConnectionsStore::*func)(void*, const Connection &))
 {
     bool executed = false;
+    ConnectionsContainer *container = findConnections(instance);
 
-    if (m_connections.contains(instance)) {
-        ConnectionsContainer & container = m_connections[instance];
-
+    if (container) {
         if (handlerId) {
-            ByHandlerIterator it = container.get<by_handlerId>().find(handlerId);
+            ByHandlerIterator it = container->get<by_handlerId>().find(handlerId);
 
-            if (it != container.get<by_handlerId>().end()) {
+            if (it != container->get<by_handlerId>().end()) {
                 (this->*func)(instance, *it);
                 executed = true;
 
-                container.get<by_handlerId>().erase(it);
+                container->get<by_handlerId>().erase(it);
             }
         } else if (signal) {
-            BySignalIterators iterators = container.get<by_signal>().equal_range(signal);
+            BySignalIterators iterators = container->get<by_signal>().equal_range(signal);
 
             while (iterators.first != iterators.second) {
                 if (!detail ||
@@ -317,36 +392,36 @@ bool ConnectionsStore::lookupAndExec(void *instance, uint signal, Quark detail,
                     (this->*func)(instance, *iterators.first);
                     executed = true;
 
-                    iterators.first = container.get<by_signal>().erase(iterators.first);
+                    iterators.first = container->get<by_signal>().erase(iterators.first);
                 } else {
                     ++iterators.first;
                 }
             }
         } else if (receiver) {
-            ByReceiverIterators iterators = container.get<by_receiver>().equal_range(receiver);
+            ByReceiverIterators iterators = container->get<by_receiver>().equal_range(receiver);
 
             while (iterators.first != iterators.second) {
                 if (!slotHash || slotHash == iterators.first->slotHash) {
                     (this->*func)(instance, *iterators.first);
                     executed = true;
 
-                    iterators.first = container.get<by_receiver>().erase(iterators.first);
+                    iterators.first = container->get<by_receiver>().erase(iterators.first);
                 } else {
                     ++iterators.first;
                 }
             }
         } else {
-            for (SequentialIterator it = container.get<sequential>().begin();
-                 it != container.get<sequential>().end(); ++it)
+            for (SequentialIterator it = container->get<sequential>().begin();
+                 it != container->get<sequential>().end(); ++it)
             {
                 (this->*func)(instance, *it);
                 executed = true;
             }
-            container.get<sequential>().clear();
+            container->get<sequential>().clear();
         }
 
-        if (container.get<sequential>().empty()) {
-            m_connections.remove(instance);
+        if (container->get<sequential>().empty()) {
+            removeConnections(instance);
         }
     }
 
@@ -355,16 +430,10 @@ bool ConnectionsStore::lookupAndExec(void *instance, uint signal, Quark detail,
 
 void ConnectionsStore::disconnectHandler(void *instance, const Connection & c)
 {
-    m_handlerIdInRemovalMutex.lock();
-    m_handlerIdInRemoval = c.handlerId;
-    m_handlerIdInRemovalMutex.unlock();
+    c.watch->inRemoval = true;
 
     /* This will unref the closure and cause onClosureDestroyed to be invoked. */
     g_signal_handler_disconnect(instance, c.handlerId);
-
-    m_handlerIdInRemovalMutex.lock();
-    m_handlerIdInRemoval = 0;
-    m_handlerIdInRemovalMutex.unlock();
 }
 
 void ConnectionsStore::disconnectAndDestroyRcvrWatch(void *instance, const Connection & c)
@@ -373,69 +442,80 @@ void ConnectionsStore::disconnectAndDestroyRcvrWatch(void *instance, const Conne
     destroyReceiverWatch(instance, c);
 }
 
-void ConnectionsStore::setupClosureWatch(void *instance, ulong handlerId, GClosure *closure)
-{
-    void *data = new QPair<void*, ulong>(instance, handlerId);
-    g_closure_add_finalize_notifier(closure, data, &ConnectionsStore::onClosureDestroyed);
-}
-
 //static
 void ConnectionsStore::onClosureDestroyed(void *data, GClosure *closure)
 {
     Q_UNUSED(closure);
-    QPair<void*, ulong> *pair = static_cast< QPair<void*, ulong>* >(data);
-    s_connectionsStore()->onClosureDestroyedAction(pair->first, pair->second);
-    delete pair;
+    ClosureWatch *watch = static_cast<ClosureWatch*>(data);
+
+    /* Do not do any action if we are being invoked from disconnectHandler() */
+    if (!watch->inRemoval) {
+        s_connectionsStore()->onClosureDestroyedAction(watch->instance, watch->handlerId);
+    }
+    delete watch;
 }
 
 void ConnectionsStore::onClosureDestroyedAction(void *instance, ulong handlerId)
 {
-    /* Do not do any action if we are being invoked from disconnectHandler() */
-    m_handlerIdInRemovalMutex.lock();
-    register bool ok = (m_handlerIdInRemoval != handlerId);
-    m_handlerIdInRemovalMutex.unlock();
-
-    if (ok) {
-        QMutexLocker l(&m_mutex);
-        lookupAndExec(instance, 0, Quark(), 0, 0, handlerId, &ConnectionsStore::destroyReceiverWatch);
-    }
+    QMutexLocker l(&shardOf(instance).connectionsMutex);
+    lookupAndExec(instance, 0, Quark(), 0, 0, handlerId, &ConnectionsStore::destroyReceiverWatch);
 }
 
 void ConnectionsStore::setupReceiverWatch(void *instance, void *receiver,
                                           const DestroyNotifierIfacePtr & notifier)
 {
-    if (!m_receivers.contains(receiver)) {
+    Shard & shard = shardOf(receiver);
+    QMutexLocker l(&shard.receiversMutex);
+
+    if (!shard.receivers.contains(receiver)) {
         ReceiverData data;
         data.notifier = notifier;
         if (!notifier->connect(receiver, this, SLOT(onReceiverDestroyed(QObject*)))) {
             notifier->connect(receiver, this, SLOT(onReceiverDestroyed(void*)));
         }
-        m_receivers.insert(receiver, data);
+        shard.receivers.insert(receiver, data);
     }
 
-    m_receivers[receiver].senders[instance]++;
+    shard.receivers[receiver].senders[instance]++;
 }
 
 void ConnectionsStore::destroyReceiverWatch(void *instance, const Connection & c)
 {
-    if (--m_receivers[c.receiver].senders[instance] == 0) {
-        m_receivers[c.receiver].senders.remove(instance);
-        if (m_receivers[c.receiver].senders.isEmpty()) {
-            m_receivers[c.receiver].notifier->disconnect(c.receiver, this);
-            m_receivers.remove(c.receiver);
+    Shard & shard = shardOf(c.receiver);
+    QMutexLocker l(&shard.receiversMutex);
+
+    //the receiver may have been removed by onReceiverDestroyed() in the meantime
+    QHash<void*, ReceiverData>::iterator it = shard.receivers.find(c.receiver);
+    if (it == shard.receivers.end()) {
+        return;
+    }
+
+    if (--it->senders[instance] == 0) {
+        it->senders.remove(instance);
+        if (it->senders.isEmpty()) {
+            it->notifier->disconnect(c.receiver, this);
+            shard.receivers.erase(it);
         }
     }
 }
 
 void ConnectionsStore::onReceiverDestroyed(void *receiver)
 {
-    QMutexLocker l(&m_mutex);
-    QHashIterator<void*, int> it(m_receivers[receiver].senders);
-    while (it.hasNext()) {
-        it.next();
-        lookupAndExec(it.key(), 0, Quark(), receiver, 0, 0, &ConnectionsStore::disconnectHandler);
+    /* The senders are not referenced, so a sender may be finalized by another thread
+     * after its address is taken here. In that case, its closures have been destroyed
+     * and onClosureDestroyedAction() has already removed its connections, so the lookup,
+     * which only uses the address, finds nothing and the sender is never touched. */
+    QList<void*> senders;
+    {
+        Shard & shard = shardOf(receiver);
+        QMutexLocker l(&shard.receiversMutex);
+        senders = shard.receivers.take(receiver).senders.keys();
+    }
+
+    for (int i = 0; i < senders.size(); ++i) {
+        QMutexLocker l(&shardOf(senders[i]).connectionsMutex);
+        lookupAndExec(senders[i], 0, Quark(), receiver, 0, 0, &ConnectionsStore::disconnectHandler);
     }
-    m_receivers.remove(receiver);
 }
 
 //optimization hack, to avoid making QObjectDestroyNotifier inherit
@@ -201,7 +201,7 @@ class QTGLIB_EXPORT ClosureDataBase
 {
 public:
     inline virtual ~ClosureDataBase() {}
-    virtual void marshaller(Value &, const QList<Value> &) = 0;
+    virtual void marshaller(Value &, const ValueArrayView &) = 0;
 
     bool passSender; //whether to pass the sender instance as the first slot argument
 
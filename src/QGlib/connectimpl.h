@@ -119,29 +119,26 @@ inline BoundArgumentFunction<F, R, Arg1, Args...> partial_bind(F && f, Arg1 && a
 //BEGIN ******** unpackAndInvoke ********
 
 template <typename F, typename R>
-inline void unpackAndInvoke(F && function, Value & result,
-                            QList<Value>::const_iterator &&,
-                            QList<Value>::const_iterator &&)
+inline void unpackAndInvoke(F && function, Value & result, const ValueArrayView &, int)
 {
     invoker<F, R>::invoke(function, result);
 }
 
 template <typename F, typename R, typename Arg1, typename... Args>
 inline void unpackAndInvoke(F && function, Value & result,
-                            QList<Value>::const_iterator && argsBegin,
-                            QList<Value>::const_iterator && argsEnd)
+                            const ValueArrayView & args, int index)
 {
     typedef typename boost::remove_const<
                 typename boost::remove_reference<Arg1>::type
             >::type CleanArg1;
     typedef BoundArgumentFunction<F, R, Arg1, Args...> F1;
 
-    CleanArg1 && boundArg = ValueImpl<CleanArg1>::get(*argsBegin);
+    //the arguments are read directly from the GValues of the emission;
+    //only an argument of type Value makes a copy that the slot owns
+    CleanArg1 && boundArg = ValueImpl<CleanArg1>::get(args.at(index));
     F1 && f = partial_bind<F, R, Arg1, Args...>(std::forward<F>(function), std::forward<Arg1>(boundArg));
 
-    unpackAndInvoke< F1, R, Args... >(std::forward<F1>(f), result,
-                                      std::forward<QList<Value>::const_iterator>(++argsBegin),
-                                      std::forward<QList<Value>::const_iterator>(argsEnd));
+    unpackAndInvoke< F1, R, Args... >(std::forward<F1>(f), result, args, index + 1);
 }
 
 //END ******** unpackAndInvoke ********
@@ -156,14 +153,13 @@ struct CppClosure<F, R (Args...)>
         inline ClosureData(const F & func, bool passSender)
             : ClosureDataBase(passSender), m_function(func) {}
 
-        virtual void marshaller(Value & result, const QList<Value> & params)
+        virtual void marshaller(Value & result, const ValueArrayView & params)
         {
             if (static_cast<size_t>(params.size()) < sizeof...(Args)) {
                 throw std::logic_error("The signal provides less arguments than what the closure expects");
             }
 
-            unpackAndInvoke<F, R, Args...>(std::forward<F>(m_function), result,
-                                           params.constBegin(), params.constEnd());
+            unpackAndInvoke<F, R, Args...>(std::forward<F>(m_function), result, params, 0);
         }
 
     private:
@@ -267,7 +263,7 @@ struct QGLIB_CONNECT_IMPL_CPPCLOSUREN
         inline ClosureData(const F & func, bool passSender)
             : ClosureDataBase(passSender), m_function(func) {}
 
-        virtual void marshaller(Value & result, const QList<Value> & params)
+        virtual void marshaller(Value & result, const ValueArrayView & params)
         {
             if (params.size() < QGLIB_CONNECT_IMPL_NUM_ARGS) {
                 throw std::logic_error("The signal provides less arguments than what the closure expects");
@@ -24,7 +24,6 @@
 
 # include "value.h"
 # include "quark.h"
-# include <QtCore/QList>
 # include <QtCore/QDebug>
 # include <stdexcept>
 
@@ -32,8 +31,15 @@
 namespace QGlib {
 namespace Private {
 
-/*! This method is used internally from the templated emit() method. */
-QTGLIB_EXPORT Value emit(void *instance, const char *signal, Quark detail, const QList<Value> & args);
+/*! These methods are used internally from the templated emit() methods.
+ * resolveSignal() resolves \a detailedSignal on the type of \a instance and
+ * prints an error if it does not exist. emit() emits \a signal on \a instance
+ * with the given \a values: the first one is reserved for the instance and the
+ * last one for the return value; the rest hold the arguments of the signal.
+ */
+QTGLIB_EXPORT SignalHandle resolveSignal(void *instance, const char *detailedSignal);
+QTGLIB_EXPORT void emit(const SignalHandle & signal, void *instance,
+                        Quark detail, ValueArrayView & values);
 
 template <typename Signature>
 struct EmitImpl {};
@@ -49,21 +55,17 @@ namespace Private {
 
 //BEGIN ******** packArguments ********
 
-inline QList<Value> packArguments()
+inline void packArguments(ValueArrayView &, int)
 {
-    return QList<Value>();
 }
 
 template <typename Arg1, typename... Args>
-QList<Value> packArguments(const Arg1 & a1, const Args & ... args)
+void packArguments(ValueArrayView & values, int index, const Arg1 & a1, const Args & ... args)
 {
-    QList<Value> && result = packArguments(args...);
-    Value v;
+    Value & v = values.at(index);
     v.init<Arg1>();
     ValueImpl<Arg1>::set(v, a1);
-    //prepend, since we are packing from the last to the first argument
-    result.prepend(v);
-    return result;
+    packArguments(values, index + 1, args...);
 }
 
 //END ******** packArguments ********
@@ -72,13 +74,16 @@ QList<Value> packArguments(const Arg1 & a1, const Args & ... args)
 template <typename R, typename... Args>
 struct EmitImpl<R (Args...)>
 {
-    static inline R emit(void *instance, const char *signal, Quark detail, const Args & ... args)
+    static inline R emit(const SignalHandle & signal, void *instance,
+                         Quark detail, const Args & ... args)
     {
         try {
-            Value && returnValue = Private::emit(instance, signal, detail, packArguments(args...));
-            return ValueImpl<R>::get(returnValue);
+            ValueArrayView values(sizeof...(Args) + 2);
+            packArguments(values, 1, args...);
+            Private::emit(signal, instance, detail, values);
+            return ValueImpl<R>::get(values.at(sizeof...(Args) + 1));
         } catch(const std::exception & e) {
-            qCritical() << "Error during emission of signal" << signal << ":" << e.what();
+            qCritical() << "Error during emission of signal" << signal.name() << ":" << e.what();
             return R();
         }
     }
@@ -87,16 +92,19 @@ struct EmitImpl<R (Args...)>
 template <typename... Args>
 struct EmitImpl<void (Args...)>
 {
-    static inline void emit(void *instance, const char *signal, Quark detail, const Args & ... args)
+    static inline void emit(const SignalHandle & signal, void *instance,
+                            Quark detail, const Args & ... args)
     {
         try {
-            Value && returnValue = Private::emit(instance, signal, detail, packArguments(args...));
+            ValueArrayView values(sizeof...(Args) + 2);
+            packArguments(values, 1, args...);
+            Private::emit(signal, instance, detail, values);
 
-            if (returnValue.isValid()) {
-                qWarning() << "Ignoring return value from emission of signal" << signal;
+            if (values.at(sizeof...(Args) + 1).isValid()) {
+                qWarning() << "Ignoring return value from emission of signal" << signal.name();
             }
         } catch(const std::exception & e) {
-            qCritical() << "Error during emission of signal" << signal << ":" << e.what();
+            qCritical() << "Error during emission of signal" << signal.name() << ":" << e.what();
         }
     }
 };
@@ -110,13 +118,33 @@ struct EmitImpl<void (Args...)>
 template <typename R, typename... Args>
 R emit(void *instance, const char *detailedSignal, const Args & ... args)
 {
-    return Private::EmitImpl<R (Args...)>::emit(instance, detailedSignal, Quark(), args...);
+    SignalHandle signal = Private::resolveSignal(instance, detailedSignal);
+    if (!signal.isValid()) {
+        return R();
+    }
+    return Private::EmitImpl<R (Args...)>::emit(signal, instance, Quark(), args...);
 }
 
 template <typename R, typename... Args>
 R emitWithDetail(void *instance, const char *signal, Quark detail, const Args & ... args)
 {
-    return Private::EmitImpl<R (Args...)>::emit(instance, signal, detail, args...);
+    SignalHandle handle = Private::resolveSignal(instance, signal);
+    if (!handle.isValid()) {
+        return R();
+    }
+    return Private::EmitImpl<R (Args...)>::emit(handle, instance, detail, args...);
+}
+
+template <typename R, typename... Args>
+R emit(const SignalHandle & signal, void *instance, const Args & ... args)
+{
+    return Private::EmitImpl<R (Args...)>::emit(signal, instance, Quark(), args...);
+}
+
+template <typename R, typename... Args>
+R emitWithDetail(const SignalHandle & signal, void *instance, Quark detail, const Args & ... args)
+{
+    return Private::EmitImpl<R (Args...)>::emit(signal, instance, detail, args...);
 }
 
 //END ******** QGlib::emit ********
@@ -172,30 +200,29 @@ namespace Private {
 
 //BEGIN ******** boostpp EmitImpl ********
 
-# define QGLIB_SIGNAL_IMPL_PACK_ARGS_STEP(z, n, list) \
+# define QGLIB_SIGNAL_IMPL_PACK_ARGS_STEP(z, n, values) \
     { \
-        Value v; \
+        Value & v = values.at(n + 1); \
         v.init<A##n>(); \
         ValueImpl<A##n>::set(v, a##n); \
-        list.append(v); \
     }
 
-# define QGLIB_SIGNAL_IMPL_PACK_ARGS(list) \
-    BOOST_PP_REPEAT(QGLIB_SIGNAL_IMPL_NUM_ARGS, QGLIB_SIGNAL_IMPL_PACK_ARGS_STEP, list)
+# define QGLIB_SIGNAL_IMPL_PACK_ARGS(values) \
+    BOOST_PP_REPEAT(QGLIB_SIGNAL_IMPL_NUM_ARGS, QGLIB_SIGNAL_IMPL_PACK_ARGS_STEP, values)
 
 template <typename R QGLIB_SIGNAL_IMPL_TRAILING_TEMPLATE_PARAMS>
 struct EmitImpl<R (QGLIB_SIGNAL_IMPL_TEMPLATE_ARGS)>
 {
-    static inline R emit(void *instance, const char *signal, Quark detail
+    static inline R emit(const SignalHandle & signal, void *instance, Quark detail
                          QGLIB_SIGNAL_IMPL_FUNCTION_PARAMS)
     {
         try {
-            QList<Value> values;
+            ValueArrayView values(QGLIB_SIGNAL_IMPL_NUM_ARGS + 2);
             QGLIB_SIGNAL_IMPL_PACK_ARGS(values)
-            Value returnValue = Private::emit(instance, signal, detail, values);
-            return ValueImpl<R>::get(returnValue);
+            Private::emit(signal, instance, detail, values);
+            return ValueImpl<R>::get(values.at(QGLIB_SIGNAL_IMPL_NUM_ARGS + 1));
         } catch(const std::exception & e) {
-            qCritical() << "Error during emission of signal" << signal << ":" << e.what();
+            qCritical() << "Error during emission of signal" << signal.name() << ":" << e.what();
             return R();
         }
     }
@@ -204,18 +231,18 @@ struct EmitImpl<R (QGLIB_SIGNAL_IMPL_TEMPLATE_ARGS)>
 template <QGLIB_SIGNAL_IMPL_TEMPLATE_PARAMS>
 struct EmitImpl<void (QGLIB_SIGNAL_IMPL_TEMPLATE_ARGS)>
 {
-    static inline void emit(void *instance, const char *signal, Quark detail
+    static inline void emit(const SignalHandle & signal, void *instance, Quark detail
                             QGLIB_SIGNAL_IMPL_FUNCTION_PARAMS)
     {
         try {
-            QList<Value> values;
+            ValueArrayView values(QGLIB_SIGNAL_IMPL_NUM_ARGS + 2);
             QGLIB_SIGNAL_IMPL_PACK_ARGS(values)
-            Value returnValue = Private::emit(instance, signal, detail, values);
-            if (returnValue.isValid()) {
-                qWarning() << "Ignoring return value from emission of signal" << signal;
+            Private::emit(signal, instance, detail, values);
+            if (values.at(QGLIB_SIGNAL_IMPL_NUM_ARGS + 1).isValid()) {
+                qWarning() << "Ignoring return value from emission of signal" << signal.name();
             }
         } catch(const std::exception & e) {
-            qCritical() << "Error during emission of signal" << signal << ":" << e.what();
+            qCritical() << "Error during emission of signal" << signal.name() << ":" << e.what();
         }
     }
 };
@@ -232,15 +259,38 @@ struct EmitImpl<void (QGLIB_SIGNAL_IMPL_TEMPLATE_ARGS)>
 template <typename R QGLIB_SIGNAL_IMPL_TRAILING_TEMPLATE_PARAMS>
 R emit(void *instance, const char *detailedSignal QGLIB_SIGNAL_IMPL_FUNCTION_PARAMS)
 {
+    SignalHandle signal = Private::resolveSignal(instance, detailedSignal);
+    if (!signal.isValid()) {
+        return R();
+    }
     return Private::EmitImpl<R (QGLIB_SIGNAL_IMPL_TEMPLATE_ARGS)>
-                ::emit(instance, detailedSignal, Quark() QGLIB_SIGNAL_IMPL_FUNCTION_ARGS);
+                ::emit(signal, instance, Quark() QGLIB_SIGNAL_IMPL_FUNCTION_ARGS);
 }
 
 template <typename R QGLIB_SIGNAL_IMPL_TRAILING_TEMPLATE_PARAMS>
 R emitWithDetail(void *instance, const char *signal, Quark detail QGLIB_SIGNAL_IMPL_FUNCTION_PARAMS)
+{
+    SignalHandle handle = Private::resolveSignal(instance, signal);
+    if (!handle.isValid()) {
+        return R();
+    }
+    return Private::EmitImpl<R (QGLIB_SIGNAL_IMPL_TEMPLATE_ARGS)>
+                ::emit(handle, instance, detail QGLIB_SIGNAL_IMPL_FUNCTION_ARGS);
+}
+
+template <typename R QGLIB_SIGNAL_IMPL_TRAILING_TEMPLATE_PARAMS>
+R emit(const SignalHandle & signal, void *instance QGLIB_SIGNAL_IMPL_FUNCTION_PARAMS)
+{
+    return Private::EmitImpl<R (QGLIB_SIGNAL_IMPL_TEMPLATE_ARGS)>
+                ::emit(signal, instance, Quark() QGLIB_SIGNAL_IMPL_FUNCTION_ARGS);
+}
+
+template <typename R QGLIB_SIGNAL_IMPL_TRAILING_TEMPLATE_PARAMS>
+R emitWithDetail(const SignalHandle & signal, void *instance, Quark detail
+                 QGLIB_SIGNAL_IMPL_FUNCTION_PARAMS)
 {
     return Private::EmitImpl<R (QGLIB_SIGNAL_IMPL_TEMPLATE_ARGS)>
-                ::emit(instance, signal, detail QGLIB_SIGNAL_IMPL_FUNCTION_ARGS);
+                ::emit(signal, instance, detail QGLIB_SIGNAL_IMPL_FUNCTION_ARGS);
 }
 
 //END ******** boostpp QGlib::emit ********
@@ -24,6 +24,7 @@
 
 #include <QtCore/QtGlobal>
 #include <boost/config.hpp>
+#include <boost/version.hpp>
 
 /* defined by cmake when building this library */
 #if defined(QtGLib_EXPORTS) || defined(Qt5GLib_EXPORTS)
@@ -52,6 +53,7 @@ class Value;
 class Quark;
 class Type;
 class Signal;
+class SignalHandle;
 class SignalHandler;
 template <class T> class RefPointer;
 class ParamSpec;
@@ -59,6 +61,10 @@ typedef RefPointer<ParamSpec> ParamSpecPtr;
 class Object;
 typedef RefPointer<Object> ObjectPtr;
 
+namespace Private {
+class ValueArrayView;
+} //namespace Private
+
 } //namespace QGlib
 
 
@@ -95,4 +101,11 @@ typedef RefPointer<Object> ObjectPtr;
 # define QGLIB_HAVE_CXX0X 0
 #endif
 
+//ref-qualified member functions; boost only knows about them since 1.56
+#if QGLIB_HAVE_CXX0X && BOOST_VERSION >= 105600 && !defined(BOOST_NO_CXX11_REF_QUALIFIERS)
+# define QGLIB_HAVE_CXX0X_REF_QUALIFIERS 1
+#else
+# define QGLIB_HAVE_CXX0X_REF_QUALIFIERS 0
+#endif
+
 #endif
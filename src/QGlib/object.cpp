@@ -18,7 +18,11 @@
 */
 #include "object.h"
 #include "quark.h"
+#include <cstring>
 #include <glib-object.h>
+#include <QtCore/QDebug>
+#include <QtCore/QAtomicPointer>
+#include <QtCore/QVarLengthArray>
 
 namespace QGlib {
 namespace Private {
@@ -33,16 +37,229 @@ QList< RefPointer<T> > arrayToList(typename T::CType **array, uint n)
     return result;
 }
 
+/* Cache of the ParamSpecs that have been looked up by name, keyed by the
+ * class (or interface) type and the name. g_object_class_find_property() locks
+ * the global ParamSpec pool and walks the type hierarchy, which adds up for
+ * properties that are read many times a second. Like the wrapper type cache in
+ * wrap.cpp, this is a lock-free open addressing hash table whose entries are
+ * only ever added, each one with a single compare-and-swap.
+ * Each entry holds a reference on the class (or default interface) that owns its
+ * ParamSpec, which is never released, so the ParamSpec stays valid even if the class
+ * had been loaded by someone else who releases it later, such as the plugin of a dynamic
+ * type. Properties that are not found are not cached and take no reference.
+ */
+struct ParamSpecCacheEntry
+{
+    GType type;
+    uint hash;
+    const char *name; //interned
+    GParamSpec *param;
+    gpointer klass; //referenced
+};
+
+enum { ParamSpecCacheSize = 2048 };
+static QBasicAtomicPointer<ParamSpecCacheEntry> s_paramSpecCache[ParamSpecCacheSize];
+
+static inline ParamSpecCacheEntry *loadCacheSlot(QBasicAtomicPointer<ParamSpecCacheEntry> & slot)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+    return slot.loadAcquire();
+#else
+    return slot;
+#endif
+}
+
+static inline gpointer peekTypeClass(GType type)
+{
+    return G_TYPE_IS_INTERFACE(type) ? g_type_default_interface_peek(type) : g_type_class_peek(type);
+}
+
+static inline gpointer refTypeClass(GType type)
+{
+    return G_TYPE_IS_INTERFACE(type) ? g_type_default_interface_ref(type) : g_type_class_ref(type);
+}
+
+static inline void unrefTypeClass(GType type, gpointer klass)
+{
+    if (G_TYPE_IS_INTERFACE(type)) {
+        g_type_default_interface_unref(klass);
+    } else {
+        g_type_class_unref(klass);
+    }
+}
+
+static inline GParamSpec *findProperty(GType type, gpointer klass, const char *name)
+{
+    return G_TYPE_IS_INTERFACE(type) ? g_object_interface_find_property(klass, name)
+                                     : g_object_class_find_property(G_OBJECT_CLASS(klass), name);
+}
+
+/* Looks up the property and returns it with a reference on its class in \a klass,
+ * which the caller must keep as long as it uses the ParamSpec or release. */
+static GParamSpec *lookupParamSpec(GType type, const char *name, gpointer *klass)
+{
+    *klass = NULL;
+    if (!G_TYPE_IS_INTERFACE(type) && !G_TYPE_IS_OBJECT(type)) {
+        return NULL;
+    }
+
+    //peek first, so that lookups of names that do not exist take no reference
+    gpointer loaded = peekTypeClass(type);
+    if (loaded && !findProperty(type, loaded, name)) {
+        return NULL;
+    }
+
+    *klass = refTypeClass(type);
+    GParamSpec *param = findProperty(type, *klass, name);
+    if (!param) {
+        unrefTypeClass(type, *klass);
+        *klass = NULL;
+    }
+    return param;
+}
+
+static inline void deleteCacheEntry(ParamSpecCacheEntry *entry)
+{
+    unrefTypeClass(entry->type, entry->klass);
+    delete entry;
+}
+
+static GParamSpec *findParamSpec(GType type, const char *name)
+{
+    //GTypes of non-fundamental types are pointers, so discard the alignment bits
+    uint hash = uint(type >> 3) ^ uint(type >> 13);
+    for (const char *c = name; *c; ++c) {
+        hash = hash * 31 + uchar(*c);
+    }
+
+    ParamSpecCacheEntry *newEntry = NULL;
+
+    for (uint i = 0; i < ParamSpecCacheSize; ++i) {
+        QBasicAtomicPointer<ParamSpecCacheEntry> & slot = s_paramSpecCache[(hash + i) % ParamSpecCacheSize];
+        ParamSpecCacheEntry *entry = loadCacheSlot(slot);
+
+        if (!entry) {
+            if (!newEntry) {
+                gpointer klass;
+                GParamSpec *param = lookupParamSpec(type, name, &klass);
+                if (!param) {
+                    return NULL;
+                }
+
+                newEntry = new ParamSpecCacheEntry;
+                newEntry->type = type;
+                newEntry->hash = hash;
+                newEntry->name = g_intern_string(name);
+                newEntry->param = param;
+                newEntry->klass = klass;
+            }
+
+            if (slot.testAndSetOrdered(NULL, newEntry)) {
+                return newEntry->param;
+            }
+
+            //another thread took this slot first; it may have been adding the same property
+            entry = loadCacheSlot(slot);
+        }
+
+        if (entry->hash == hash && entry->type == type && std::strcmp(entry->name, name) == 0) {
+            if (newEntry) {
+                deleteCacheEntry(newEntry);
+            }
+            return entry->param;
+        }
+    }
+
+    //the cache is full. The reference on the class is kept, because callers such as
+    //PropertyHandle may keep the ParamSpec without holding an instance of the type
+    if (newEntry) {
+        GParamSpec *param = newEntry->param;
+        delete newEntry;
+        return param;
+    }
+    gpointer klass;
+    return lookupParamSpec(type, name, &klass);
+}
+
 } //namespace Private
 
+//BEGIN ******** PropertyHandle ********
+
+PropertyHandle::PropertyHandle()
+    : m_param(NULL)
+{
+}
+
+PropertyHandle::PropertyHandle(Type instanceType, const char *name)
+    : m_instanceType(instanceType), m_param(Private::findParamSpec(instanceType, name))
+{
+}
+
+Type PropertyHandle::instanceType() const
+{
+    return m_instanceType;
+}
+
+ParamSpecPtr PropertyHandle::paramSpec() const
+{
+    return m_param ? ParamSpecPtr::wrap(m_param) : ParamSpecPtr();
+}
+
+const char *PropertyHandle::name() const
+{
+    return m_param ? g_param_spec_get_name(m_param) : NULL;
+}
+
+Type PropertyHandle::valueType() const
+{
+    return m_param ? Type(G_PARAM_SPEC_VALUE_TYPE(m_param)) : Type(Type::Invalid);
+}
+
+ParamSpec::ParamFlags PropertyHandle::flags() const
+{
+    return m_param ? ParamSpec::ParamFlags(m_param->flags) : ParamSpec::ParamFlags();
+}
+
+//END ******** PropertyHandle ********
+
+namespace Private {
+
+typedef QVarLengthArray<const char*, 16> PropertyNames;
+typedef QVarLengthArray<const Value*, 16> PropertyValues;
+
+/* Sets the given properties with g_object_setv(), which needs a contiguous array of
+ * GValues, so the Values are copied into a (normally stack allocated) ValueArrayView */
+static void setPropertiesv(GObject *object, PropertyNames & names, const PropertyValues & values)
+{
+    if (names.isEmpty()) {
+        return;
+    }
+
+    g_object_freeze_notify(object);
+
+#if GLIB_CHECK_VERSION(2, 54, 0)
+    ValueArrayView gvalues(values.size());
+    for (int i = 0; i < values.size(); ++i) {
+        g_value_init(gvalues.at(i), values[i]->type());
+        g_value_copy(*values[i], gvalues.at(i));
+    }
+    g_object_setv(object, names.size(), names.data(), gvalues.values());
+#else
+    for (int i = 0; i < values.size(); ++i) {
+        g_object_set_property(object, names[i], *values[i]);
+    }
+#endif
+
+    g_object_thaw_notify(object);
+}
+
+} //namespace Private
 
 ParamSpecPtr ObjectBase::findProperty(const char *name) const
 {
-    GObjectClass *klass = G_OBJECT_CLASS(g_type_class_ref(Type::fromInstance(object<void>())));
-    GParamSpec *param = g_object_class_find_property(klass, name);
-    g_type_class_unref(klass);
+    GParamSpec *param = Private::findParamSpec(Type::fromInstance(object<void>()), name);
     if (param) {
-        return ParamSpecPtr::wrap(g_param_spec_ref_sink(param), false);
+        return ParamSpecPtr::wrap(param);
     } else {
         return ParamSpecPtr();
     }
@@ -62,9 +279,9 @@ QList<ParamSpecPtr> ObjectBase::listProperties() const
 Value ObjectBase::property(const char *name) const
 {
     Value result;
-    ParamSpecPtr param = findProperty(name);
-    if (param && (param->flags() & ParamSpec::Readable)) {
-        result.init(param->valueType());
+    GParamSpec *param = Private::findParamSpec(Type::fromInstance(object<void>()), name);
+    if (param && (param->flags & G_PARAM_READABLE)) {
+        result.init(G_PARAM_SPEC_VALUE_TYPE(param));
         g_object_get_property(object<GObject>(), name, result);
     }
     return result;
@@ -75,6 +292,121 @@ void ObjectBase::setProperty(const char *name, const Value & value)
     g_object_set_property(object<GObject>(), name, value);
 }
 
+PropertyHandle ObjectBase::propertyHandle(const char *name) const
+{
+    return PropertyHandle(Type::fromInstance(object<void>()), name);
+}
+
+Value ObjectBase::property(const PropertyHandle & property) const
+{
+    Value result;
+    readProperty(property, result);
+    return result;
+}
+
+void ObjectBase::readProperty(const PropertyHandle & property, Value & value) const
+{
+    if (!property.isValid() || !(property.m_param->flags & G_PARAM_READABLE)) {
+        return;
+    }
+
+    if (!Type::fromInstance(object<void>()).isA(property.m_instanceType)) {
+        qWarning() << "QGlib::ObjectBase::property: The property handle of"
+                   << property.name() << "was not resolved on the type of this object";
+        return;
+    }
+
+    //GParamSpec names are interned, so GLib's own lookup by name is cheap
+    value.init(G_PARAM_SPEC_VALUE_TYPE(property.m_param));
+    g_object_get_property(object<GObject>(), g_param_spec_get_name(property.m_param), value);
+}
+
+void ObjectBase::setProperty(const PropertyHandle & property, const Value & value)
+{
+    if (!property.isValid()) {
+        return;
+    }
+
+    if (!Type::fromInstance(object<void>()).isA(property.m_instanceType)) {
+        qWarning() << "QGlib::ObjectBase::setProperty: The property handle of"
+                   << property.name() << "was not resolved on the type of this object";
+        return;
+    }
+
+    g_object_set_property(object<GObject>(), g_param_spec_get_name(property.m_param), value);
+}
+
+void ObjectBase::setProperties(const QList< QPair<QByteArray, Value> > & properties)
+{
+    Type itype = Type::fromInstance(object<void>());
+    Private::PropertyNames names;
+    Private::PropertyValues values;
+
+    for (int i = 0; i < properties.size(); ++i) {
+        GParamSpec *param = Private::findParamSpec(itype, properties[i].first.constData());
+        if (!param || !properties[i].second.isValid()) {
+            qWarning() << "QGlib::ObjectBase::setProperties: Skipping property"
+                       << properties[i].first << "which does not exist or has an invalid value";
+            continue;
+        }
+        names.append(g_param_spec_get_name(param));
+        values.append(&properties[i].second);
+    }
+
+    Private::setPropertiesv(object<GObject>(), names, values);
+}
+
+void ObjectBase::setProperties(const QList< QPair<PropertyHandle, Value> > & properties)
+{
+    Type itype = Type::fromInstance(object<void>());
+    Private::PropertyNames names;
+    Private::PropertyValues values;
+
+    for (int i = 0; i < properties.size(); ++i) {
+        const PropertyHandle & property = properties[i].first;
+        if (!property.isValid() || !itype.isA(property.m_instanceType)
+                || !properties[i].second.isValid())
+        {
+            qWarning() << "QGlib::ObjectBase::setProperties: Skipping property"
+                       << property.name() << "which was not resolved on the type of this "
+                          "object or has an invalid value";
+            continue;
+        }
+        names.append(g_param_spec_get_name(property.m_param));
+        values.append(&properties[i].second);
+    }
+
+    Private::setPropertiesv(object<GObject>(), names, values);
+}
+
+QList<Value> ObjectBase::properties(const QList<QByteArray> & names) const
+{
+    Type itype = Type::fromInstance(object<void>());
+    QList<Value> result;
+
+    for (int i = 0; i < names.size(); ++i) {
+        Value value;
+        GParamSpec *param = Private::findParamSpec(itype, names[i].constData());
+        if (param && (param->flags & G_PARAM_READABLE)) {
+            value.init(G_PARAM_SPEC_VALUE_TYPE(param));
+            g_object_get_property(object<GObject>(), g_param_spec_get_name(param), value);
+        }
+        result.append(value);
+    }
+    return result;
+}
+
+QList<Value> ObjectBase::properties(const QList<PropertyHandle> & handles) const
+{
+    QList<Value> result;
+    for (int i = 0; i < handles.size(); ++i) {
+        Value value;
+        readProperty(handles[i], value);
+        result.append(value);
+    }
+    return result;
+}
+
 void *ObjectBase::data(const char *key) const
 {
     return g_object_get_data(object<GObject>(), key);
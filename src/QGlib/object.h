@@ -25,9 +25,55 @@
 #include "value.h"
 #include "type.h"
 #include <QtCore/QList>
+#include <QtCore/QPair>
+#include <QtCore/QByteArray>
 
 namespace QGlib {
 
+/*! \headerfile QGlib/object.h <QGlib/Object>
+ * \brief A property that has been resolved once for repeated access
+ *
+ * ObjectBase::property() and ObjectBase::setProperty() look up the property by name
+ * every time that they are called. When you access the same property many times (for
+ * example, when polling the level of a queue), you can resolve it once with PropertyHandle
+ * and pass the handle to the overloads of these methods that accept it:
+ * \code
+ * static const QGlib::PropertyHandle level(QGlib::GetType<QGst::Element>(), "current-level-buffers");
+ * ...
+ * uint buffers = queue->property<uint>(level);
+ * \endcode
+ * The handle can be used with any object whose type is instanceType() or derives from it.
+ *
+ * A PropertyHandle is a small value type. It can be freely copied and shared between
+ * threads. The class of instanceType() is kept alive for as long as the program runs,
+ * so the ParamSpec that the handle refers to is always valid.
+ */
+class QTGLIB_EXPORT PropertyHandle
+{
+public:
+    /*! Creates an invalid PropertyHandle. */
+    PropertyHandle();
+
+    /*! Resolves the property \a name of the object or interface type \a instanceType.
+     * If there is no such property, the handle will be invalid. */
+    PropertyHandle(Type instanceType, const char *name);
+
+    /*! Returns true if the property was resolved successfully, or false otherwise. */
+    inline bool isValid() const { return m_param != NULL; }
+
+    /*! Returns the Type that the property was resolved on. */
+    Type instanceType() const;
+    ParamSpecPtr paramSpec() const; ///< Returns the ParamSpec that describes the property.
+    const char *name() const; ///< Returns the canonical name of the property.
+    Type valueType() const; ///< Returns the Type of the values that the property holds.
+    ParamSpec::ParamFlags flags() const; ///< Returns the flags of the property.
+
+private:
+    friend class ObjectBase;
+    Type m_instanceType;
+    GParamSpec *m_param;
+};
+
 /*! \headerfile QGlib/object.h <QGlib/Object>
  * \brief Common virtual base class for Object and Interface
  *
@@ -64,6 +110,59 @@ public:
      */
     void setProperty(const char *name, const Value & value);
 
+    /*! Resolves the property with the given \a name on the type of this instance.
+     * \sa PropertyHandle */
+    PropertyHandle propertyHandle(const char *name) const;
+
+    /*! \overload
+     * Returns the value of the property described by the given \a property handle.
+     * If the handle is invalid, the property is not readable or this instance is not
+     * of the type that the handle was resolved on, an invalid Value will be returned.
+     */
+    Value property(const PropertyHandle & property) const;
+
+    /*! \overload
+     * Returns the value of the property described by the given \a property handle
+     * directly as a T, without allocating a Value. This is equivalent to
+     * property(property).get<T>(ok).
+     */
+    template <class T> T property(const PropertyHandle & property, bool *ok = NULL) const;
+
+    /*! \overload
+     * Sets the property described by the given \a property handle to hold the given
+     * \a value, which is converted to the type of the property using Value::set().
+     */
+    template <class T> void setProperty(const PropertyHandle & property, const T & value);
+
+    /*! \overload
+     * Sets the property described by the given \a property handle to hold the given
+     * \a value, which \em must have exactly the same type that the property expects.
+     */
+    void setProperty(const PropertyHandle & property, const Value & value);
+
+    /*! Sets several properties at once. Each pair holds the name of a property and the
+     * Value to set it to, which is converted to the type of the property if necessary.
+     * The properties are set in the given order with g_object_setv() while the notify
+     * signal is frozen, so each property emits notify only once, after all of them
+     * have been set. Properties that do not exist are skipped with a warning.
+     */
+    void setProperties(const QList< QPair<QByteArray, Value> > & properties);
+
+    /*! \overload
+     * Same as above, but with properties that have been resolved with PropertyHandle.
+     */
+    void setProperties(const QList< QPair<PropertyHandle, Value> > & properties);
+
+    /*! Returns the values of the properties with the given \a names, in the same order.
+     * The Value of a property that does not exist or is not readable is invalid.
+     */
+    QList<Value> properties(const QList<QByteArray> & names) const;
+
+    /*! \overload
+     * Same as above, but with properties that have been resolved with PropertyHandle.
+     */
+    QList<Value> properties(const QList<PropertyHandle> & handles) const;
+
     void *data(const char *key) const;
     void *stealData(const char *key) const;
     void setData(const char *key, void *data, void (*destroyCallback)(void*) = NULL);
@@ -79,6 +178,10 @@ protected:
 
     virtual void ref(bool increaseRef);
     virtual void unref();
+
+private:
+    /*! Initializes \a value and reads the property into it. Used by the template property(). */
+    void readProperty(const PropertyHandle & property, Value & value) const;
 };
 
 /*! \headerfile QGlib/object.h <QGlib/Object>
@@ -105,12 +208,26 @@ class QTGLIB_EXPORT Interface : virtual public ObjectBase
 template <class T>
 void ObjectBase::setProperty(const char *name, const T & value)
 {
-    ParamSpecPtr param = findProperty(name);
-    if (param) {
-        Value v;
-        v.init(param->valueType());
+    setProperty(propertyHandle(name), value);
+}
+
+template <class T>
+T ObjectBase::property(const PropertyHandle & property, bool *ok) const
+{
+    Private::ValueArrayView values(1);
+    readProperty(property, values.at(0));
+    return values.at(0).get<T>(ok);
+}
+
+template <class T>
+void ObjectBase::setProperty(const PropertyHandle & property, const T & value)
+{
+    if (property.isValid()) {
+        Private::ValueArrayView values(1);
+        Value & v = values.at(0);
+        v.init(property.valueType());
         v.set<T>(value);
-        setProperty(name, v);
+        setProperty(property, v);
     }
 }
 
@@ -20,6 +20,8 @@
 #define QGLIB_SIGNAL_H
 
 #include "global.h"
+#include "type.h"
+#include "quark.h"
 #include <QtCore/QString>
 #include <QtCore/QFlags>
 #include <QtCore/QSharedData>
@@ -98,6 +100,7 @@ public:
     static QList<Signal> listSignals(Type type);
 
 private:
+    friend class SignalHandle;
     QTGLIB_NO_EXPORT Signal(uint id);
 
     struct Private;
@@ -106,6 +109,68 @@ private:
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(Signal::SignalFlags)
 
+/*! \headerfile qglib_signal.h <QGlib/Signal>
+ * \brief A signal that has been resolved once for repeated emissions
+ *
+ * emit() resolves the signal by name, on the type of the instance, every time that
+ * it is called. When you emit the same signal many times (for example, once for every
+ * message or every video frame), you can resolve it once with SignalHandle and pass the
+ * handle to the emit() overload that accepts it. This skips the name lookup, as well as
+ * the parsing of the detail. The arguments are still checked against the
+ * parameter types of the signal, but they are packed on the stack.
+ *
+ * \code
+ * static const QGlib::SignalHandle signal(QGlib::GetType<QGst::Element>(), "no-more-pads");
+ * QGlib::emit<void>(signal, element);
+ * \endcode
+ *
+ * The signals of a type only exist after its class has been initialized, which normally
+ * happens when the first instance is created. For this reason, when the class of
+ * \a instanceType is not initialized yet, the constructor initializes it and keeps it
+ * loaded for the lifetime of the process, so that a handle that is created before any
+ * instance, like the one above, is still valid.
+ *
+ * A SignalHandle is a small value type that does not hold any resources,
+ * so it can be freely copied and shared between threads.
+ *
+ * \sa emit()
+ */
+class QTGLIB_EXPORT SignalHandle
+{
+public:
+    /*! Creates an invalid SignalHandle. */
+    SignalHandle();
+
+    /*! Resolves the signal \a detailedSignal on the interface/instance \a instanceType.
+     * The signal name may contain a detail with the syntax "signal::detail".
+     * If there is no such signal, the handle will be invalid. */
+    SignalHandle(Type instanceType, const char *detailedSignal);
+
+    /*! Returns true if the signal was resolved successfully, or false otherwise. */
+    inline bool isValid() const { return m_id != 0; }
+
+    uint id() const; ///< Returns the id of the resolved signal.
+    Signal signal() const; ///< Returns the resolved signal.
+    const char *name() const; ///< Returns the name of the signal, without the detail.
+    Quark detail() const; ///< Returns the detail that was specified with the signal name.
+
+    /*! Returns the Type that the signal was resolved on. The instances that it is
+     * emitted on must be of this type or of a type that derives from it. */
+    Type instanceType() const;
+    Type returnType() const; ///< Returns the return Type of the signal.
+    uint paramCount() const; ///< Returns the number of parameters of the signal.
+    Type paramType(uint index) const; ///< Returns the Type of the parameter at \a index.
+
+private:
+    Type m_instanceType;
+    uint m_id;
+    Quark m_detail;
+    Type m_returnType;
+    uint m_paramCount;
+    const Private::GType *m_paramTypes;
+    const char *m_name;
+};
+
 #if defined(DOXYGEN_RUN)
 
 /*! Emits a signal on a specified \a instance with the specified arguments.
@@ -163,6 +228,20 @@ R emit(void *instance, const char *detailedSignal, const Args & ... args);
 template <typename R, typename... Args>
 R emitWithDetail(void *instance, const char *signal, Quark detail, const Args & ... args);
 
+/*! \overload
+ * This method emits a \a signal that has been resolved in advance with SignalHandle,
+ * with the detail that was specified when resolving it.
+ */
+template <typename R, typename... Args>
+R emit(const SignalHandle & signal, void *instance, const Args & ... args);
+
+/*! \overload
+ * This method emits a \a signal that has been resolved in advance with SignalHandle,
+ * with the specified \a detail instead of the one that was specified when resolving it.
+ */
+template <typename R, typename... Args>
+R emitWithDetail(const SignalHandle & signal, void *instance, Quark detail, const Args & ... args);
+
 #endif //DOXYGEN_RUN
 
 } //namespace QGlib
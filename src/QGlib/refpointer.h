@@ -23,6 +23,7 @@
 #include "type.h"
 #include "wrap.h"
 #include <cstddef>
+#include <typeinfo>
 #include <boost/type_traits.hpp>
 #include <boost/utility/enable_if.hpp>
 #include <QtCore/QHash>
@@ -102,6 +103,20 @@ public:
     inline RefPointer<T> & operator=(const RefPointer<X> & other);
     inline RefPointer<T> & operator=(const RefPointer<T> & other);
 
+#if QGLIB_HAVE_CXX0X
+    /*! Move constructors and assignment operators. These take over the reference
+     * that \a other holds, without touching the reference count, and leave \a other null.
+     * \note These are only available if your compiler supports C++0x rvalue references.
+     */
+    template <class X>
+    inline RefPointer(RefPointer<X> && other);
+    inline RefPointer(RefPointer<T> && other);
+
+    template <class X>
+    inline RefPointer<T> & operator=(RefPointer<X> && other);
+    inline RefPointer<T> & operator=(RefPointer<T> && other);
+#endif
+
     /*! This operator allows you to compare a RefPointer to either
      * another RefPointer or to a pointer of a C object.
      * For example:
@@ -142,9 +157,19 @@ public:
      */
     static RefPointer<T> wrap(typename T::CType *nativePtr, bool increaseRef = true);
 
-    /*! Statically casts this RefPointer to a RefPointer of another class. */
+    /*! Statically casts this RefPointer to a RefPointer of another class.
+     * If this RefPointer is an rvalue and your compiler supports ref-qualified member
+     * functions, its reference is transferred to the result instead of acquiring a new one.
+     */
+#if QGLIB_HAVE_CXX0X_REF_QUALIFIERS
+    template <class X>
+    RefPointer<X> staticCast() const &;
+    template <class X>
+    RefPointer<X> staticCast() &&;
+#else
     template <class X>
     RefPointer<X> staticCast() const;
+#endif
 
     /*! Dynamically casts this RefPointer to a RefPointer of another class.
      * This is equivalent to the built-in dynamic_cast, but it additionally allows you
@@ -158,9 +183,19 @@ public:
      * QGst::UriHandlerPtr uriHandler = filesrc.dynamicCast<QGst::UriHandler>();
      * \endcode
      * because a "filesrc" element implements the GstUriHandler interface.
+     *
+     * As with staticCast(), casting an rvalue RefPointer transfers its reference to the
+     * result when the cast resolves to the same C++ wrapper instance.
      */
+#if QGLIB_HAVE_CXX0X_REF_QUALIFIERS
+    template <class X>
+    RefPointer<X> dynamicCast() const &;
+    template <class X>
+    RefPointer<X> dynamicCast() &&;
+#else
     template <class X>
     RefPointer<X> dynamicCast() const;
+#endif
 
 private:
     template <class X> friend class RefPointer;
@@ -169,6 +204,9 @@ private:
     template <class X>
     void assign(const RefPointer<X> & other);
 
+    template <class X>
+    X *dynamicCastTarget() const;
+
     T *m_class;
 };
 
@@ -181,6 +219,11 @@ class QTGLIB_EXPORT RefCountedObject
 public:
     virtual ~RefCountedObject() {}
 
+    /* Wrappers may be allocated from per-thread free lists, as they are small
+     * and are created and destroyed at a high rate. See wrap.cpp */
+    static void *operator new(std::size_t size);
+    static void operator delete(void *ptr, std::size_t size);
+
 protected:
     template <class T> friend class RefPointer;
     template <class T, class X> friend struct Private::RefPointerEqualityCheck;
@@ -201,6 +244,26 @@ inline T* RefCountedObject::object() const
 }
 
 
+namespace Private {
+
+/* Casts a wrapper returned by the wrapping functions to T. Wrapper constructors
+ * usually create exactly the class that is being asked for (i.e. a VideoOverlay wrapper
+ * for a VideoOverlay interface, a Buffer for a GstBuffer), so check the dynamic type
+ * first and skip the hierarchy walk of dynamic_cast when it matches. dynamic_cast<void*>
+ * only needs the offset to the most derived object, which is T in that case.
+ */
+template <class T>
+inline T *wrapperCast(RefCountedObject *cppObj)
+{
+    if (typeid(*cppObj) == typeid(T)) {
+        return static_cast<T*>(dynamic_cast<void*>(cppObj));
+    }
+    return dynamic_cast<T*>(cppObj);
+}
+
+} //namespace Private
+
+
 template <class T>
 inline RefPointer<T>::RefPointer()
     : m_class(NULL)
@@ -252,6 +315,56 @@ inline RefPointer<T> & RefPointer<T>::operator=(const RefPointer<T> & other)
     return *this;
 }
 
+#if QGLIB_HAVE_CXX0X
+
+template <class T>
+template <class X>
+inline RefPointer<T>::RefPointer(RefPointer<X> && other)
+    : m_class(NULL)
+{
+    //T should be a base class of X
+    QGLIB_STATIC_ASSERT((boost::is_base_of<T, X>::value),
+                        "Cannot implicitly cast a RefPointer down the hierarchy");
+
+    m_class = static_cast<T*>(other.m_class);
+    other.m_class = NULL;
+}
+
+template <class T>
+inline RefPointer<T>::RefPointer(RefPointer<T> && other)
+    : m_class(other.m_class)
+{
+    other.m_class = NULL;
+}
+
+template <class T>
+template <class X>
+inline RefPointer<T> & RefPointer<T>::operator=(RefPointer<X> && other)
+{
+    //T should be a base class of X
+    QGLIB_STATIC_ASSERT((boost::is_base_of<T, X>::value),
+                        "Cannot implicitly cast a RefPointer down the hierarchy");
+
+    //take the pointer first; clear() may destroy the object that holds other
+    T *cppClass = static_cast<T*>(other.m_class);
+    other.m_class = NULL;
+    clear();
+    m_class = cppClass;
+    return *this;
+}
+
+template <class T>
+inline RefPointer<T> & RefPointer<T>::operator=(RefPointer<T> && other)
+{
+    T *cppClass = other.m_class;
+    other.m_class = NULL;
+    clear();
+    m_class = cppClass;
+    return *this;
+}
+
+#endif //QGLIB_HAVE_CXX0X
+
 template <class T>
 template <class X>
 void RefPointer<T>::assign(const RefPointer<X> & other)
@@ -329,7 +442,7 @@ RefPointer<T> RefPointer<T>::wrap(typename T::CType *nativePtr, bool increaseRef
     if (nativePtr != NULL) {
         RefCountedObject *cppObj = WrapImpl<T>::wrap(nativePtr);
         cppObj->ref(increaseRef);
-        ptr.m_class = dynamic_cast<T*>(cppObj);
+        ptr.m_class = Private::wrapperCast<T>(cppObj);
         Q_ASSERT(ptr.m_class);
     }
     return ptr;
@@ -363,7 +476,11 @@ inline RefPointer<T>::operator typename T::CType*() const
 
 template <class T>
 template <class X>
+#if QGLIB_HAVE_CXX0X_REF_QUALIFIERS
+RefPointer<X> RefPointer<T>::staticCast() const &
+#else
 RefPointer<X> RefPointer<T>::staticCast() const
+#endif
 {
     RefPointer<X> result;
     if (m_class) {
@@ -373,6 +490,18 @@ RefPointer<X> RefPointer<T>::staticCast() const
     return result;
 }
 
+#if QGLIB_HAVE_CXX0X_REF_QUALIFIERS
+template <class T>
+template <class X>
+RefPointer<X> RefPointer<T>::staticCast() &&
+{
+    RefPointer<X> result;
+    result.m_class = static_cast<X*>(m_class);
+    m_class = NULL;
+    return result;
+}
+#endif
+
 
 namespace Private {
 
@@ -407,7 +536,7 @@ struct IfaceDynamicCastImpl<T, X,
         //and if it does, return a wrapper for that interface.
         if (Type::fromInstance(obj).isA(GetType<X>()))
         {
-            targetClass = dynamic_cast<X*>(Private::wrapInterface(GetType<X>(), obj));
+            targetClass = Private::wrapperCast<X>(Private::wrapInterface(GetType<X>(), obj));
             Q_ASSERT(targetClass);
         }
 
@@ -434,7 +563,7 @@ struct IfaceDynamicCastImpl<T, X,
         RefCountedObject *cppClass = Private::wrapObject(obj);
 
         //attempt to cast it to X
-        X *targetClass = dynamic_cast<X*>(cppClass);
+        X *targetClass = Private::wrapperCast<X>(cppClass);
 
         if (!targetClass) {
             //Cast failed. This either means that X is something that our instance is not
@@ -445,7 +574,7 @@ struct IfaceDynamicCastImpl<T, X,
                 !boost::is_base_of<Object, X>::value &&
                 Type::fromInstance(obj).isA(GetType<X>()))
             {
-                targetClass = dynamic_cast<X*>(Private::wrapInterface(GetType<X>(), obj));
+                targetClass = Private::wrapperCast<X>(Private::wrapInterface(GetType<X>(), obj));
                 Q_ASSERT(targetClass);
             }
         }
@@ -459,26 +588,58 @@ struct IfaceDynamicCastImpl<T, X,
 
 template <class T>
 template <class X>
-RefPointer<X> RefPointer<T>::dynamicCast() const
+X *RefPointer<T>::dynamicCastTarget() const
 {
-    RefPointer<X> result;
+    X *targetClass = NULL;
     if (m_class) {
-        X *targetClass = dynamic_cast<X*>(m_class);
+        targetClass = dynamic_cast<X*>(m_class);
         if (!targetClass) {
             //in case either X or T is an interface, we need to do some extra checks.
             //this is a template to optimize the compiled code depending on what X and T are.
             typename X::CType *obj = static_cast<RefCountedObject*>(m_class)->object<typename X::CType>();
             targetClass = Private::IfaceDynamicCastImpl<T, X>::doCast(obj);
         }
+    }
+    return targetClass;
+}
+
+template <class T>
+template <class X>
+#if QGLIB_HAVE_CXX0X_REF_QUALIFIERS
+RefPointer<X> RefPointer<T>::dynamicCast() const &
+#else
+RefPointer<X> RefPointer<T>::dynamicCast() const
+#endif
+{
+    RefPointer<X> result;
+    X *targetClass = dynamicCastTarget<X>();
+    if (targetClass) {
+        static_cast<RefCountedObject*>(targetClass)->ref(true);
+        result.m_class = targetClass;
+    }
+    return result;
+}
 
-        if (targetClass) {
+#if QGLIB_HAVE_CXX0X_REF_QUALIFIERS
+template <class T>
+template <class X>
+RefPointer<X> RefPointer<T>::dynamicCast() &&
+{
+    RefPointer<X> result;
+    X *targetClass = dynamicCastTarget<X>();
+    if (targetClass) {
+        if (static_cast<RefCountedObject*>(targetClass) == static_cast<RefCountedObject*>(m_class)) {
+            //same C++ instance, we can just hand over our reference
+            m_class = NULL;
+        } else {
+            //the target is a different (interface) wrapper, which needs its own reference
             static_cast<RefCountedObject*>(targetClass)->ref(true);
-            result.m_class = targetClass;
         }
+        result.m_class = targetClass;
     }
-
     return result;
 }
+#endif
 
 // trick GetType to return the same type for GetType<T>() and GetType< RefPointer<T> >()
 template <class T>
@@ -19,12 +19,8 @@
 #include "qglib_signal.h"
 #include "quark.h"
 #include <glib-object.h>
-#include <QtCore/QStringList>
 #include <QtCore/QDebug>
 
-//proper initializer for GValue structs on the stack
-#define QGLIB_G_VALUE_INITIALIZER {0, {{0}, {0}}}
-
 namespace QGlib {
 
 //BEGIN ******** Signal ********
@@ -134,79 +130,151 @@ QList<Signal> Signal::listSignals(Type type)
 
 //END ******** Signal ********
 
+//BEGIN ******** SignalHandle ********
+
+SignalHandle::SignalHandle()
+    : m_id(0), m_paramCount(0), m_paramTypes(NULL), m_name(NULL)
+{
+}
+
+SignalHandle::SignalHandle(Type instanceType, const char *detailedSignal)
+    : m_instanceType(instanceType), m_id(0), m_paramCount(0), m_paramTypes(NULL), m_name(NULL)
+{
+    //Signals are created in class_init, so g_signal_parse_name() cannot find them until the
+    //class is initialized. In that case, initialize it and never release it, so that this
+    //handle stays valid. Once the class is loaded, later handles do not take more references.
+    if (G_TYPE_IS_CLASSED(instanceType)) {
+        if (!g_type_class_peek(instanceType)) {
+            g_type_class_ref(instanceType);
+        }
+    } else if (G_TYPE_IS_INTERFACE(instanceType)) {
+        if (!g_type_default_interface_peek(instanceType)) {
+            g_type_default_interface_ref(instanceType);
+        }
+    }
+
+    uint id;
+    GQuark detail;
+    if (g_signal_parse_name(detailedSignal, instanceType, &id, &detail, TRUE)) {
+        //the strings and the param_types array of the query belong to the signal
+        GSignalQuery query;
+        g_signal_query(id, &query);
+
+        m_id = id;
+        m_detail = detail;
+        m_returnType = query.return_type & ~G_SIGNAL_TYPE_STATIC_SCOPE;
+        m_paramCount = query.n_params;
+        m_paramTypes = query.param_types;
+        m_name = query.signal_name;
+    }
+}
+
+uint SignalHandle::id() const
+{
+    return m_id;
+}
+
+Signal SignalHandle::signal() const
+{
+    return Signal(m_id);
+}
+
+const char *SignalHandle::name() const
+{
+    return m_name;
+}
+
+Quark SignalHandle::detail() const
+{
+    return m_detail;
+}
+
+Type SignalHandle::instanceType() const
+{
+    return m_instanceType;
+}
+
+Type SignalHandle::returnType() const
+{
+    return m_returnType;
+}
+
+uint SignalHandle::paramCount() const
+{
+    return m_paramCount;
+}
+
+Type SignalHandle::paramType(uint index) const
+{
+    Q_ASSERT(index < m_paramCount);
+    return m_paramTypes[index] & ~G_SIGNAL_TYPE_STATIC_SCOPE;
+}
+
+//END ******** SignalHandle ********
+
 namespace Private {
 
 //BEGIN ******** emit ********
 
-Value emit(void *instance, const char *detailedSignal, Quark detail, const QList<Value> & args)
+SignalHandle resolveSignal(void *instance, const char *detailedSignal)
 {
-    Value result;
     Type itype = Type::fromInstance(instance);
-    QStringList signalParts = QString::fromUtf8(detailedSignal).split(QLatin1String("::"));
-    if (!detail && signalParts.size() > 1) {
-        detail = Quark::fromString(signalParts[1]);
+    SignalHandle signal(itype, detailedSignal);
+    if (!signal.isValid()) {
+        qCritical() << "Error during emission of signal" << detailedSignal
+                    << "on an instance of" << itype.name() << ":"
+                    << "Could not find any signal with this name on this instance type";
     }
+    return signal;
+}
 
-    //initialize arguments array
-    GValue *values = new GValue[args.size() + 1];
-    memset(values, 0, sizeof(GValue) * (args.size() + 1));
+void emit(const SignalHandle & signal, void *instance, Quark detail, ValueArrayView & values)
+{
+    //the first value holds the instance and the last one the return value
+    const uint argsCount = values.size() - 2;
+    Type itype = Type::fromInstance(instance);
 
-    //set instance
-    g_value_init(&values[0], itype);
-    g_value_set_instance(&values[0], instance);
+    g_value_init(values.at(0), itype);
+    g_value_set_instance(values.at(0), instance);
 
     try {
-        //find the signal and perform sanity checks
-        Signal signal = Signal::lookup(signalParts[0].toUtf8(), itype);
+        //sanity checks
         if (!signal.isValid()) {
-            throw QString(QLatin1String("Could not find any signal named %1 "
-                                        "on this instance type")).arg(signalParts[0]);
+            throw QString(QLatin1String("The signal is invalid"));
         }
 
-        QList<Type> paramTypes = signal.paramTypes();
-        if (paramTypes.size() != args.size()) {
+        if (!itype.isA(signal.instanceType())) {
+            throw QString(QLatin1String("The instance is not of the type "
+                                        "that the signal was resolved on"));
+        }
+
+        if (signal.paramCount() != argsCount) {
             throw QString(QLatin1String("The number of arguments that the signal accepts differ "
                                         "from the number of arguments provided to emit"));
         }
 
-        //set arguments
-        for(int i=0; i<args.size(); i++) {
-            if (!args[i].type().isA(paramTypes[i])) {
+        for(uint i=0; i<argsCount; i++) {
+            if (!values.at(i+1).type().isA(signal.paramType(i))) {
                 throw QString(QLatin1String("Argument %1 provided to emit is not of the "
                                             "type that the signal expects")).arg(i);
-            } else {
-                g_value_init(&values[i+1], args[i].type());
-                g_value_copy(args[i], &values[i+1]);
             }
         }
 
         //initialize return value
-        GValue returnValue = QGLIB_G_VALUE_INITIALIZER;
+        Value & returnValue = values.at(argsCount + 1);
         if (signal.returnType() != Type::None) {
-            g_value_init(&returnValue, signal.returnType());
+            g_value_init(returnValue, signal.returnType());
         }
 
         //emit the signal
-        g_signal_emitv(values, signal.id(), detail, &returnValue);
-
-        if (G_IS_VALUE(&returnValue)) {
-            result = Value(&returnValue);
-            g_value_unset(&returnValue);
-        }
+        g_signal_emitv(values.values(), signal.id(),
+                       detail ? detail : signal.detail(), returnValue);
     } catch (const QString & msg) {
-        QString instanceName = Value(&values[0]).toString();
+        QString instanceName = values.at(0).toString();
 
-        qCritical() << "Error during emission of signal" << detailedSignal
+        qCritical() << "Error during emission of signal" << signal.name()
                     << "on object"<< instanceName << ":" << msg;
     }
-
-    //cleanup
-    for(int i=0; i<args.size() + 1; i++) {
-        g_value_unset(&values[i]);
-    }
-    delete[] values;
-
-    return result;
 }
 
 //END ******** emit ********
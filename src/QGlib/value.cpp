@@ -19,10 +19,13 @@
 #include "value.h"
 #include "string.h"
 #include <cstring>
+#include <new>
 #include <boost/type_traits.hpp>
+#include <boost/static_assert.hpp>
 #include <glib-object.h>
 #include <QtCore/QDebug>
 #include <QtCore/QReadWriteLock>
+#include <QtCore/QAtomicPointer>
 
 namespace QGlib {
 namespace Private {
@@ -31,13 +34,42 @@ class Dispatcher
 {
 public:
     Dispatcher();
+    ~Dispatcher();
 
     ValueVTable getVTable(Type t) const;
     void setVTable(Type t, const ValueVTable & vtable);
 
 private:
+    ValueVTable resolveVTable(Type t) const;
+
+    /* Cache of the vtables that getVTable() has resolved, so that it does not have to
+     * lock and walk the type hierarchy in dispatchTable every time. It is a lock-free
+     * open addressing hash table keyed by GType. Entries are only ever added and each
+     * one is published with a single compare-and-swap. When a new vtable is registered,
+     * the whole cache is dropped, since it may affect the resolution of derived types.
+     * Dropped caches are kept around until the Dispatcher is destroyed, as readers may
+     * still be using them. This happens rarely, as vtables are registered on init().
+     */
+    enum { CacheSize = 512 };
+
+    struct CacheEntry
+    {
+        GType type;
+        ValueVTable vtable;
+    };
+
+    struct Cache
+    {
+        ~Cache();
+        QBasicAtomicPointer<CacheEntry> slots[CacheSize];
+    };
+
+    Cache *currentCache() const;
+
     mutable QReadWriteLock lock;
     QHash<Type, ValueVTable> dispatchTable;
+    mutable QAtomicPointer<Cache> cache;
+    QList<Cache*> retiredCaches; //protected by lock
 };
 
 Dispatcher::Dispatcher()
@@ -80,7 +112,97 @@ Dispatcher::Dispatcher()
 #undef DECLARE_VTABLE
 }
 
+Dispatcher::~Dispatcher()
+{
+    delete currentCache();
+    qDeleteAll(retiredCaches);
+}
+
+Dispatcher::Cache::~Cache()
+{
+    for (int i = 0; i < CacheSize; ++i) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+        delete slots[i].load();
+#else
+        delete static_cast<CacheEntry*>(slots[i]);
+#endif
+    }
+}
+
+Dispatcher::Cache *Dispatcher::currentCache() const
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+    return cache.loadAcquire();
+#else
+    return cache;
+#endif
+}
+
 ValueVTable Dispatcher::getVTable(Type t) const
+{
+    Cache *c = currentCache();
+    if (!c) {
+        //value-initialization zeroes the slots
+        Cache *newCache = new Cache();
+        if (cache.testAndSetOrdered(NULL, newCache)) {
+            c = newCache;
+        } else {
+            delete newCache;
+            c = currentCache();
+            if (!c) {
+                //setVTable() dropped it again in the meantime
+                return resolveVTable(t);
+            }
+        }
+    }
+
+    const GType gtype = t;
+    //GTypes of non-fundamental types are pointers, so discard the alignment bits
+    const uint hash = uint(gtype >> 3) ^ uint(gtype >> 13);
+    CacheEntry *newEntry = NULL;
+
+    for (uint i = 0; i < CacheSize; ++i) {
+        QBasicAtomicPointer<CacheEntry> & slot = c->slots[(hash + i) % CacheSize];
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+        CacheEntry *entry = slot.loadAcquire();
+#else
+        CacheEntry *entry = slot;
+#endif
+
+        if (!entry) {
+            if (!newEntry) {
+                newEntry = new CacheEntry;
+                newEntry->type = gtype;
+                newEntry->vtable = resolveVTable(t);
+            }
+
+            if (slot.testAndSetOrdered(NULL, newEntry)) {
+                return newEntry->vtable;
+            }
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+            entry = slot.loadAcquire();
+#else
+            entry = slot;
+#endif
+        }
+
+        if (entry->type == gtype) {
+            delete newEntry;
+            return entry->vtable;
+        }
+    }
+
+    //the cache is full
+    if (newEntry) {
+        ValueVTable vtable = newEntry->vtable;
+        delete newEntry;
+        return vtable;
+    }
+    return resolveVTable(t);
+}
+
+ValueVTable Dispatcher::resolveVTable(Type t) const
 {
     //if the type is an interface, try to find its
     //instantiatable prerequisite and get the vtable
@@ -103,14 +225,16 @@ ValueVTable Dispatcher::getVTable(Type t) const
 
     QReadLocker l(&lock);
 
-    if (dispatchTable.contains(t)) {
-        return dispatchTable[t];
+    QHash<Type, ValueVTable>::const_iterator it = dispatchTable.constFind(t);
+    if (it != dispatchTable.constEnd()) {
+        return it.value();
     }
 
     while (t.isDerived()) {
         t = t.parent();
-        if (dispatchTable.contains(t)) {
-            return dispatchTable[t];
+        it = dispatchTable.constFind(t);
+        if (it != dispatchTable.constEnd()) {
+            return it.value();
         }
     }
 
@@ -121,6 +245,12 @@ void Dispatcher::setVTable(Type t, const ValueVTable & vtable)
 {
     QWriteLocker l(&lock);
     dispatchTable[t] = vtable;
+
+    //the new vtable may change what derived types resolve to, so drop the cache
+    Cache *oldCache = cache.fetchAndStoreOrdered(NULL);
+    if (oldCache) {
+        retiredCaches.append(oldCache);
+    }
 }
 
 } //namespace Private
@@ -134,24 +264,34 @@ Q_GLOBAL_STATIC(Private::Dispatcher, s_dispatcher);
 struct QTGLIB_NO_EXPORT Value::Data : public QSharedData
 {
     Data();
+    explicit Data(GValue *external);
     Data(const Data & other);
     ~Data();
 
-    inline Type type() const { return G_VALUE_TYPE(&m_value); }
-    inline GValue *value() { return &m_value; }
-    inline const GValue *value() const { return &m_value; }
+    inline Type type() const { return G_VALUE_TYPE(value()); }
+    inline GValue *value() { return m_external ? m_external : &m_value; }
+    inline const GValue *value() const { return m_external ? m_external : &m_value; }
 
     GValue m_value;
+
+    //set when this Data refers to a GValue owned by someone else (see ValueArrayView)
+    GValue *m_external;
 };
 
 Value::Data::Data()
-    : QSharedData()
+    : QSharedData(), m_external(NULL)
+{
+    std::memset(&m_value, 0, sizeof(GValue));
+}
+
+Value::Data::Data(GValue *external)
+    : QSharedData(), m_external(external)
 {
     std::memset(&m_value, 0, sizeof(GValue));
 }
 
 Value::Data::Data(const Value::Data & other)
-    : QSharedData(other)
+    : QSharedData(other), m_external(NULL)
 {
     std::memset(&m_value, 0, sizeof(GValue));
 
@@ -163,7 +303,7 @@ Value::Data::Data(const Value::Data & other)
 
 Value::Data::~Data()
 {
-    if (type() != Type::Invalid) {
+    if (!m_external && type() != Type::Invalid) {
         g_value_unset(value());
     }
 }
@@ -221,14 +361,41 @@ VALUE_CONSTRUCTOR(const QString &)
 
 #undef VALUE_CONSTRUCTOR
 
+Value::Value(Data *data)
+    : d(data)
+{
+}
+
 Value::Value(const Value & other)
     : d(other.d)
 {
+    //an external GValue only lives as long as its ValueArrayView, so copies must own their data
+    if (d.constData()->m_external) {
+        d.detach();
+    }
 }
 
 Value & Value::operator=(const Value & other)
 {
+    if (d.constData()->m_external) {
+        //This Value is an entry of a ValueArrayView, whose Data lives inside the view
+        //and must never be released by the Value. Copy the contents instead: this writes
+        //to the GValue of an owned view and detaches from the GValue of a borrowed one.
+        if (this != &other) {
+            if (other.isValid()) {
+                init(other.type());
+                g_value_copy(other.d->value(), d->value());
+            } else if (isValid()) {
+                g_value_unset(d->value());
+            }
+        }
+        return *this;
+    }
+
     d = other.d;
+    if (d.constData()->m_external) {
+        d.detach();
+    }
     return *this;
 }
 
@@ -355,6 +522,170 @@ void Value::setData(Type dataType, const void *data)
     }
 }
 
+void Value::getFundamentalData(Type dataType, void *data) const
+{
+    const GValue *gvalue = d->value();
+
+    if (G_VALUE_TYPE(gvalue) == dataType) {
+        switch (dataType) {
+#define GET_FUNDAMENTAL(T, NICK, FTYPE) \
+        case FTYPE: \
+            *static_cast<T*>(data) = g_value_get_##NICK(gvalue); \
+            return;
+
+        GET_FUNDAMENTAL(char, char, Type::Char)
+        GET_FUNDAMENTAL(unsigned char, uchar, Type::Uchar)
+        GET_FUNDAMENTAL(bool, boolean, Type::Boolean)
+        GET_FUNDAMENTAL(int, int, Type::Int)
+        GET_FUNDAMENTAL(unsigned int, uint, Type::Uint)
+        GET_FUNDAMENTAL(long, long, Type::Long)
+        GET_FUNDAMENTAL(unsigned long, ulong, Type::Ulong)
+        GET_FUNDAMENTAL(qint64, int64, Type::Int64)
+        GET_FUNDAMENTAL(quint64, uint64, Type::Uint64)
+        GET_FUNDAMENTAL(float, float, Type::Float)
+        GET_FUNDAMENTAL(double, double, Type::Double)
+        GET_FUNDAMENTAL(QByteArray, string, Type::String)
+
+#undef GET_FUNDAMENTAL
+        default:
+            break;
+        }
+    }
+
+    //conversions, errors and any other type go through the generic path
+    getData(dataType, data);
+}
+
+void Value::setFundamentalData(Type dataType, const void *data)
+{
+    if (d->type() == dataType) {
+        GValue *gvalue = d->value();
+
+        switch (dataType) {
+#define SET_FUNDAMENTAL(T, NICK, FTYPE) \
+        case FTYPE: \
+            g_value_set_##NICK(gvalue, *static_cast<T const *>(data)); \
+            return;
+
+        SET_FUNDAMENTAL(char, char, Type::Char)
+        SET_FUNDAMENTAL(unsigned char, uchar, Type::Uchar)
+        SET_FUNDAMENTAL(bool, boolean, Type::Boolean)
+        SET_FUNDAMENTAL(int, int, Type::Int)
+        SET_FUNDAMENTAL(unsigned int, uint, Type::Uint)
+        SET_FUNDAMENTAL(long, long, Type::Long)
+        SET_FUNDAMENTAL(unsigned long, ulong, Type::Ulong)
+        SET_FUNDAMENTAL(qint64, int64, Type::Int64)
+        SET_FUNDAMENTAL(quint64, uint64, Type::Uint64)
+        SET_FUNDAMENTAL(float, float, Type::Float)
+        SET_FUNDAMENTAL(double, double, Type::Double)
+
+#undef SET_FUNDAMENTAL
+        case Type::String:
+            g_value_set_string(gvalue, static_cast<const QByteArray*>(data)->constData());
+            return;
+        default:
+            break;
+        }
+    }
+
+    setData(dataType, data);
+}
+
+// -- Private::ValueArrayView --
+
+namespace Private {
+
+//Each entry holds a Value::Data that refers to one of the GValues, followed by a Value that uses it
+static inline std::size_t valueOffsetInEntry(std::size_t dataSize)
+{
+    return (dataSize + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+}
+
+ValueArrayView::ValueArrayView(const GValue *values, uint count)
+    : m_count(count), m_owned(false)
+{
+    allocate();
+    m_values = const_cast<GValue*>(values);
+
+    for (int i = 0; i < m_count; ++i) {
+        char *entry = m_entries + i * EntrySize;
+        Value::Data *data = new (entry) Value::Data(&m_values[i]);
+
+        //The view, not the Value, owns the data, so hold an extra reference that
+        //prevents the Value from deleting it. This also makes any non-const access
+        //to the Value detach from the borrowed GValue instead of modifying it.
+        data->ref.ref();
+        new (entry + valueOffsetInEntry(sizeof(Value::Data))) Value(data);
+    }
+}
+
+ValueArrayView::ValueArrayView(uint count)
+    : m_count(count), m_owned(true)
+{
+    allocate();
+    m_values = reinterpret_cast<GValue*>(m_entries + m_count * EntrySize);
+    std::memset(m_values, 0, m_count * sizeof(GValue));
+
+    for (int i = 0; i < m_count; ++i) {
+        char *entry = m_entries + i * EntrySize;
+        Value::Data *data = new (entry) Value::Data(&m_values[i]);
+
+        //The Value holds the only reference, so that init() and set() write to the GValue.
+        //The destructor takes an extra one before destroying the Value.
+        new (entry + valueOffsetInEntry(sizeof(Value::Data))) Value(data);
+    }
+}
+
+void ValueArrayView::allocate()
+{
+    BOOST_STATIC_ASSERT(((sizeof(Value::Data) + sizeof(void*) - 1) & ~(sizeof(void*) - 1))
+                        + sizeof(Value) <= EntrySize);
+    BOOST_STATIC_ASSERT(sizeof(GValue) <= GValueSize);
+
+    if (m_count > PreallocatedCount) {
+        m_entries = static_cast<char*>(::operator new(m_count * (EntrySize + GValueSize)));
+    } else {
+        m_entries = m_buffer;
+    }
+}
+
+ValueArrayView::~ValueArrayView()
+{
+    for (int i = 0; i < m_count; ++i) {
+        char *entry = m_entries + i * EntrySize;
+        Value::Data *data = reinterpret_cast<Value::Data*>(entry);
+        if (m_owned) {
+            data->ref.ref();
+        }
+        reinterpret_cast<Value*>(entry + valueOffsetInEntry(sizeof(Value::Data)))->~Value();
+        data->~Data();
+
+        if (m_owned && G_IS_VALUE(&m_values[i])) {
+            g_value_unset(&m_values[i]);
+        }
+    }
+
+    if (m_entries != m_buffer) {
+        ::operator delete(m_entries);
+    }
+}
+
+const Value & ValueArrayView::at(int i) const
+{
+    Q_ASSERT(i >= 0 && i < m_count);
+    return *reinterpret_cast<const Value*>(m_entries + i * EntrySize
+                                           + valueOffsetInEntry(sizeof(Value::Data)));
+}
+
+Value & ValueArrayView::at(int i)
+{
+    Q_ASSERT(i >= 0 && i < m_count);
+    return *reinterpret_cast<Value*>(m_entries + i * EntrySize
+                                     + valueOffsetInEntry(sizeof(Value::Data)));
+}
+
+} //namespace Private
+
 
 QDebug operator<<(QDebug debug, const Value & value)
 {
@@ -240,6 +240,9 @@ public:
      * This is provided to let you add support for a custom type, if necessary.
      * You should normally not need to do that, as most types are handled
      * by the handlers of their parent types.
+     * \note The fundamental types that have a C++ equivalent (int, double, strings, etc...)
+     * are handled directly by Value when the stored type matches exactly and cannot be
+     * overridden with this method.
      * \sa \ref value_design
      */
     static void registerValueVTable(Type type, const ValueVTable & vtable);
@@ -247,6 +250,12 @@ public:
 private:
     template <typename T>
     friend struct ValueImpl;
+    friend class Private::ValueArrayView;
+
+    struct Data;
+
+    /*! Creates a Value that uses the given \a data, which is owned by a ValueArrayView. */
+    explicit Value(Data *data);
 
     /*! Retrieves the data from this Value and places it into the memory position
      * pointed to by \a data. \a dataType indicates the actual data type of \a data
@@ -266,11 +275,75 @@ private:
      */
     void setData(Type dataType, const void *data);
 
-    struct Data;
+    /*! Same as getData(), but for the fundamental types that are handled directly,
+     * without looking up the ValueVTable, if this Value holds exactly \a dataType.
+     * ValueImpl selects this at compile time for the types that
+     * Private::IsFundamentalValueType reports.
+     * \note This method should only be accessed from ValueImpl.
+     */
+    void getFundamentalData(Type dataType, void *data) const;
+
+    /*! Same as setData(), but for the fundamental types. \sa getFundamentalData() */
+    void setFundamentalData(Type dataType, const void *data);
+
     QSharedDataPointer<Data> d;
 };
 
 
+namespace Private {
+
+/* A view of an array of GValues, like the one that a GClosure marshaller receives,
+ * that presents them as Values without allocating anything or copying the GValues.
+ *
+ * The first constructor borrows an existing array, which must outlive the view.
+ * Its Values are read-only; modifying one of them detaches it from the GValue.
+ * The second constructor creates an array of \a count unset GValues that the view
+ * owns and unsets on destruction, which is useful for building the arguments of
+ * g_signal_emitv(). Its Values write directly to the GValues; assigning to one of
+ * them copies the assigned value into its GValue.
+ *
+ * In both cases, copying one of these Values makes a deep copy, so whoever keeps a
+ * Value beyond the lifetime of the view owns its data. Up to PreallocatedCount
+ * values are kept on the stack; larger arrays use the heap.
+ */
+class QTGLIB_EXPORT ValueArrayView
+{
+public:
+    ValueArrayView(const GValue *values, uint count);
+    explicit ValueArrayView(uint count);
+    ~ValueArrayView();
+
+    inline int size() const { return m_count; }
+    const Value & at(int i) const;
+    Value & at(int i);
+
+    /*! Returns the underlying contiguous array of GValues. */
+    inline const GValue *values() const { return m_values; }
+
+private:
+    Q_DISABLE_COPY(ValueArrayView)
+    void allocate();
+
+    //EntrySize must be at least sizeof(Value::Data) + sizeof(Value) and
+    //GValueSize at least sizeof(GValue); both are checked in value.cpp.
+    //A GValue is a GType followed by two 64-bit unions, hence the upper bound.
+    enum { PreallocatedCount = 8, EntrySize = 64, GValueSize = 3 * sizeof(quint64) };
+
+    union {
+        char m_buffer[PreallocatedCount * (EntrySize + GValueSize)];
+        double m_alignDouble;
+        qint64 m_alignInt64;
+        void *m_alignPointer;
+    };
+    char *m_entries;
+    GValue *m_values;
+    int m_count;
+    bool m_owned;
+};
+
+} //namespace Private
+
+
 /*! This struct provides the implementation for the Value::get() and Value::set() methods.
  * If you want to provide support for a custom type, you may want to provide a template
  * specialization of this class to handle your type in a different way than the default
@@ -331,6 +404,34 @@ void Value::set(const T & data)
     }
 }
 
+// -- fundamental types that Value handles without its vtable dispatcher --
+
+namespace Private {
+
+template <typename T>
+struct IsFundamentalValueType : boost::false_type {};
+
+#define QGLIB_FUNDAMENTAL_VALUE_TYPE(T) \
+    template <> \
+    struct IsFundamentalValueType<T> : boost::true_type {};
+
+QGLIB_FUNDAMENTAL_VALUE_TYPE(bool)
+QGLIB_FUNDAMENTAL_VALUE_TYPE(char)
+QGLIB_FUNDAMENTAL_VALUE_TYPE(unsigned char)
+QGLIB_FUNDAMENTAL_VALUE_TYPE(int)
+QGLIB_FUNDAMENTAL_VALUE_TYPE(unsigned int)
+QGLIB_FUNDAMENTAL_VALUE_TYPE(long)
+QGLIB_FUNDAMENTAL_VALUE_TYPE(unsigned long)
+QGLIB_FUNDAMENTAL_VALUE_TYPE(qint64)
+QGLIB_FUNDAMENTAL_VALUE_TYPE(quint64)
+QGLIB_FUNDAMENTAL_VALUE_TYPE(float)
+QGLIB_FUNDAMENTAL_VALUE_TYPE(double)
+QGLIB_FUNDAMENTAL_VALUE_TYPE(QByteArray)
+
+#undef QGLIB_FUNDAMENTAL_VALUE_TYPE
+
+} //namespace Private
+
 // -- default ValueImpl implementation --
 
 template <typename T>
@@ -342,7 +443,11 @@ inline T ValueImpl<T>::get(const Value & value)
         int, T
     >::type result;
 
-    value.getData(GetType<T>(), &result);
+    if (Private::IsFundamentalValueType<T>::value) {
+        value.getFundamentalData(GetType<T>(), &result);
+    } else {
+        value.getData(GetType<T>(), &result);
+    }
     return static_cast<T>(result);
 }
 
@@ -355,7 +460,11 @@ inline void ValueImpl<T>::set(Value & value, const T & data)
         const int, const T &
     >::type dataRef = data;
 
-    value.setData(GetType<T>(), &dataRef);
+    if (Private::IsFundamentalValueType<T>::value) {
+        value.setFundamentalData(GetType<T>(), &dataRef);
+    } else {
+        value.setData(GetType<T>(), &dataRef);
+    }
 }
 
 // -- ValueImpl specialization for QFlags --
@@ -444,14 +553,14 @@ struct ValueImpl<QString>
     static inline QString get(const Value & value)
     {
         QByteArray str;
-        value.getData(Type::String, &str);
+        value.getFundamentalData(Type::String, &str);
         return QString::fromUtf8(str);
     }
 
     static inline void set(Value & value, const QString & data)
     {
         QByteArray str = data.toUtf8();
-        value.setData(Type::String, &str);
+        value.setFundamentalData(Type::String, &str);
     }
 };
 
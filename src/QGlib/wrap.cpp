@@ -17,31 +17,350 @@
 */
 #include "refpointer.h"
 #include "quark.h"
+#include <QtCore/QAtomicPointer>
+#include <QtCore/QMutex>
+#include <QtCore/QThreadStorage>
+#include <new>
 #include <glib-object.h>
 
 namespace QGlib {
 
-RefCountedObject *constructWrapper(Type instanceType, void *instance)
+typedef RefCountedObject *(*WrapperConstructor)(void*);
+
+/* Information about a GType that the wrapping functions need every time
+ * they wrap an instance of it. It is resolved once per type and never changes
+ * afterwards, since wrapper constructors are only registered in init().
+ */
+struct WrapperTypeInfo
 {
-    Quark q = g_quark_from_static_string("QGlib__wrapper_constructor");
-    RefCountedObject *cppClass = NULL;
+    GType type;
+    WrapperConstructor constructor;
+    GQuark interfaceQuark; //the qdata key of interface wrappers of this type
+};
+
+/* Lock-free open addressing hash table of WrapperTypeInfo, keyed by GType.
+ * Entries are only ever added and are published with a single atomic
+ * compare-and-swap, so readers never need to take a lock.
+ * The number of types that a program wraps is small, but in the unlikely
+ * case that the table gets full, the information is resolved without caching.
+ */
+enum { TypeCacheSize = 1024 };
+static QBasicAtomicPointer<WrapperTypeInfo> s_typeCache[TypeCacheSize];
+
+static inline WrapperTypeInfo *loadCacheSlot(QBasicAtomicPointer<WrapperTypeInfo> & slot)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+    return slot.loadAcquire();
+#else
+    return slot;
+#endif
+}
+
+static WrapperConstructor resolveConstructor(Type instanceType)
+{
+    static const Quark q = g_quark_from_static_string("QGlib__wrapper_constructor");
 
     for(Type t = instanceType; t.isValid(); t = t.parent()) {
         void *funcPtr = t.quarkData(q);
         if (funcPtr) {
-            cppClass = (reinterpret_cast<RefCountedObject *(*)(void*)>(funcPtr))(instance);
-            Q_ASSERT_X(cppClass, "QGlib::constructWrapper",
-                       "Failed to wrap instance. This is a bug in the bindings library.");
-            return cppClass;
+            return reinterpret_cast<WrapperConstructor>(funcPtr);
+        }
+    }
+    return NULL;
+}
+
+static GQuark resolveInterfaceQuark(Type interfaceType)
+{
+    return Quark::fromString(QLatin1String("QGlib__interface_wrapper__") + interfaceType.name());
+}
+
+static const WrapperTypeInfo *wrapperTypeInfo(Type type)
+{
+    const GType gtype = type;
+    //GTypes of non-fundamental types are pointers, so discard the alignment bits
+    const uint hash = uint(gtype >> 3) ^ uint(gtype >> 13);
+    WrapperTypeInfo *newInfo = NULL;
+
+    for (uint i = 0; i < TypeCacheSize; ++i) {
+        QBasicAtomicPointer<WrapperTypeInfo> & slot = s_typeCache[(hash + i) % TypeCacheSize];
+        WrapperTypeInfo *info = loadCacheSlot(slot);
+
+        if (!info) {
+            if (!newInfo) {
+                WrapperConstructor constructor = resolveConstructor(type);
+                if (!constructor) {
+                    //do not cache failures; init() may not have been called yet
+                    return NULL;
+                }
+
+                newInfo = new WrapperTypeInfo;
+                newInfo->type = gtype;
+                newInfo->constructor = constructor;
+                newInfo->interfaceQuark = resolveInterfaceQuark(type);
+            }
+
+            if (slot.testAndSetOrdered(NULL, newInfo)) {
+                return newInfo;
+            }
+
+            //another thread took this slot first; it may have been adding the same type
+            info = loadCacheSlot(slot);
+        }
+
+        if (info->type == gtype) {
+            delete newInfo;
+            return info;
         }
     }
 
+    //the cache is full; let the caller resolve the information uncached
+    delete newInfo;
+    return NULL;
+}
+
+RefCountedObject *constructWrapper(Type instanceType, void *instance)
+{
+    const WrapperTypeInfo *info = wrapperTypeInfo(instanceType);
+    WrapperConstructor constructor = info ? info->constructor : resolveConstructor(instanceType);
+    RefCountedObject *cppClass = NULL;
+
+    if (constructor) {
+        cppClass = constructor(instance);
+        Q_ASSERT_X(cppClass, "QGlib::constructWrapper",
+                   "Failed to wrap instance. This is a bug in the bindings library.");
+        return cppClass;
+    }
+
     Q_ASSERT_X(false, "QGlib::constructWrapper",
                QString(QLatin1String("No wrapper constructor found for this type (") +
                        instanceType.name() + QLatin1String("). Did you forget to call init()?.")).toUtf8());
     return cppClass;
 }
 
+#if !defined(QGLIB_NO_WRAPPER_POOL)
+
+/* Wrapper allocator. Wrappers are tiny (a vtable pointer or three and the native pointer),
+ * and those of buffers, messages, events etc are created and destroyed at the rate that
+ * these objects flow through a pipeline. Instead of going through the global heap for each
+ * of them, freed wrappers are kept in per-thread free lists, one for each size class, and
+ * reused by the next allocation of the same class on that thread.
+ *
+ * Wrappers are often created in one thread and destroyed in another (e.g. a buffer wrapped
+ * in the streaming thread and released in the GUI thread), so per-thread lists that grow
+ * too long hand a batch of blocks to a shared depot, where threads with empty lists pick
+ * them up. The depot is the only place where a lock is taken, once every BatchSize blocks.
+ *
+ * Freed blocks are never returned to the heap while they are cached. Per size class, a thread
+ * keeps at most 2 * WrapperBatchSize blocks and the depot at most WrapperMaxDepotBatches
+ * batches, which bounds the memory held by the depot to about 150KB if all classes are used.
+ *
+ * The pool is only built with -DQTGSTREAMER_WRAPPER_POOL=ON.
+ */
+enum {
+    WrapperSizeGranularity = 16,
+    WrapperSizeClasses = 8, //up to 128 bytes, which is more than any wrapper needs
+    WrapperBatchSize = 32,
+    WrapperMaxDepotBatches = 8
+};
+
+struct WrapperFreeBlock
+{
+    WrapperFreeBlock *next;
+    WrapperFreeBlock *nextBatch; //only used in the depot, in the first block of a batch
+};
+
+static void deleteWrapperBlocks(WrapperFreeBlock *block)
+{
+    while (block) {
+        WrapperFreeBlock *next = block->next;
+        ::operator delete(block);
+        block = next;
+    }
+}
+
+class WrapperDepot
+{
+public:
+    WrapperDepot()
+    {
+        for (int i = 0; i < WrapperSizeClasses; ++i) {
+            m_batches[i] = NULL;
+            m_count[i] = 0;
+        }
+    }
+
+    ~WrapperDepot()
+    {
+        for (int i = 0; i < WrapperSizeClasses; ++i) {
+            while (WrapperFreeBlock *batch = m_batches[i]) {
+                m_batches[i] = batch->nextBatch;
+                deleteWrapperBlocks(batch);
+            }
+        }
+    }
+
+    void putBatch(int sizeClass, WrapperFreeBlock *batch)
+    {
+        {
+            QMutexLocker l(&m_mutex);
+            if (m_count[sizeClass] < WrapperMaxDepotBatches) {
+                batch->nextBatch = m_batches[sizeClass];
+                m_batches[sizeClass] = batch;
+                ++m_count[sizeClass];
+                return;
+            }
+        }
+        deleteWrapperBlocks(batch);
+    }
+
+    WrapperFreeBlock *takeBatch(int sizeClass)
+    {
+        QMutexLocker l(&m_mutex);
+        WrapperFreeBlock *batch = m_batches[sizeClass];
+        if (batch) {
+            m_batches[sizeClass] = batch->nextBatch;
+            --m_count[sizeClass];
+        }
+        return batch;
+    }
+
+private:
+    QMutex m_mutex;
+    WrapperFreeBlock *m_batches[WrapperSizeClasses];
+    int m_count[WrapperSizeClasses];
+};
+
+Q_GLOBAL_STATIC(WrapperDepot, s_wrapperDepot)
+
+class WrapperThreadCache
+{
+public:
+    WrapperThreadCache()
+    {
+        for (int i = 0; i < WrapperSizeClasses; ++i) {
+            m_head[i] = NULL;
+            m_count[i] = 0;
+        }
+    }
+
+    ~WrapperThreadCache()
+    {
+        for (int i = 0; i < WrapperSizeClasses; ++i) {
+            deleteWrapperBlocks(m_head[i]);
+        }
+    }
+
+    void *allocate(int sizeClass)
+    {
+        WrapperFreeBlock *block = m_head[sizeClass];
+        if (!block) {
+            WrapperDepot *depot = s_wrapperDepot();
+            block = depot ? depot->takeBatch(sizeClass) : NULL;
+            if (!block) {
+                //allocate the full size of the class, so that the block
+                //can be reused for any wrapper of this class later
+                return ::operator new((sizeClass + 1) * WrapperSizeGranularity);
+            }
+            m_count[sizeClass] = WrapperBatchSize;
+        }
+
+        m_head[sizeClass] = block->next;
+        --m_count[sizeClass];
+        return block;
+    }
+
+    void deallocate(int sizeClass, void *ptr)
+    {
+        if (m_count[sizeClass] >= 2 * WrapperBatchSize) {
+            //hand a batch over to the depot for other threads to use
+            WrapperFreeBlock *batch = m_head[sizeClass];
+            WrapperFreeBlock *last = batch;
+            for (int i = 1; i < WrapperBatchSize; ++i) {
+                last = last->next;
+            }
+            m_head[sizeClass] = last->next;
+            m_count[sizeClass] -= WrapperBatchSize;
+            last->next = NULL;
+
+            WrapperDepot *depot = s_wrapperDepot();
+            if (depot) {
+                depot->putBatch(sizeClass, batch);
+            } else {
+                deleteWrapperBlocks(batch);
+            }
+        }
+
+        WrapperFreeBlock *block = static_cast<WrapperFreeBlock*>(ptr);
+        block->next = m_head[sizeClass];
+        m_head[sizeClass] = block;
+        ++m_count[sizeClass];
+    }
+
+private:
+    WrapperFreeBlock *m_head[WrapperSizeClasses];
+    int m_count[WrapperSizeClasses];
+};
+
+Q_GLOBAL_STATIC(QThreadStorage<WrapperThreadCache*>, s_wrapperThreadCaches)
+
+static WrapperThreadCache *localWrapperCache()
+{
+    //this returns NULL after the global static has been destroyed on exit,
+    //in which case the wrappers that are still around just use the heap
+    QThreadStorage<WrapperThreadCache*> *caches = s_wrapperThreadCaches();
+    if (!caches) {
+        return NULL;
+    }
+
+    WrapperThreadCache *cache = caches->localData();
+    if (!cache) {
+        cache = new WrapperThreadCache;
+        caches->setLocalData(cache);
+    }
+    return cache;
+}
+
+static inline int wrapperSizeClass(std::size_t size)
+{
+    return size ? int((size - 1) / WrapperSizeGranularity) : 0;
+}
+
+#endif //QGLIB_NO_WRAPPER_POOL
+
+void *RefCountedObject::operator new(std::size_t size)
+{
+#if !defined(QGLIB_NO_WRAPPER_POOL)
+    const int sizeClass = wrapperSizeClass(size);
+    if (sizeClass < WrapperSizeClasses) {
+        if (WrapperThreadCache *cache = localWrapperCache()) {
+            return cache->allocate(sizeClass);
+        }
+        return ::operator new((sizeClass + 1) * WrapperSizeGranularity);
+    }
+#endif
+    return ::operator new(size);
+}
+
+void RefCountedObject::operator delete(void *ptr, std::size_t size)
+{
+    if (!ptr) {
+        return;
+    }
+
+#if !defined(QGLIB_NO_WRAPPER_POOL)
+    const int sizeClass = wrapperSizeClass(size);
+    if (sizeClass < WrapperSizeClasses) {
+        if (WrapperThreadCache *cache = localWrapperCache()) {
+            cache->deallocate(sizeClass, ptr);
+            return;
+        }
+    }
+#else
+    Q_UNUSED(size);
+#endif
+    ::operator delete(ptr);
+}
+
 namespace Private {
 
 static void qdataDestroyNotify(void *cppInstance)
@@ -53,7 +372,7 @@ RefCountedObject *wrapObject(void *gobject)
 {
     Q_ASSERT(gobject);
 
-    Quark q = g_quark_from_static_string("QGlib__object_wrapper");
+    static const GQuark q = g_quark_from_static_string("QGlib__object_wrapper");
     RefCountedObject *obj = static_cast<RefCountedObject*>(g_object_get_qdata(G_OBJECT(gobject), q));
 
     if (!obj) {
@@ -68,7 +387,7 @@ RefCountedObject *wrapParamSpec(void *param)
 {
     Q_ASSERT(param);
 
-    Quark q = g_quark_from_static_string("QGlib__paramspec_wrapper");
+    static const GQuark q = g_quark_from_static_string("QGlib__paramspec_wrapper");
     RefCountedObject *obj = static_cast<RefCountedObject*>(g_param_spec_get_qdata(G_PARAM_SPEC(param), q));
 
     if (!obj) {
@@ -83,11 +402,13 @@ RefCountedObject *wrapInterface(Type interfaceType, void *gobject)
 {
     Q_ASSERT(gobject);
 
-    Quark q = Quark::fromString(QLatin1String("QGlib__interface_wrapper__") + interfaceType.name());
+    const WrapperTypeInfo *info = wrapperTypeInfo(interfaceType);
+    GQuark q = info ? info->interfaceQuark : resolveInterfaceQuark(interfaceType);
     RefCountedObject *obj = static_cast<RefCountedObject*>(g_object_get_qdata(G_OBJECT(gobject), q));
 
     if (!obj) {
-        obj = constructWrapper(interfaceType, gobject);
+        obj = info ? info->constructor(gobject) : constructWrapper(interfaceType, gobject);
+        Q_ASSERT(obj);
         g_object_set_qdata_full(G_OBJECT(gobject), q, obj, &qdataDestroyNotify);
     }
 
@@ -0,0 +1,40 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "imagebuffer.h"
+#include <QtGui/QImage>
+
+namespace QGst {
+namespace Ui {
+
+static void deleteImage(void *image)
+{
+    delete static_cast<QImage*>(image);
+}
+
+BufferPtr bufferFromImage(const QImage & image)
+{
+    if (image.isNull()) {
+        return BufferPtr();
+    }
+    //the copy shares the pixels of the original and keeps them alive
+    QImage *copy = new QImage(image);
+    return Buffer::wrap(const_cast<uchar*>(copy->constBits()), copy->bytesPerLine() * copy->height(),
+                        MemoryFlagReadonly, &deleteImage, copy);
+}
+
+} //namespace Ui
+} //namespace QGst
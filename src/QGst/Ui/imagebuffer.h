@@ -0,0 +1,39 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef QGST_UI_IMAGEBUFFER_H
+#define QGST_UI_IMAGEBUFFER_H
+
+#include "global.h"
+#include "../buffer.h"
+
+class QImage;
+
+namespace QGst {
+namespace Ui {
+
+/*! \headerfile imagebuffer.h <QGst/Ui/ImageBuffer>
+ * Creates a read-only Buffer that shares the pixels of \a image without copying them.
+ * The pixels are kept alive until GStreamer releases the buffer's memory.
+ * Returns a null pointer if \a image is null.
+ * \sa Buffer::wrap(), Buffer::fromData()
+ */
+QTGSTREAMERUI_EXPORT BufferPtr bufferFromImage(const QImage & image);
+
+} //namespace Ui
+} //namespace QGst
+
+#endif // QGST_UI_IMAGEBUFFER_H
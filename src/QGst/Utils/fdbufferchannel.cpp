@@ -0,0 +1,266 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "fdbufferchannel.h"
+#include "../memory.h"
+#include <QtCore/QList>
+#include <gst/gst.h>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+
+namespace QGst {
+namespace Utils {
+
+#ifndef DOXYGEN_RUN
+
+//"QGFB", changes whenever the layout of the messages changes
+static const quint32 WireMagic = 0x51474642;
+
+//the maximum number of memories in a GstBuffer
+enum { MaxMemories = 16 };
+
+struct WireHeader
+{
+    quint32 magic;
+    quint32 memoryCount;
+    quint64 pts;
+    quint64 dts;
+    quint64 duration;
+    quint64 offset;
+    quint64 offsetEnd;
+    quint32 flags;
+    quint32 reserved;
+};
+
+struct WireMemory
+{
+    quint64 maxSize;
+    quint64 offset;
+    quint64 size;
+};
+
+struct WireMessage
+{
+    WireHeader header;
+    WireMemory memories[MaxMemories];
+};
+
+#endif //DOXYGEN_RUN
+
+FdBufferChannel::FdBufferChannel(int socket)
+    : m_socket(socket)
+{
+}
+
+FdBufferChannel::~FdBufferChannel()
+{
+}
+
+//static
+bool FdBufferChannel::createSocketPair(int sockets[2])
+{
+    int type = SOCK_SEQPACKET;
+#ifdef SOCK_CLOEXEC
+    type |= SOCK_CLOEXEC;
+#endif
+    return socketpair(AF_UNIX, type, 0, sockets) == 0;
+}
+
+int FdBufferChannel::socket() const
+{
+    return m_socket;
+}
+
+bool FdBufferChannel::sendBuffer(const BufferPtr & buffer)
+{
+    if (buffer.isNull()) {
+        return false;
+    }
+
+    GstBuffer *buf = buffer;
+    uint count = gst_buffer_n_memory(buf);
+    if (count == 0 || count > MaxMemories) {
+        return false;
+    }
+
+    WireMessage message;
+    memset(&message, 0, sizeof(message));
+    message.header.magic = WireMagic;
+    message.header.memoryCount = count;
+    message.header.pts = GST_BUFFER_PTS(buf);
+    message.header.dts = GST_BUFFER_DTS(buf);
+    message.header.duration = GST_BUFFER_DURATION(buf);
+    message.header.offset = GST_BUFFER_OFFSET(buf);
+    message.header.offsetEnd = GST_BUFFER_OFFSET_END(buf);
+    message.header.flags = GST_BUFFER_FLAGS(buf);
+
+    //keeps the memories, and the copies of memories that had no fd,
+    //alive until the descriptors are queued on the socket
+    QList<MemoryPtr> memories;
+    int fds[MaxMemories];
+
+    for (uint i = 0; i < count; ++i) {
+        MemoryPtr memory = MemoryPtr::wrap(gst_buffer_peek_memory(buf, i));
+
+        if (!memory->isFdMemory()) {
+            MemoryPtr copy = Memory::createMemfd(memory->size());
+            MapInfo source, dest;
+            if (copy.isNull() || !memory->map(source, MapRead)) {
+                return false;
+            }
+            if (!copy->map(dest, MapWrite)) {
+                memory->unmap(source);
+                return false;
+            }
+            memcpy(dest.data(), source.data(), source.size());
+            copy->unmap(dest);
+            memory->unmap(source);
+            memory = copy;
+        }
+
+        fds[i] = memory->fd();
+        message.memories[i].maxSize = memory->maxSize();
+        message.memories[i].offset = memory->offset();
+        message.memories[i].size = memory->size();
+        memories.append(memory);
+    }
+
+    struct iovec iov;
+    iov.iov_base = &message;
+    iov.iov_len = sizeof(WireHeader) + count * sizeof(WireMemory);
+
+    union {
+        char buf[CMSG_SPACE(sizeof(int) * MaxMemories)];
+        struct cmsghdr align;
+    } control;
+    memset(&control, 0, sizeof(control));
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = CMSG_SPACE(sizeof(int) * count);
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * count);
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * count);
+
+    int flags = 0;
+#ifdef MSG_NOSIGNAL
+    flags |= MSG_NOSIGNAL;
+#endif
+
+    ssize_t sent;
+    do {
+        sent = sendmsg(m_socket, &msg, flags);
+    } while (sent < 0 && errno == EINTR);
+
+    return sent == static_cast<ssize_t>(iov.iov_len);
+}
+
+BufferPtr FdBufferChannel::receiveBuffer()
+{
+    WireMessage message;
+
+    struct iovec iov;
+    iov.iov_base = &message;
+    iov.iov_len = sizeof(message);
+
+    union {
+        char buf[CMSG_SPACE(sizeof(int) * MaxMemories)];
+        struct cmsghdr align;
+    } control;
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+
+    int flags = 0;
+#ifdef MSG_CMSG_CLOEXEC
+    flags |= MSG_CMSG_CLOEXEC;
+#endif
+
+    ssize_t received;
+    do {
+        received = recvmsg(m_socket, &msg, flags);
+    } while (received < 0 && errno == EINTR);
+
+    if (received <= 0) {
+        return BufferPtr();
+    }
+
+    //collect the descriptors first, so that none of them leaks on error
+    QList<int> fds;
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+            int n = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            const int *data = reinterpret_cast<const int*>(CMSG_DATA(cmsg));
+            for (int i = 0; i < n; ++i) {
+                fds.append(data[i]);
+            }
+        }
+    }
+
+    quint32 count = message.header.memoryCount;
+    bool valid = !(msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC))
+            && received >= static_cast<ssize_t>(sizeof(WireHeader))
+            && message.header.magic == WireMagic
+            && count > 0 && count <= MaxMemories
+            && received == static_cast<ssize_t>(sizeof(WireHeader) + count * sizeof(WireMemory))
+            && fds.size() == static_cast<int>(count);
+
+    if (!valid) {
+        Q_FOREACH(int fd, fds) {
+            close(fd);
+        }
+        return BufferPtr();
+    }
+
+    GstBuffer *buf = gst_buffer_new();
+    for (quint32 i = 0; i < count; ++i) {
+        const WireMemory & m = message.memories[i];
+        MemoryPtr memory = Memory::fromFd(fds[i], m.maxSize);
+        if (memory.isNull() || m.offset + m.size > m.maxSize) {
+            for (quint32 j = memory.isNull() ? i : i + 1; j < count; ++j) {
+                close(fds[j]);
+            }
+            gst_buffer_unref(buf);
+            return BufferPtr();
+        }
+        gst_memory_resize(memory, m.offset, m.size);
+        gst_buffer_append_memory(buf, gst_memory_ref(memory));
+    }
+
+    GST_BUFFER_PTS(buf) = message.header.pts;
+    GST_BUFFER_DTS(buf) = message.header.dts;
+    GST_BUFFER_DURATION(buf) = message.header.duration;
+    GST_BUFFER_OFFSET(buf) = message.header.offset;
+    GST_BUFFER_OFFSET_END(buf) = message.header.offsetEnd;
+    GST_BUFFER_FLAGS(buf) = message.header.flags;
+
+    return BufferPtr::wrap(buf, false);
+}
+
+} //namespace Utils
+} //namespace QGst
@@ -0,0 +1,81 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef QGST_UTILS_FDBUFFERCHANNEL_H
+#define QGST_UTILS_FDBUFFERCHANNEL_H
+
+#include "global.h"
+#include "../buffer.h"
+
+namespace QGst {
+namespace Utils {
+
+/*! \headerfile fdbufferchannel.h <QGst/Utils/FdBufferChannel>
+ * \brief Passes buffers between processes over a Unix domain socket without copying their data
+ *
+ * Instead of the data, sendBuffer() sends the file descriptors of the buffer's memory, together
+ * with the offset and size of each memory and the buffer's timestamps and flags. On the other
+ * end, receiveBuffer() maps the same descriptors and rebuilds an equivalent Buffer, so that both
+ * processes end up accessing the same pages. Memory that is not fd memory is copied once into
+ * a memfd before it is sent; buffers that are allocated with Buffer::createMemfd(), or by a
+ * pool whose allocator creates fd memory, are never copied.
+ *
+ * The socket must be a connected Unix domain socket that preserves message boundaries, i.e.
+ * of type SOCK_SEQPACKET or SOCK_DGRAM. createSocketPair() creates a suitable pair, whose ends
+ * can be given to a child process. The socket is not closed by this class.
+ *
+ * \code
+ * int sockets[2];
+ * QGst::Utils::FdBufferChannel::createSocketPair(sockets);
+ * //... fork(), the child keeps sockets[1] ...
+ * QGst::Utils::FdBufferChannel channel(sockets[0]);
+ * QGst::BufferPtr buffer = QGst::Buffer::createMemfd(frameSize);
+ * //... fill the buffer ...
+ * channel.sendBuffer(buffer);
+ * \endcode
+ *
+ * \note This class is only available on Unix systems.
+ */
+class QTGSTREAMERUTILS_EXPORT FdBufferChannel
+{
+public:
+    explicit FdBufferChannel(int socket);
+    virtual ~FdBufferChannel();
+
+    /*! Creates a connected pair of sockets that are suitable for this class
+     * and stores them in \a sockets. Returns false if that fails. */
+    static bool createSocketPair(int sockets[2]);
+
+    /*! \returns the socket that was given in the constructor */
+    int socket() const;
+
+    /*! Sends \a buffer to the other end. This blocks until the message is queued on
+     * the socket. Returns false if the buffer could not be sent. */
+    bool sendBuffer(const BufferPtr & buffer);
+
+    /*! Receives a buffer that was sent from the other end, blocking until one is
+     * available. Returns a null pointer if the socket was closed or on error. */
+    BufferPtr receiveBuffer();
+
+private:
+    Q_DISABLE_COPY(FdBufferChannel)
+    int m_socket;
+};
+
+} //namespace Utils
+} //namespace QGst
+
+#endif // QGST_UTILS_FDBUFFERCHANNEL_H
@@ -16,6 +16,7 @@
 */
 
 #include "allocator.h"
+#include <cstring>
 #include <gst/gst.h>
 
 namespace QGst {
@@ -111,6 +112,18 @@ AllocatorPtr Allocator::getSystemMemory()
     return find(GST_ALLOCATOR_SYSMEM);
 }
 
+//static
+void Allocator::registerAllocator(const char *name, const AllocatorPtr & allocator)
+{
+    gst_allocator_register(name, GST_ALLOCATOR(gst_object_ref(allocator)));
+}
+
+//static
+void Allocator::setDefault(const AllocatorPtr & allocator)
+{
+    gst_allocator_set_default(GST_ALLOCATOR(gst_object_ref(allocator)));
+}
+
 MemoryPtr Allocator::alloc(size_t size, const AllocationParams & params)
 {
     return MemoryPtr::wrap(gst_allocator_alloc(object<GstAllocator>(), size,
@@ -125,4 +138,285 @@ void Allocator::free(MemoryPtr & memory)
     gst_allocator_free(object<GstAllocator>(), mem);
 }
 
+//BEGIN CustomAllocator
+
+struct QGstCustomAllocator
+{
+    GstAllocator parent;
+    CustomAllocator *impl;
+};
+
+struct QGstCustomAllocatorClass
+{
+    GstAllocatorClass parent_class;
+};
+
+struct QGstCustomMemory
+{
+    GstMemory mem;
+    CustomAllocator::Block block;
+    gsize dataOffset; //from block.data to the aligned start of the memory
+};
+
+namespace Private {
+
+struct CustomAllocatorGlue
+{
+    static GType type();
+    static void classInit(gpointer klass, gpointer data);
+    static void finalize(GObject *object);
+
+    static CustomAllocator *impl(GstAllocator *allocator)
+    {
+        return reinterpret_cast<QGstCustomAllocator*>(allocator)->impl;
+    }
+
+    static GstMemory *alloc(GstAllocator *allocator, gsize size, GstAllocationParams *params);
+    static void free(GstAllocator *allocator, GstMemory *memory);
+    static gpointer map(GstMemory *memory, gsize maxSize, GstMapFlags flags);
+    static void unmap(GstMemory *memory);
+    static GstMemory *share(GstMemory *memory, gssize offset, gssize size);
+    static GstMemory *copy(GstMemory *memory, gssize offset, gssize size);
+    static gboolean isSpan(GstMemory *memory1, GstMemory *memory2, gsize *offset);
+
+    static GObjectClass *s_parentClass;
+};
+
+GObjectClass *CustomAllocatorGlue::s_parentClass = NULL;
+
+GType CustomAllocatorGlue::type()
+{
+    static volatile gsize gtype = 0;
+    if (g_once_init_enter(&gtype)) {
+        GType t = g_type_register_static_simple(GST_TYPE_ALLOCATOR,
+                g_intern_static_string("QGstCustomAllocator"),
+                sizeof(QGstCustomAllocatorClass), &CustomAllocatorGlue::classInit,
+                sizeof(QGstCustomAllocator), NULL, GTypeFlags(0));
+        g_once_init_leave(&gtype, t);
+    }
+    return gtype;
+}
+
+void CustomAllocatorGlue::classInit(gpointer klass, gpointer data)
+{
+    Q_UNUSED(data);
+    s_parentClass = G_OBJECT_CLASS(g_type_class_peek_parent(klass));
+    G_OBJECT_CLASS(klass)->finalize = &CustomAllocatorGlue::finalize;
+    GST_ALLOCATOR_CLASS(klass)->alloc = &CustomAllocatorGlue::alloc;
+    GST_ALLOCATOR_CLASS(klass)->free = &CustomAllocatorGlue::free;
+}
+
+void CustomAllocatorGlue::finalize(GObject *object)
+{
+    delete reinterpret_cast<QGstCustomAllocator*>(object)->impl;
+    s_parentClass->finalize(object);
+}
+
+GstMemory *CustomAllocatorGlue::alloc(GstAllocator *allocator, gsize size,
+                                      GstAllocationParams *params)
+{
+    //same layout as the system memory allocator: prefix, data, padding,
+    //with the start of the prefix aligned to the requested alignment
+    gsize align = params->align | gst_memory_alignment;
+    gsize maxSize = size + params->prefix + params->padding;
+
+    QGstCustomMemory *mem = g_slice_new(QGstCustomMemory);
+    mem->block.data = NULL;
+    mem->block.size = 0;
+    mem->block.userData = NULL;
+
+    if (!impl(allocator)->alloc(mem->block, maxSize + align, align)) {
+        g_slice_free(QGstCustomMemory, mem);
+        return NULL;
+    }
+
+    gsize misalignment = reinterpret_cast<guintptr>(mem->block.data) & align;
+    mem->dataOffset = misalignment ? (align + 1) - misalignment : 0;
+
+    gst_memory_init(GST_MEMORY_CAST(mem), params->flags, allocator, NULL,
+                    maxSize, align, params->prefix, size);
+
+    bool zeroPrefix = params->prefix && (params->flags & GST_MEMORY_FLAG_ZERO_PREFIXED);
+    bool zeroPadding = params->padding && (params->flags & GST_MEMORY_FLAG_ZERO_PADDED);
+    if (zeroPrefix || zeroPadding) {
+        quint8 *data = impl(allocator)->map(mem->block, MapWrite);
+        if (data) {
+            data += mem->dataOffset;
+            if (zeroPrefix) {
+                memset(data, 0, params->prefix);
+            }
+            if (zeroPadding) {
+                memset(data + params->prefix + size, 0, params->padding);
+            }
+            impl(allocator)->unmap(mem->block);
+        }
+    }
+
+    return GST_MEMORY_CAST(mem);
+}
+
+void CustomAllocatorGlue::free(GstAllocator *allocator, GstMemory *memory)
+{
+    QGstCustomMemory *mem = reinterpret_cast<QGstCustomMemory*>(memory);
+    //sub-memories only borrow the block of their parent
+    if (!memory->parent) {
+        impl(allocator)->free(mem->block);
+    }
+    g_slice_free(QGstCustomMemory, mem);
+}
+
+gpointer CustomAllocatorGlue::map(GstMemory *memory, gsize maxSize, GstMapFlags flags)
+{
+    Q_UNUSED(maxSize);
+    QGstCustomMemory *mem = reinterpret_cast<QGstCustomMemory*>(memory);
+    quint8 *data = impl(memory->allocator)->map(mem->block,
+            static_cast<MapFlags>(static_cast<unsigned int>(flags)));
+    return data ? data + mem->dataOffset : NULL;
+}
+
+void CustomAllocatorGlue::unmap(GstMemory *memory)
+{
+    impl(memory->allocator)->unmap(reinterpret_cast<QGstCustomMemory*>(memory)->block);
+}
+
+GstMemory *CustomAllocatorGlue::share(GstMemory *memory, gssize offset, gssize size)
+{
+    if (size == -1) {
+        size = memory->size - offset;
+    }
+    MemoryPtr shared = impl(memory->allocator)->share(MemoryPtr::wrap(memory), offset, size);
+    return shared.isNull() ? NULL : gst_memory_ref(shared);
+}
+
+GstMemory *CustomAllocatorGlue::copy(GstMemory *memory, gssize offset, gssize size)
+{
+    if (size == -1) {
+        size = memory->size > static_cast<gsize>(offset) ? memory->size - offset : 0;
+    }
+    MemoryPtr copied = impl(memory->allocator)->copy(MemoryPtr::wrap(memory), offset, size);
+    return copied.isNull() ? NULL : gst_memory_ref(copied);
+}
+
+gboolean CustomAllocatorGlue::isSpan(GstMemory *memory1, GstMemory *memory2, gsize *offset)
+{
+    //only called for two sub-memories of the same parent
+    if (offset) {
+        *offset = memory1->offset - memory1->parent->offset;
+    }
+    return reinterpret_cast<QGstCustomMemory*>(memory1)->block.data
+                == reinterpret_cast<QGstCustomMemory*>(memory2)->block.data
+           && memory1->offset + memory1->size == memory2->offset;
+}
+
+} //namespace Private
+
+CustomAllocator::CustomAllocator(const char *memoryType)
+  : m_memoryType(g_intern_string(memoryType)), m_allocator(NULL)
+{
+}
+
+CustomAllocator::~CustomAllocator()
+{
+}
+
+//static
+AllocatorPtr CustomAllocator::create(CustomAllocator *allocator)
+{
+    Q_ASSERT(allocator && !allocator->m_allocator);
+
+    GstAllocator *a = GST_ALLOCATOR(g_object_new(Private::CustomAllocatorGlue::type(), NULL));
+    if (g_object_is_floating(a)) {
+        gst_object_ref_sink(a);
+    }
+
+    reinterpret_cast<QGstCustomAllocator*>(a)->impl = allocator;
+    allocator->m_allocator = a;
+
+    a->mem_type = allocator->m_memoryType;
+    a->mem_map = &Private::CustomAllocatorGlue::map;
+    a->mem_unmap = &Private::CustomAllocatorGlue::unmap;
+    a->mem_share = &Private::CustomAllocatorGlue::share;
+    a->mem_copy = &Private::CustomAllocatorGlue::copy;
+    a->mem_is_span = &Private::CustomAllocatorGlue::isSpan;
+
+    return AllocatorPtr::wrap(a, false);
+}
+
+//static
+CustomAllocator *CustomAllocator::fromAllocator(const AllocatorPtr & allocator)
+{
+    if (allocator.isNull() || !G_TYPE_CHECK_INSTANCE_TYPE(
+            static_cast<GstAllocator*>(allocator), Private::CustomAllocatorGlue::type())) {
+        return NULL;
+    }
+    return Private::CustomAllocatorGlue::impl(allocator);
+}
+
+const char *CustomAllocator::memoryType() const
+{
+    return m_memoryType;
+}
+
+AllocatorPtr CustomAllocator::allocator() const
+{
+    return AllocatorPtr::wrap(m_allocator);
+}
+
+quint8 *CustomAllocator::map(Block & block, MapFlags flags)
+{
+    Q_UNUSED(flags);
+    return block.data;
+}
+
+void CustomAllocator::unmap(Block & block)
+{
+    Q_UNUSED(block);
+}
+
+MemoryPtr CustomAllocator::share(const MemoryPtr & memory, size_t offset, size_t size)
+{
+    GstMemory *mem = memory;
+    GstMemory *parent = mem->parent ? mem->parent : mem;
+
+    QGstCustomMemory *sub = g_slice_new(QGstCustomMemory);
+    sub->block = reinterpret_cast<QGstCustomMemory*>(mem)->block;
+    sub->dataOffset = reinterpret_cast<QGstCustomMemory*>(mem)->dataOffset;
+
+    gst_memory_init(GST_MEMORY_CAST(sub),
+            GstMemoryFlags(GST_MINI_OBJECT_FLAGS(parent) | GST_MINI_OBJECT_FLAG_LOCK_READONLY),
+            mem->allocator, parent, mem->maxsize, mem->align, mem->offset + offset, size);
+
+    return MemoryPtr::wrap(GST_MEMORY_CAST(sub), false);
+}
+
+MemoryPtr CustomAllocator::copy(const MemoryPtr & memory, size_t offset, size_t size)
+{
+    GstMemory *src = memory;
+    GstMapInfo srcInfo;
+    if (!gst_memory_map(src, &srcInfo, GST_MAP_READ)) {
+        return MemoryPtr();
+    }
+
+    GstAllocationParams params;
+    gst_allocation_params_init(&params);
+    params.align = src->align;
+
+    GstMemory *dest = gst_allocator_alloc(m_allocator, size, &params);
+    if (dest) {
+        GstMapInfo destInfo;
+        if (gst_memory_map(dest, &destInfo, GST_MAP_WRITE)) {
+            memcpy(destInfo.data, srcInfo.data + offset, size);
+            gst_memory_unmap(dest, &destInfo);
+        } else {
+            gst_memory_unref(dest);
+            dest = NULL;
+        }
+    }
+
+    gst_memory_unmap(src, &srcInfo);
+    return MemoryPtr::wrap(dest, false);
+}
+
+//END CustomAllocator
+
 } /* QGst */
@@ -53,6 +53,7 @@ public:
 
 private:
     friend class Allocator;
+    friend class BufferPoolConfig;
     GstAllocationParams *d;
 };
 
@@ -71,6 +72,11 @@ public:
     /*! get the system memory allocator */
     static AllocatorPtr getSystemMemory();
 
+    /*! make \a allocator available with find() under \a name */
+    static void registerAllocator(const char *name, const AllocatorPtr & allocator);
+    /*! make \a allocator the one returned by getDefault() */
+    static void setDefault(const AllocatorPtr & allocator);
+
     /*! create a chunk of memory using this allocator */
     MemoryPtr alloc(size_t size, const AllocationParams &params = AllocationParams());
     /*! release memory allocated with alloc()
@@ -79,6 +85,90 @@ public:
     void free(MemoryPtr & memory);
 };
 
+namespace Private {
+    struct CustomAllocatorGlue;
+}
+
+/*! \headerfile allocator.h <QGst/Allocator>
+ * \brief Base class for GstAllocators implemented in C++
+ *
+ * Subclasses provide the blocks of memory by implementing alloc() and free(), and may
+ * reimplement map(), unmap(), share() and copy() for memory that needs special handling
+ * to be accessed. The rest of the GstMemory bookkeeping, i.e. the alignment, prefix and
+ * padding requested in AllocationParams, the memory flags and sub-memories, is done by
+ * this class.
+ *
+ * A CustomAllocator is put to use with create(), which returns the GstAllocator that
+ * forwards to it. That allocator can then be used directly, made available to other
+ * elements with Allocator::registerAllocator() or offered to upstream elements with
+ * AllocationQuery::addAllocationParam().
+ * \code
+ * QGst::AllocatorPtr allocator = QGst::CustomAllocator::create(new MyArenaAllocator);
+ * QGst::MemoryPtr memory = allocator->alloc(4096);
+ * \endcode
+ */
+class QTGSTREAMER_EXPORT CustomAllocator
+{
+public:
+    /*! A block of memory that was obtained from alloc() */
+    struct Block
+    {
+        quint8 *data;    ///< The start of the block
+        size_t size;     ///< The size of the block
+        void *userData;  ///< Whatever the subclass needs to release the block in free()
+    };
+
+    virtual ~CustomAllocator();
+
+    /*! Creates a GstAllocator that allocates its memory from \a allocator. The returned
+     * allocator takes ownership of \a allocator, which is deleted when the last memory
+     * block and the last reference to the GstAllocator are gone. */
+    static AllocatorPtr create(CustomAllocator *allocator);
+    /*! Returns the CustomAllocator behind \a allocator, or NULL if \a allocator
+     * was not created with create(). */
+    static CustomAllocator *fromAllocator(const AllocatorPtr & allocator);
+
+    /*! Returns the memory type that was given in the constructor */
+    const char *memoryType() const;
+
+protected:
+    /*! \a memoryType identifies the memory of this allocator, see Memory::isType() */
+    explicit CustomAllocator(const char *memoryType);
+
+    /*! Returns the GstAllocator that was created for this object by create() */
+    AllocatorPtr allocator() const;
+
+    /*! Must fill \a block with at least \a size bytes of memory. \a align is the
+     * alignment mask that the caller requested; honouring it is optional, as this
+     * class already asks for enough extra bytes to align the data itself.
+     * Returns false if no memory is available. This may be called from any thread. */
+    virtual bool alloc(Block & block, size_t size, size_t align) = 0;
+    /*! Must release a block previously filled by alloc(). This may be called
+     * from any thread. */
+    virtual void free(Block & block) = 0;
+
+    /*! Returns a pointer to the start of \a block that can be accessed with
+     * \a flags. The default implementation returns block.data. */
+    virtual quint8 *map(Block & block, MapFlags flags);
+    /*! Releases an access to \a block obtained with map(). The default
+     * implementation does nothing. */
+    virtual void unmap(Block & block);
+
+    /*! Returns a Memory that shares \a size bytes of \a memory, starting at \a offset.
+     * The default implementation returns a read-only sub-memory that uses the same block. */
+    virtual MemoryPtr share(const MemoryPtr & memory, size_t offset, size_t size);
+    /*! Returns a new Memory with a copy of \a size bytes of \a memory, starting at
+     * \a offset. The default implementation allocates the copy from this allocator. */
+    virtual MemoryPtr copy(const MemoryPtr & memory, size_t offset, size_t size);
+
+private:
+    friend struct Private::CustomAllocatorGlue;
+    Q_DISABLE_COPY(CustomAllocator)
+
+    const char *m_memoryType;
+    GstAllocator *m_allocator;
+};
+
 } //namespace QGst
 
 QGST_REGISTER_TYPE(QGst::Allocator)
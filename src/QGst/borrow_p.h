@@ -0,0 +1,73 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef QGST_BORROW_P_H
+#define QGST_BORROW_P_H
+
+/* WARNING: This header should only be included from
+ * QtGStreamer source files and should not be installed */
+
+#include "../QGlib/refpointer.h"
+
+namespace QGst {
+namespace Private {
+
+/* Returns the wrapper of \a object without taking a reference, for objects
+ * that are known to be alive for the duration of a call, such as the data
+ * passed to a pad probe or to a virtual of CustomElement.
+ *
+ * This is not free: the wrapper of a mini object is created on the first
+ * call for each native object and cached in the ObjectStore, so every new
+ * buffer, event or message costs a heap allocation and a weak reference.
+ * Use a StackWrapper where the caller does not need a RefPointer. */
+template <class T>
+inline T *borrow(typename T::CType *object)
+{
+    return object ? QGlib::Private::wrapperCast<T>(QGlib::WrapImpl<T>::wrap(object)) : NULL;
+}
+
+/* A wrapper of T that is constructed in place, usually on the stack of a
+ * callback trampoline, instead of being allocated and cached like the wrappers
+ * that borrow() returns. It holds no reference on the native object, so it must
+ * not outlive the call that it was created for, and it cannot be held in a
+ * RefPointer, as that would keep a pointer to the stack. */
+template <class T>
+class StackWrapper : public T
+{
+public:
+    explicit StackWrapper(typename T::CType *object = NULL) { this->m_object = object; }
+    ~StackWrapper() {}
+
+    inline void setObject(typename T::CType *object) { this->m_object = object; }
+    inline T *get() { return this->m_object ? this : NULL; }
+
+protected:
+    virtual void ref(bool increaseRef)
+    {
+        Q_UNUSED(increaseRef);
+        Q_ASSERT_X(false, "QGst::Private::StackWrapper",
+                   "A view that is only valid during a callback cannot be held in a RefPointer");
+    }
+    virtual void unref() {}
+
+private:
+    Q_DISABLE_COPY(StackWrapper)
+};
+
+} //namespace Private
+} //namespace QGst
+
+#endif
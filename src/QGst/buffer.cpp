@@ -28,6 +28,42 @@ BufferPtr Buffer::create(uint size)
     return BufferPtr::wrap(gst_buffer_new_allocate(NULL, size, NULL), false);
 }
 
+static void deleteByteArray(void *data)
+{
+    delete static_cast<QByteArray*>(data);
+}
+
+//static
+BufferPtr Buffer::wrap(void *data, size_t size, MemoryFlags flags,
+                       Memory::DestroyNotify notify, void *userData)
+{
+    GstBuffer *buffer = gst_buffer_new_wrapped_full(
+            static_cast<GstMemoryFlags>(static_cast<unsigned int>(flags)),
+            data, size, 0, size, userData, notify);
+    return BufferPtr::wrap(buffer, false);
+}
+
+//static
+BufferPtr Buffer::fromData(const QByteArray & data)
+{
+    //the copy shares the data of the original and keeps it alive
+    QByteArray *copy = new QByteArray(data);
+    return wrap(const_cast<char*>(copy->constData()), copy->size(),
+                MemoryFlagReadonly, &deleteByteArray, copy);
+}
+
+//static
+BufferPtr Buffer::createMemfd(size_t size, const char *name)
+{
+    MemoryPtr memory = Memory::createMemfd(size, name);
+    if (memory.isNull()) {
+        return BufferPtr();
+    }
+    BufferPtr buffer = BufferPtr::wrap(gst_buffer_new(), false);
+    buffer->appendMemory(memory);
+    return buffer;
+}
+
 quint32 Buffer::size() const
 {
     return gst_buffer_get_size(object<GstBuffer>());
@@ -93,6 +129,22 @@ MemoryPtr Buffer::getMemory(uint index) const
     return MemoryPtr::wrap(gst_buffer_get_memory(object<GstBuffer>(), index), false);
 }
 
+void Buffer::appendMemory(const MemoryPtr & memory)
+{
+    //the buffer takes ownership of the memory reference
+    gst_buffer_append_memory(object<GstBuffer>(), gst_memory_ref(memory));
+}
+
+void Buffer::insertMemory(int index, const MemoryPtr & memory)
+{
+    gst_buffer_insert_memory(object<GstBuffer>(), index, gst_memory_ref(memory));
+}
+
+void Buffer::replaceMemory(uint index, const MemoryPtr & memory)
+{
+    gst_buffer_replace_memory(object<GstBuffer>(), index, gst_memory_ref(memory));
+}
+
 bool Buffer::map(MapInfo &info, MapFlags flags)
 {
     if (!gst_buffer_map(object<GstBuffer>(), static_cast<GstMapInfo *>(info.m_object),
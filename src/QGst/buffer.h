@@ -21,6 +21,7 @@
 #include "miniobject.h"
 #include "clocktime.h"
 #include "memory.h"
+#include <QtCore/QByteArray>
 
 namespace QGst {
 
@@ -37,6 +38,19 @@ class QTGSTREAMER_EXPORT Buffer : public MiniObject
     QGST_WRAPPER(Buffer)
 public:
     static BufferPtr create(uint size);
+    /*! Creates a Buffer that uses the \a size bytes at \a data without copying them.
+     * \a notify is called with \a userData when GStreamer no longer uses the data.
+     * \sa Memory::wrap() */
+    static BufferPtr wrap(void *data, size_t size, MemoryFlags flags = MemoryFlags(),
+                          Memory::DestroyNotify notify = NULL, void *userData = NULL);
+    /*! Creates a read-only Buffer that shares the data of \a data without copying it.
+     * The data is kept alive until GStreamer releases the buffer's memory.
+     * \sa Ui::bufferFromImage() */
+    static BufferPtr fromData(const QByteArray & data);
+    /*! Creates a Buffer of \a size bytes whose memory is an anonymous memfd, which can be
+     * passed to other processes without copying. Returns a null pointer if memfd is
+     * not available. \sa Memory::createMemfd(), Utils::FdBufferChannel */
+    static BufferPtr createMemfd(size_t size, const char *name = "qtgstreamer");
 
     quint32 size() const;
 
@@ -56,6 +70,13 @@ public:
 
     uint memoryCount() const;
     MemoryPtr getMemory(uint index) const;
+    /*! Adds \a memory to the end of the buffer. The buffer must be writable. */
+    void appendMemory(const MemoryPtr & memory);
+    /*! Inserts \a memory at \a index, or at the end if \a index is -1.
+     * The buffer must be writable. */
+    void insertMemory(int index, const MemoryPtr & memory);
+    /*! Replaces the memory at \a index with \a memory. The buffer must be writable. */
+    void replaceMemory(uint index, const MemoryPtr & memory);
 
     BufferPtr copy() const;
     inline BufferPtr makeWritable() const;
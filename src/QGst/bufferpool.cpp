@@ -0,0 +1,250 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "bufferpool.h"
+#include <QtCore/QDebug>
+#include <gst/gst.h>
+#include <gst/video/video.h>
+#include <gst/video/gstvideopool.h>
+
+namespace QGst {
+
+BufferPoolConfig::BufferPoolConfig()
+  : d(gst_structure_new_empty("GstBufferPoolConfig"))
+{
+}
+
+BufferPoolConfig::BufferPoolConfig(GstStructure *structure)
+  : d(structure)
+{
+}
+
+BufferPoolConfig::BufferPoolConfig(const BufferPoolConfig & other)
+  : d(gst_structure_copy(other.d))
+{
+}
+
+BufferPoolConfig::~BufferPoolConfig()
+{
+    gst_structure_free(d);
+}
+
+BufferPoolConfig & BufferPoolConfig::operator=(const BufferPoolConfig & other)
+{
+    if (d != other.d) {
+        gst_structure_free(d);
+        d = gst_structure_copy(other.d);
+    }
+    return *this;
+}
+
+CapsPtr BufferPoolConfig::caps() const
+{
+    GstCaps *caps = NULL;
+    gst_buffer_pool_config_get_params(d, &caps, NULL, NULL, NULL);
+    return CapsPtr::wrap(caps);
+}
+
+uint BufferPoolConfig::size() const
+{
+    guint size = 0;
+    gst_buffer_pool_config_get_params(d, NULL, &size, NULL, NULL);
+    return size;
+}
+
+uint BufferPoolConfig::minBuffers() const
+{
+    guint minBuffers = 0;
+    gst_buffer_pool_config_get_params(d, NULL, NULL, &minBuffers, NULL);
+    return minBuffers;
+}
+
+uint BufferPoolConfig::maxBuffers() const
+{
+    guint maxBuffers = 0;
+    gst_buffer_pool_config_get_params(d, NULL, NULL, NULL, &maxBuffers);
+    return maxBuffers;
+}
+
+void BufferPoolConfig::setParams(const CapsPtr & caps, uint size, uint minBuffers, uint maxBuffers)
+{
+    gst_buffer_pool_config_set_params(d, caps, size, minBuffers, maxBuffers);
+}
+
+AllocatorPtr BufferPoolConfig::allocator() const
+{
+    GstAllocator *allocator = NULL;
+    gst_buffer_pool_config_get_allocator(d, &allocator, NULL);
+    return AllocatorPtr::wrap(allocator);
+}
+
+AllocationParams BufferPoolConfig::allocationParams() const
+{
+    AllocationParams params;
+    gst_buffer_pool_config_get_allocator(d, NULL, params.d);
+    return params;
+}
+
+void BufferPoolConfig::setAllocator(const AllocatorPtr & allocator, const AllocationParams & params)
+{
+    gst_buffer_pool_config_set_allocator(d, allocator, params);
+}
+
+QStringList BufferPoolConfig::options() const
+{
+    QStringList result;
+    const uint count = gst_buffer_pool_config_n_options(d);
+    for (uint i = 0; i < count; ++i) {
+        result.append(QString::fromUtf8(gst_buffer_pool_config_get_option(d, i)));
+    }
+    return result;
+}
+
+bool BufferPoolConfig::hasOption(const char *option) const
+{
+    return gst_buffer_pool_config_has_option(d, option);
+}
+
+void BufferPoolConfig::addOption(const char *option)
+{
+    gst_buffer_pool_config_add_option(d, option);
+}
+
+void BufferPoolConfig::setVideoAlignment(uint paddingTop, uint paddingBottom,
+                                         uint paddingLeft, uint paddingRight, uint strideAlign)
+{
+    GstVideoAlignment alignment;
+    gst_video_alignment_reset(&alignment);
+    alignment.padding_top = paddingTop;
+    alignment.padding_bottom = paddingBottom;
+    alignment.padding_left = paddingLeft;
+    alignment.padding_right = paddingRight;
+    for (int i = 0; i < GST_VIDEO_MAX_PLANES; ++i) {
+        alignment.stride_align[i] = strideAlign;
+    }
+
+    //add_option() ignores options that are already set
+    gst_buffer_pool_config_add_option(d, GST_BUFFER_POOL_OPTION_VIDEO_ALIGNMENT);
+    gst_buffer_pool_config_set_video_alignment(d, &alignment);
+}
+
+BufferPoolConfig::operator GstStructure*()
+{
+    return d;
+}
+
+BufferPoolConfig::operator const GstStructure*() const
+{
+    return d;
+}
+
+//static
+BufferPoolPtr BufferPool::create()
+{
+    GstBufferPool *pool = gst_buffer_pool_new();
+    //depending on the GStreamer version, the new pool may have a floating reference
+    if (g_object_is_floating(pool)) {
+        gst_object_ref_sink(pool);
+    }
+    return BufferPoolPtr::wrap(pool, false);
+}
+
+BufferPoolConfig BufferPool::config() const
+{
+    return BufferPoolConfig(gst_buffer_pool_get_config(object<GstBufferPool>()));
+}
+
+bool BufferPool::setConfig(const BufferPoolConfig & config)
+{
+    //gst_buffer_pool_set_config() takes ownership of the structure
+    return gst_buffer_pool_set_config(object<GstBufferPool>(), gst_structure_copy(config));
+}
+
+QStringList BufferPool::options() const
+{
+    QStringList result;
+    const char **options = gst_buffer_pool_get_options(object<GstBufferPool>());
+    for (const char **o = options; o && *o; ++o) {
+        result.append(QString::fromUtf8(*o));
+    }
+    return result;
+}
+
+bool BufferPool::hasOption(const char *option) const
+{
+    return gst_buffer_pool_has_option(object<GstBufferPool>(), option);
+}
+
+bool BufferPool::isActive() const
+{
+    return gst_buffer_pool_is_active(object<GstBufferPool>());
+}
+
+bool BufferPool::setActive(bool active)
+{
+    return gst_buffer_pool_set_active(object<GstBufferPool>(), active);
+}
+
+BufferPtr BufferPool::acquireBuffer(BufferPoolAcquireFlags flags, FlowReturn *result)
+{
+    GstBuffer *buffer = NULL;
+    GstFlowReturn ret;
+
+    if (flags == BufferPoolAcquireFlagNone) {
+        ret = gst_buffer_pool_acquire_buffer(object<GstBufferPool>(), &buffer, NULL);
+    } else {
+        GstBufferPoolAcquireParams params = GstBufferPoolAcquireParams();
+        params.flags = static_cast<GstBufferPoolAcquireFlags>(static_cast<unsigned int>(flags));
+        ret = gst_buffer_pool_acquire_buffer(object<GstBufferPool>(), &buffer, &params);
+    }
+
+    if (result) {
+        *result = static_cast<FlowReturn>(ret);
+    }
+    return BufferPtr::wrap(ret == GST_FLOW_OK ? buffer : NULL, false);
+}
+
+//static
+VideoBufferPoolPtr VideoBufferPool::create()
+{
+    GstBufferPool *pool = gst_video_buffer_pool_new();
+    if (g_object_is_floating(pool)) {
+        gst_object_ref_sink(pool);
+    }
+    return VideoBufferPoolPtr::wrap(GST_VIDEO_BUFFER_POOL(pool), false);
+}
+
+//static
+VideoBufferPoolPtr VideoBufferPool::create(const CapsPtr & caps, uint minBuffers, uint maxBuffers)
+{
+    GstVideoInfo info;
+    if (!gst_video_info_from_caps(&info, caps)) {
+        qWarning() << "QGst::VideoBufferPool::create: Caps do not describe raw video:" << caps;
+        return VideoBufferPoolPtr();
+    }
+
+    VideoBufferPoolPtr pool = create();
+    BufferPoolConfig config = pool->config();
+    config.setParams(caps, info.size, minBuffers, maxBuffers);
+    config.addOption(GST_BUFFER_POOL_OPTION_VIDEO_META);
+    if (!pool->setConfig(config)) {
+        qWarning() << "QGst::VideoBufferPool::create: Failed to configure the pool for" << caps;
+        return VideoBufferPoolPtr();
+    }
+    return pool;
+}
+
+} //namespace QGst
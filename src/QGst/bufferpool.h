@@ -0,0 +1,162 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef QGST_BUFFERPOOL_H
+#define QGST_BUFFERPOOL_H
+
+#include "object.h"
+#include "buffer.h"
+#include "caps.h"
+#include "allocator.h"
+#include <QtCore/QStringList>
+
+namespace QGst {
+
+/*! \headerfile bufferpool.h <QGst/BufferPool>
+ * \brief Wrapper class for the configuration structure of a GstBufferPool
+ *
+ * The configuration of a pool is obtained with BufferPool::config(), modified
+ * with the methods of this class and then applied with BufferPool::setConfig().
+ * The configuration can only be changed while the pool is inactive.
+ */
+class QTGSTREAMER_EXPORT BufferPoolConfig
+{
+public:
+    BufferPoolConfig();
+    BufferPoolConfig(const BufferPoolConfig & other);
+    virtual ~BufferPoolConfig();
+
+    BufferPoolConfig & operator=(const BufferPoolConfig & other);
+
+    CapsPtr caps() const;
+    uint size() const;
+    uint minBuffers() const;
+    uint maxBuffers() const;
+    /*! Sets the caps and the size of the buffers that the pool will produce.
+     * \a minBuffers buffers are allocated when the pool is activated and the pool
+     * never holds more than \a maxBuffers buffers, or an unlimited amount if
+     * \a maxBuffers is 0. */
+    void setParams(const CapsPtr & caps, uint size, uint minBuffers, uint maxBuffers);
+
+    AllocatorPtr allocator() const;
+    AllocationParams allocationParams() const;
+    /*! Sets the allocator and the parameters that the pool uses to allocate the
+     * memory of its buffers. A null \a allocator selects the default allocator. */
+    void setAllocator(const AllocatorPtr & allocator,
+                      const AllocationParams & params = AllocationParams());
+
+    QStringList options() const;
+    bool hasOption(const char *option) const;
+    /*! Enables an option of the pool, such as "GstBufferPoolOptionVideoMeta".
+     * Use BufferPool::options() to find out which options a pool supports. */
+    void addOption(const char *option);
+
+    /*! Makes a video buffer pool allocate frames with the given padding around the
+     * picture and with each plane's stride aligned to \a strideAlign + 1 bytes
+     * (\a strideAlign is a mask, e.g. 15 for 16-byte alignment). This also enables
+     * the "GstBufferPoolOptionVideoAlignment" option.
+     * \note This is only supported by video buffer pools. */
+    void setVideoAlignment(uint paddingTop, uint paddingBottom,
+                           uint paddingLeft, uint paddingRight, uint strideAlign = 0);
+
+    operator GstStructure*();
+    operator const GstStructure*() const;
+
+private:
+    friend class BufferPool;
+    explicit BufferPoolConfig(GstStructure *structure);
+    GstStructure *d;
+};
+
+/*! \headerfile bufferpool.h <QGst/BufferPool>
+ * \brief Wrapper class for GstBufferPool
+ *
+ * A BufferPool keeps a set of preallocated buffers of the same size. Buffers are
+ * taken from the pool with acquireBuffer() and they return to it automatically
+ * when their last reference is dropped, for example after a sink has rendered them,
+ * so a producer that pushes buffers acquired from a pool does not allocate any
+ * memory once the pool has reached its steady state.
+ *
+ * A pool must be configured with setConfig() and then activated with
+ * setActive() before buffers can be acquired from it:
+ * \code
+ * QGst::BufferPoolPtr pool = QGst::BufferPool::create();
+ * QGst::BufferPoolConfig config = pool->config();
+ * config.setParams(caps, frameSize, 4, 8);
+ * pool->setConfig(config);
+ * pool->setActive(true);
+ *
+ * QGst::BufferPtr buffer = pool->acquireBuffer();
+ * \endcode
+ *
+ * \sa VideoBufferPool
+ */
+class QTGSTREAMER_EXPORT BufferPool : public Object
+{
+    QGST_WRAPPER(BufferPool)
+public:
+    static BufferPoolPtr create();
+
+    BufferPoolConfig config() const;
+    /*! Applies \a config to the pool. Fails if the pool is active or if
+     * the pool does not accept the given configuration. */
+    bool setConfig(const BufferPoolConfig & config);
+
+    /*! Returns the options that this pool supports. */
+    QStringList options() const;
+    bool hasOption(const char *option) const;
+
+    bool isActive() const;
+    /*! Activates or deactivates the pool. Activating a pool allocates its minimum amount
+     * of buffers, deactivating it frees all the buffers that are not in use. */
+    bool setActive(bool active);
+
+    /*! Takes a buffer from the pool, allocating a new one if the pool is empty and its
+     * maximum amount of buffers has not been reached. Otherwise, this blocks until a buffer
+     * is returned to the pool, unless BufferPoolAcquireFlagDontWait is specified.
+     * Returns a null BufferPtr on failure, and if \a result is not NULL, it is set to
+     * the reason of the failure, for example FlowEos when no buffer is available without
+     * waiting, or FlowFlushing when the pool is inactive. */
+    BufferPtr acquireBuffer(BufferPoolAcquireFlags flags = BufferPoolAcquireFlagNone,
+                            FlowReturn *result = NULL);
+};
+
+/*! \headerfile bufferpool.h <QGst/BufferPool>
+ * \brief Wrapper class for GstVideoBufferPool
+ *
+ * A BufferPool that allocates buffers for raw video frames. Besides the options
+ * of the plain BufferPool, it supports adding video metadata to its buffers
+ * and aligning the frames with BufferPoolConfig::setVideoAlignment().
+ */
+class QTGSTREAMER_EXPORT VideoBufferPool : public BufferPool
+{
+    QGST_WRAPPER(VideoBufferPool)
+public:
+    static VideoBufferPoolPtr create();
+
+    /*! Creates a pool configured for frames of the raw video format described by \a caps,
+     * with video metadata enabled. The pool is returned inactive, so its configuration can
+     * still be modified before calling setActive(). Returns a null pointer if \a caps
+     * do not describe a raw video format. */
+    static VideoBufferPoolPtr create(const CapsPtr & caps, uint minBuffers = 0, uint maxBuffers = 0);
+};
+
+} //namespace QGst
+
+QGST_REGISTER_TYPE(QGst::BufferPool)
+QGST_REGISTER_TYPE(QGst::VideoBufferPool)
+
+#endif
@@ -16,30 +16,143 @@
 */
 #include "bus.h"
 #include "message.h"
+#include "borrow_p.h"
 #include "../QGlib/Signal"
 #include <gst/gst.h>
 #include <QtCore/QObject>
 #include <QtCore/QTimerEvent>
 #include <QtCore/QHash>
+#include <QtCore/QVector>
 #include <QtCore/QBasicTimer>
+#include <QtCore/QSocketNotifier>
+#include <QtCore/QMutex>
+#include <QtCore/QAtomicInt>
+#include <QtCore/QDebug>
+
+//gst_bus_get_pollfd() is only available since GStreamer 1.14 and the
+//GPollFD it returns is not a socket that QSocketNotifier can watch on Windows.
+#if GST_CHECK_VERSION(1, 14, 0) && !defined(Q_OS_WIN)
+# define QGST_BUS_WATCH_HAVE_POLLFD 1
+#else
+# define QGST_BUS_WATCH_HAVE_POLLFD 0
+#endif
 
 namespace QGst {
 namespace Private {
 
+/* Messages that are coalesced by the watch are the same if they have the
+ * same source, type and structure name. The source is kept alive by the
+ * retained message, so comparing the pointers is enough. */
+struct CoalescingKey
+{
+    GstObject *source;
+    GstMessageType type;
+    GQuark name;
+
+    bool operator==(const CoalescingKey & other) const
+    {
+        return source == other.source && type == other.type && name == other.name;
+    }
+};
+
+inline uint qHash(const CoalescingKey & key)
+{
+    return ::qHash(quintptr(key.source)) ^ (uint(key.type) * 31u) ^ ::qHash(key.name);
+}
+
+/* The watch is woken up by the bus' poll fd, which becomes readable as soon as
+ * a message is pushed on the bus queue and stays readable until all messages
+ * have been popped. If the fd is not available, we fall back to polling the
+ * bus every 50 ms.
+ */
 class BusWatch : public QObject
 {
+    Q_OBJECT
 public:
     BusWatch(GstBus *bus)
-        : QObject(), m_bus(bus)
+        : QObject(), m_bus(bus), m_notifier(NULL), m_stopped(false),
+          m_messageSignal(G_OBJECT_TYPE(bus), "message"), m_types(0),
+          m_batchTypes(0), m_batchHandler(NULL), m_deadBatchHandler(NULL),
+          m_deliveringBatch(false)
     {
-        m_timer.start(50, this);
+        for (int i = 0; i < 32; ++i) {
+            m_typeRefs[i] = 0;
+        }
+
+#if QGST_BUS_WATCH_HAVE_POLLFD
+        GPollFD pollfd;
+        gst_bus_get_pollfd(m_bus, &pollfd);
+        if (pollfd.fd >= 0) {
+            m_notifier = new QSocketNotifier(pollfd.fd, QSocketNotifier::Read, this);
+            connect(m_notifier, SIGNAL(activated(int)), this, SLOT(onBusActivated()));
+        }
+#endif
+        if (!m_notifier) {
+            m_timer.start(50, this);
+        }
+    }
+
+    virtual ~BusWatch()
+    {
+        delete m_batchHandler;
+    }
+
+    //the types of the watch are reference counted per bit, so that
+    //each removeSignalWatch() undoes exactly its addSignalWatch()
+    void addTypes(uint types)
+    {
+        for (int i = 0; i < 32; ++i) {
+            if (types & (1u << i)) {
+                ++m_typeRefs[i];
+            }
+        }
+        updateTypes();
+    }
+
+    void removeTypes(uint types)
+    {
+        for (int i = 0; i < 32; ++i) {
+            if ((types & (1u << i)) && m_typeRefs[i] > 0) {
+                --m_typeRefs[i];
+            }
+        }
+        updateTypes();
+    }
+
+    void setBatchHandler(uint types, BusBatchHandlerBase *handler)
+    {
+        //the handler may be replaced from inside itself
+        if (m_deliveringBatch) {
+            delete m_deadBatchHandler;
+            m_deadBatchHandler = m_batchHandler;
+        } else {
+            delete m_batchHandler;
+        }
+        m_batchHandler = handler;
+        m_batchTypes = handler ? types : 0;
     }
 
     void stop()
     {
+        m_stopped = true;
+        if (m_notifier) {
+            m_notifier->setEnabled(false);
+        }
         m_timer.stop();
     }
 
+private Q_SLOTS:
+    void onBusActivated()
+    {
+        //the notifier is level-triggered; disable it while dispatching so that
+        //a slot that spins a nested event loop does not re-enter dispatch()
+        m_notifier->setEnabled(false);
+        dispatch();
+        if (!m_stopped) {
+            m_notifier->setEnabled(true);
+        }
+    }
+
 private:
     virtual void timerEvent(QTimerEvent *event)
     {
@@ -50,26 +163,107 @@ private:
         }
     }
 
+    void updateTypes()
+    {
+        m_types = 0;
+        for (int i = 0; i < 32; ++i) {
+            if (m_typeRefs[i] > 0) {
+                m_types |= (1u << i);
+            }
+        }
+    }
+
     void dispatch()
     {
         GstMessage *message;
         gst_object_ref(m_bus);
-        while((message = gst_bus_pop(m_bus)) != NULL) {
+        //all the types may have been removed while the watch is still referenced.
+        //gst_bus_pop_filtered() refuses an empty filter and would leave the bus fd
+        //readable forever, so drop everything that nobody asked for here instead
+        if (m_types == 0) {
+            while ((message = gst_bus_pop(m_bus)) != NULL) {
+                gst_message_unref(message);
+            }
+        }
+        //messages of types that nobody asked for are discarded by the bus itself;
+        //m_types is checked again because a slot may remove the watch's types
+        while (m_types != 0 &&
+               (message = gst_bus_pop_filtered(m_bus, static_cast<GstMessageType>(m_types))) != NULL) {
+            if (GST_MESSAGE_TYPE(message) & m_batchTypes) {
+                coalesce(message);
+                continue;
+            }
             MessagePtr msg = MessagePtr::wrap(message, false);
-            QGlib::Quark detail = gst_message_type_to_quark(static_cast<GstMessageType>(msg->type()));
-            QGlib::emitWithDetail<void>(m_bus, "message", detail, msg);
+            QGlib::Quark detail = gst_message_type_to_quark(GST_MESSAGE_TYPE(message));
+            QGlib::emitWithDetail<void>(m_messageSignal, m_bus, detail, msg);
         }
+        deliverBatch();
         gst_object_unref(m_bus);
     }
 
+    //keeps only the latest message for each key; takes the reference of message
+    void coalesce(GstMessage *message)
+    {
+        const GstStructure *structure = gst_message_get_structure(message);
+        CoalescingKey key;
+        key.source = GST_MESSAGE_SRC(message);
+        key.type = GST_MESSAGE_TYPE(message);
+        key.name = structure ? gst_structure_get_name_id(structure) : 0;
+
+        QHash<CoalescingKey, int>::const_iterator it = m_batchIndex.constFind(key);
+        if (it != m_batchIndex.constEnd()) {
+            gst_message_unref(m_batch[it.value()]);
+            m_batch[it.value()] = message;
+        } else {
+            m_batchIndex.insert(key, m_batch.size());
+            m_batch.append(message);
+        }
+    }
+
+    void deliverBatch()
+    {
+        if (m_batch.isEmpty()) {
+            return;
+        }
+
+        QList<MessagePtr> messages;
+        messages.reserve(m_batch.size());
+        for (int i = 0; i < m_batch.size(); ++i) {
+            messages.append(MessagePtr::wrap(m_batch.at(i), false));
+        }
+        m_batch.clear();
+        m_batchIndex.clear();
+
+        if (m_batchHandler) {
+            m_deliveringBatch = true;
+            m_batchHandler->invoke(messages);
+            m_deliveringBatch = false;
+            delete m_deadBatchHandler;
+            m_deadBatchHandler = NULL;
+        }
+    }
+
     GstBus *m_bus;
+    QSocketNotifier *m_notifier;
+    bool m_stopped;
     QBasicTimer m_timer;
+    QGlib::SignalHandle m_messageSignal;
+
+    uint m_typeRefs[32];
+    uint m_types;
+
+    uint m_batchTypes;
+    BusBatchHandlerBase *m_batchHandler;
+    BusBatchHandlerBase *m_deadBatchHandler;
+    bool m_deliveringBatch;
+    QVector<GstMessage*> m_batch;
+    QHash<CoalescingKey, int> m_batchIndex;
 };
 
 class BusWatchManager
 {
 public:
-    void addWatch(GstBus *bus)
+    void addWatch(GstBus *bus, uint types)
     {
         if (m_watches.contains(bus)) {
             m_watches[bus].second++; //reference count
@@ -77,10 +271,19 @@ public:
             m_watches.insert(bus, qMakePair(new BusWatch(bus), uint(1)));
             g_object_weak_ref(G_OBJECT(bus), &BusWatchManager::onBusDestroyed, this);
         }
+        m_watches[bus].first->addTypes(types);
     }
 
-    void removeWatch(GstBus *bus)
+    BusWatch *watch(GstBus *bus) const
     {
+        return m_watches.contains(bus) ? m_watches[bus].first : NULL;
+    }
+
+    void removeWatch(GstBus *bus, uint types)
+    {
+        if (m_watches.contains(bus)) {
+            m_watches[bus].first->removeTypes(types);
+        }
         if (m_watches.contains(bus) && --m_watches[bus].second == 0) {
             m_watches[bus].first->stop();
             m_watches[bus].first->deleteLater();
@@ -134,10 +337,15 @@ MessagePtr Bus::pop(ClockTime timeout)
     return MessagePtr::wrap(gst_bus_timed_pop(object<GstBus>(), timeout), false);
 }
 
-MessagePtr Bus::pop(MessageType type, ClockTime timeout)
+MessagePtr Bus::pop(MessageTypes types, ClockTime timeout)
 {
     return MessagePtr::wrap(gst_bus_timed_pop_filtered(object<GstBus>(), timeout,
-                                                       static_cast<GstMessageType>(type)), false);
+                                                       static_cast<GstMessageType>(static_cast<int>(types))), false);
+}
+
+MessagePtr Bus::pop(MessageType type, ClockTime timeout)
+{
+    return pop(MessageTypes(type), timeout);
 }
 
 bool Bus::post(const MessagePtr & message)
@@ -152,12 +360,41 @@ void Bus::setFlushing(bool flush)
 
 void Bus::addSignalWatch()
 {
-    Private::s_watchManager()->addWatch(object<GstBus>());
+    addSignalWatch(MessageAny);
+}
+
+void Bus::addSignalWatch(MessageTypes types)
+{
+    Private::s_watchManager()->addWatch(object<GstBus>(), types);
 }
 
 void Bus::removeSignalWatch()
 {
-    Private::s_watchManager()->removeWatch(object<GstBus>());
+    removeSignalWatch(MessageAny);
+}
+
+void Bus::removeSignalWatch(MessageTypes types)
+{
+    Private::s_watchManager()->removeWatch(object<GstBus>(), types);
+}
+
+void Bus::setCoalescingHandlerImpl(MessageTypes types, Private::BusBatchHandlerBase *handler)
+{
+    Private::BusWatch *watch = Private::s_watchManager()->watch(object<GstBus>());
+    if (!watch) {
+        qWarning() << "QGst::Bus::setCoalescingHandler: The bus has no signal watch";
+        delete handler;
+        return;
+    }
+    watch->setBatchHandler(types, handler);
+}
+
+void Bus::unsetCoalescingHandler()
+{
+    Private::BusWatch *watch = Private::s_watchManager()->watch(object<GstBus>());
+    if (watch) {
+        watch->setBatchHandler(0, NULL);
+    }
 }
 
 void Bus::enableSyncMessageEmission()
@@ -170,4 +407,185 @@ void Bus::disableSyncMessageEmission()
     gst_bus_disable_sync_message_emission(object<GstBus>());
 }
 
+namespace Private {
+
+/* A handler of Bus::setSyncHandler(), shared by the slot and the calls that
+ * are running it, so that a replaced handler is deleted after its last call. */
+struct BusSyncHandlerRef
+{
+    explicit BusSyncHandlerRef(BusSyncHandlerBase *h) : refCount(1), handler(h) {}
+    ~BusSyncHandlerRef() { delete handler; }
+
+    QAtomicInt refCount;
+    BusSyncHandlerBase *handler;
+};
+
+static void releaseSyncHandler(BusSyncHandlerRef *handler)
+{
+    if (handler && !handler->refCount.deref()) {
+        delete handler;
+    }
+}
+
+/* The slot is installed with gst_bus_set_sync_handler() by the first
+ * setSyncHandler() call and stays installed until unsetSyncHandler() is called
+ * or the bus is destroyed. Replacing the handler only swaps the pointer in the
+ * slot, so messages posted meanwhile go through either the old or the new one.
+ * The mutex is only held to swap or to reference the handler, never during a call. */
+class BusSyncSlot
+{
+public:
+    explicit BusSyncSlot(GstBus *bus) : m_bus(bus), m_handler(NULL) {}
+    ~BusSyncSlot() { releaseSyncHandler(m_handler); }
+
+    static GQuark quark()
+    {
+        static const GQuark q = g_quark_from_static_string("QGst__bus_sync_slot");
+        return q;
+    }
+
+    GstBus *bus() const { return m_bus; }
+
+    BusSyncHandlerRef *acquire()
+    {
+        QMutexLocker l(&m_mutex);
+        if (m_handler) {
+            m_handler->refCount.ref();
+        }
+        return m_handler;
+    }
+
+    void setHandler(BusSyncHandlerRef *handler)
+    {
+        BusSyncHandlerRef *old;
+        {
+            QMutexLocker l(&m_mutex);
+            old = m_handler;
+            m_handler = handler;
+        }
+        releaseSyncHandler(old);
+    }
+
+private:
+    GstBus *m_bus;
+    QMutex m_mutex;
+    BusSyncHandlerRef *m_handler;
+};
+
+//serializes installing and removing the slots; replacing a handler does not take it
+Q_GLOBAL_STATIC(QMutex, s_syncSlotMutex)
+
+/* Calls the handler with a view of the message that is constructed on the stack,
+ * instead of the cached wrapper, which would be allocated for every message.
+ * The view has the same class as the wrapper that MessagePtr::wrap() returns. */
+template <class T>
+static inline BusSyncReply invokeWithView(BusSyncHandlerBase *handler, GstMessage *message)
+{
+    StackWrapper<T> view(message);
+    return handler->invoke(&view);
+}
+
+static BusSyncReply invokeSyncHandler(BusSyncHandlerBase *handler, GstMessage *message)
+{
+    switch (GST_MESSAGE_TYPE(message)) {
+    case GST_MESSAGE_EOS:
+        return invokeWithView<EosMessage>(handler, message);
+    case GST_MESSAGE_ERROR:
+        return invokeWithView<ErrorMessage>(handler, message);
+    case GST_MESSAGE_WARNING:
+        return invokeWithView<WarningMessage>(handler, message);
+    case GST_MESSAGE_INFO:
+        return invokeWithView<InfoMessage>(handler, message);
+    case GST_MESSAGE_TAG:
+        return invokeWithView<TagMessage>(handler, message);
+    case GST_MESSAGE_BUFFERING:
+        return invokeWithView<BufferingMessage>(handler, message);
+    case GST_MESSAGE_STATE_CHANGED:
+        return invokeWithView<StateChangedMessage>(handler, message);
+    case GST_MESSAGE_STEP_DONE:
+        return invokeWithView<StepDoneMessage>(handler, message);
+    case GST_MESSAGE_STREAM_STATUS:
+        return invokeWithView<StreamStatusMessage>(handler, message);
+    case GST_MESSAGE_APPLICATION:
+        return invokeWithView<ApplicationMessage>(handler, message);
+    case GST_MESSAGE_ELEMENT:
+        return invokeWithView<ElementMessage>(handler, message);
+    case GST_MESSAGE_SEGMENT_DONE:
+        return invokeWithView<SegmentDoneMessage>(handler, message);
+    case GST_MESSAGE_DURATION_CHANGED:
+        return invokeWithView<DurationChangedMessage>(handler, message);
+    case GST_MESSAGE_LATENCY:
+        return invokeWithView<LatencyMessage>(handler, message);
+    case GST_MESSAGE_ASYNC_DONE:
+        return invokeWithView<AsyncDoneMessage>(handler, message);
+    case GST_MESSAGE_REQUEST_STATE:
+        return invokeWithView<RequestStateMessage>(handler, message);
+    case GST_MESSAGE_STEP_START:
+        return invokeWithView<StepStartMessage>(handler, message);
+    case GST_MESSAGE_QOS:
+        return invokeWithView<QosMessage>(handler, message);
+    default:
+        return invokeWithView<Message>(handler, message);
+    }
+}
+
+} //namespace Private
+
+struct BusSyncTrampoline
+{
+    static GstBusSyncReply invoke(GstBus *bus, GstMessage *message, gpointer userData)
+    {
+        Q_UNUSED(bus);
+        Private::BusSyncHandlerRef *handler = static_cast<Private::BusSyncSlot*>(userData)->acquire();
+        if (!handler) {
+            return GST_BUS_PASS;
+        }
+
+        //the bus owns the message and may drop it after we return
+        GstBusSyncReply reply = static_cast<GstBusSyncReply>(
+            Private::invokeSyncHandler(handler->handler, message));
+        Private::releaseSyncHandler(handler);
+        return reply;
+    }
+
+    //called when the slot is uninstalled or the bus is destroyed
+    static void destroy(gpointer userData)
+    {
+        Private::BusSyncSlot *slot = static_cast<Private::BusSyncSlot*>(userData);
+        g_object_set_qdata(G_OBJECT(slot->bus()), Private::BusSyncSlot::quark(), NULL);
+        delete slot;
+    }
+};
+
+void Bus::setSyncHandlerImpl(Private::BusSyncHandlerBase *handler)
+{
+    GstBus *bus = object<GstBus>();
+    Private::BusSyncHandlerRef *handlerRef = new Private::BusSyncHandlerRef(handler);
+    QMutexLocker l(Private::s_syncSlotMutex());
+
+    Private::BusSyncSlot *slot = static_cast<Private::BusSyncSlot*>(
+        g_object_get_qdata(G_OBJECT(bus), Private::BusSyncSlot::quark()));
+    if (slot) {
+        slot->setHandler(handlerRef);
+        return;
+    }
+
+    slot = new Private::BusSyncSlot(bus);
+    slot->setHandler(handlerRef);
+    g_object_set_qdata(G_OBJECT(bus), Private::BusSyncSlot::quark(), slot);
+
+    //GStreamer refuses to replace a handler, so remove one that
+    //was installed through the C API before installing the slot
+    gst_bus_set_sync_handler(bus, NULL, NULL, NULL);
+    gst_bus_set_sync_handler(bus, &BusSyncTrampoline::invoke, slot, &BusSyncTrampoline::destroy);
+}
+
+void Bus::unsetSyncHandler()
+{
+    QMutexLocker l(Private::s_syncSlotMutex());
+    gst_bus_set_sync_handler(object<GstBus>(), NULL, NULL, NULL);
+}
+
 } //namespace QGst
+
+#include "bus.moc"
@@ -19,9 +19,74 @@
 
 #include "object.h"
 #include "clocktime.h"
+#include <QtCore/QList>
 
 namespace QGst {
 
+namespace Private {
+
+/* Type-erased handler of Bus::setSyncHandler() */
+class QTGSTREAMER_EXPORT BusSyncHandlerBase
+{
+public:
+    virtual ~BusSyncHandlerBase() {}
+    virtual BusSyncReply invoke(Message *message) = 0;
+};
+
+template <typename Function>
+class BusSyncHandler : public BusSyncHandlerBase
+{
+public:
+    BusSyncHandler(Function function) : m_function(function) {}
+    virtual BusSyncReply invoke(Message *message) { return m_function(message); }
+private:
+    Function m_function;
+};
+
+template <class T>
+class BusSyncMemberHandler : public BusSyncHandlerBase
+{
+public:
+    typedef BusSyncReply (T::*Method)(Message *);
+    BusSyncMemberHandler(T *receiver, Method method) : m_receiver(receiver), m_method(method) {}
+    virtual BusSyncReply invoke(Message *message) { return (m_receiver->*m_method)(message); }
+private:
+    T *m_receiver;
+    Method m_method;
+};
+
+/* Type-erased handler of Bus::setCoalescingHandler() */
+class QTGSTREAMER_EXPORT BusBatchHandlerBase
+{
+public:
+    virtual ~BusBatchHandlerBase() {}
+    virtual void invoke(const QList<MessagePtr> & messages) = 0;
+};
+
+template <typename Function>
+class BusBatchHandler : public BusBatchHandlerBase
+{
+public:
+    BusBatchHandler(Function function) : m_function(function) {}
+    virtual void invoke(const QList<MessagePtr> & messages) { m_function(messages); }
+private:
+    Function m_function;
+};
+
+template <class T>
+class BusBatchMemberHandler : public BusBatchHandlerBase
+{
+public:
+    typedef void (T::*Method)(const QList<MessagePtr> &);
+    BusBatchMemberHandler(T *receiver, Method method) : m_receiver(receiver), m_method(method) {}
+    virtual void invoke(const QList<MessagePtr> & messages) { (m_receiver->*m_method)(messages); }
+private:
+    T *m_receiver;
+    Method m_method;
+};
+
+} //namespace Private
+
 /*! \headerfile bus.h <QGst/Bus>
  * \brief Wrapper class for GstBus
  *
@@ -38,6 +103,8 @@ namespace QGst {
  * \li Enable the emission of the "sync-message" signal using enableSyncMessageEmission()
  * and connect to this signal. The slot connected to this signal will be called
  * synchronously from the thread that posts the message.
+ * \li Install a sync handler with setSyncHandler(). It is called synchronously like
+ * the "sync-message" signal, but it can also drop messages before they are queued.
  * \li Add a signal "watch" to the bus. This is an object that will poll the bus from the
  * main event loop and will emit the "message" signal on the main thread whenever a new
  * message is available. Note that the watch will pop messages from the bus, so they
@@ -75,10 +142,11 @@ public:
 
     /*! \overload
      * This version of pop() will return only messages that match the specified message
-     * \a type. All other messages that have been posted before the returned message
-     * will be discarded. You may use an OR combination of MessageTypes as the \a type
-     * to filter multiple types.
+     * \a types. All other messages that have been posted before the returned message
+     * will be discarded. \a types is an OR combination of MessageType values.
      */
+    MessagePtr pop(MessageTypes types, ClockTime timeout = 0);
+    /*! \overload */
     MessagePtr pop(MessageType type, ClockTime timeout = 0);
 
 
@@ -88,10 +156,16 @@ public:
     void setFlushing(bool flush);
 
 
-    /*! This adds a signal "watch" object, an object that will poll the bus from the
-     * event loop of the thread that called this function first. In every event loop
-     * execution, any pending messages will be popped from the bus and the "message"
-     * signal of the bus will be emitted.
+    /*! This adds a signal "watch" object, an object that will watch the bus from the
+     * event loop of the thread that called this function first. Whenever messages are
+     * posted, the event loop is woken up, any pending messages are popped from the bus
+     * and the "message" signal of the bus is emitted for each one of them, with the
+     * message type as the signal detail (e.g. "message::eos").
+     *
+     * The watch is woken up through the bus' poll file descriptor, so messages are
+     * delivered as soon as the event loop gets to run and an idle watch causes no
+     * wakeups at all. If the poll file descriptor is not available (GStreamer older
+     * than 1.14 or Windows), the watch falls back to polling the bus every 50 ms.
      *
      * The caller is responsible to cleanup by calling the removeSignalWatch() function
      * when this functionality is no longer needed. When the bus is destroyed, the watch
@@ -100,20 +174,62 @@ public:
      * If this function is called multiple times, a reference count will be incremented
      * on the same watch. You cannot have multiple watches on the same bus.
      *
+     * \a types selects the types of the messages that the watch delivers, as an OR
+     * combination of MessageType values. Messages of other types are popped and discarded
+     * without being wrapped, so that a watch that only cares about errors and the end
+     * of stream costs nothing for high-rate messages such as QoS or element messages.
+     * When the watch is added multiple times, it delivers the union of the types that
+     * are still requested; removeSignalWatch() takes the same \a types argument.
+     *
      * \note
      * \li This functionality requires a running Qt event loop.
      * \li This is \em not a wrapper for the gst_bus_add_signal_watch() function. It uses
      * a different implementation based on Qt's event loop instead of the Glib one, so that
      * it is possible to use it even if you are not using a Glib event loop underneath.
      */
+    void addSignalWatch(MessageTypes types);
+    /*! \overload
+     * Adds a watch that delivers the messages of all types. */
     void addSignalWatch();
 
     /*! Removes a signal "watch" object that was previously added with addSignalWatch().
      * If addSignalWatch() has been called multiple times, this function will decrement the
      * watch'es reference count and will remove it only when the reference count reaches zero.
+     * \a types must be the same as in the matching call to addSignalWatch().
      */
+    void removeSignalWatch(MessageTypes types);
+    /*! \overload
+     * Removes a watch that was added with addSignalWatch() without arguments. */
     void removeSignalWatch();
 
+    /*! Makes the signal watch deliver the messages of \a types in batches to \a handler,
+     * instead of emitting the "message" signal for each one of them. Within each batch,
+     * only the latest message for each combination of source, type and structure name
+     * is kept, so a source that posts many messages between two runs of the event loop
+     * (e.g. a level element) costs a single wrapper. The batch is delivered after the
+     * messages of other types that were popped in the same run, in the order in which
+     * the retained messages were first seen.
+     *
+     * \a handler can be a function pointer or any object that can be called as
+     * void handler(const QList<QGst::MessagePtr> & messages), such as a C++11 lambda.
+     * It is called from the thread of the watch.
+     *
+     * This requires a signal watch, which must also be asked for \a types in
+     * addSignalWatch(). The handler replaces any previous one and is removed
+     * together with the watch.
+     */
+    template <typename Function>
+    void setCoalescingHandler(MessageTypes types, Function handler);
+
+    /*! \overload
+     * Calls \a method on \a receiver. \a receiver must outlive the handler. */
+    template <class T>
+    void setCoalescingHandler(MessageTypes types, T *receiver,
+                              void (T::*method)(const QList<MessagePtr> &));
+
+    /*! Makes the signal watch emit the "message" signal for every message again */
+    void unsetCoalescingHandler();
+
 
     /*! Enables the emission of the "sync-message" signal. This signal will be emitted
      * synchronously from inside post() whenever a new message is posted. Be aware
@@ -130,8 +246,76 @@ public:
      * times as enableSyncMessageEmission() has been called.
      */
     void disableSyncMessageEmission();
+
+
+    /*! Installs \a handler as the sync handler of the bus, replacing any previous one.
+     * \a handler is called from the thread that posts each message, before the message
+     * is queued, and can be a function pointer or any object that can be called as
+     * BusSyncReply handler(QGst::Message *message), such as a C++11 lambda. Its return
+     * value decides what happens to the message:
+     * \li BusPass queues the message on the bus, as usual.
+     * \li BusDrop discards the message. Nobody else will see it.
+     * \li BusAsync queues the message and blocks the posting thread until it is popped.
+     *
+     * The handler is called directly, without going through QGlib::Value or a signal
+     * emission. The message is a view that is constructed on the stack for the call,
+     * so it costs no allocation: no reference is taken, the pointer is only valid until
+     * the handler returns and it cannot be held in a RefPointer. Its class is the same
+     * as that of the wrapper MessagePtr::wrap() would return, e.g. an ElementMessage
+     * for element messages. To keep the message, keep a MiniObject::copy() of it.
+     * \code
+     * //drop the element messages of a high-rate analysis element
+     * bus->setSyncHandler([](QGst::Message *message) {
+     *     return message->type() == QGst::MessageElement ? QGst::BusDrop : QGst::BusPass;
+     * });
+     * \endcode
+     * \note Bins and pipelines do not install a sync handler on their bus, but
+     * some applications and elements do; only one handler can be installed at a time.
+     * \note Replacing a handler that was installed with this function is atomic: each
+     * message goes through either the old or the new handler. A handler that was installed
+     * through the C API is removed first, as GStreamer does not allow replacing it.
+     */
+    template <typename Function>
+    void setSyncHandler(Function handler);
+
+    /*! \overload
+     * Calls \a method on \a receiver. \a receiver must outlive the handler. */
+    template <class T>
+    void setSyncHandler(T *receiver, BusSyncReply (T::*method)(Message *));
+
+    /*! Removes the handler that was installed with setSyncHandler() */
+    void unsetSyncHandler();
+
+private:
+    void setSyncHandlerImpl(Private::BusSyncHandlerBase *handler);
+    void setCoalescingHandlerImpl(MessageTypes types, Private::BusBatchHandlerBase *handler);
 };
 
+template <typename Function>
+inline void Bus::setSyncHandler(Function handler)
+{
+    setSyncHandlerImpl(new Private::BusSyncHandler<Function>(handler));
+}
+
+template <class T>
+inline void Bus::setSyncHandler(T *receiver, BusSyncReply (T::*method)(Message *))
+{
+    setSyncHandlerImpl(new Private::BusSyncMemberHandler<T>(receiver, method));
+}
+
+template <typename Function>
+inline void Bus::setCoalescingHandler(MessageTypes types, Function handler)
+{
+    setCoalescingHandlerImpl(types, new Private::BusBatchHandler<Function>(handler));
+}
+
+template <class T>
+inline void Bus::setCoalescingHandler(MessageTypes types, T *receiver,
+                                      void (T::*method)(const QList<MessagePtr> &))
+{
+    setCoalescingHandlerImpl(types, new Private::BusBatchMemberHandler<T>(receiver, method));
+}
+
 } //namespace QGst
 
 QGST_REGISTER_TYPE(QGst::Bus)
@@ -0,0 +1,293 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "capscache.h"
+#include <QtCore/QByteArray>
+#include <QtCore/QCache>
+#include <QtCore/QMutex>
+#include <gst/gst.h>
+
+namespace QGst {
+
+#ifndef DOXYGEN_RUN
+
+namespace {
+
+enum PairOperation { Intersection, CanIntersect, Subset };
+
+struct PairKey
+{
+    PairKey(PairOperation op, GstCaps *first, GstCaps *second)
+        : op(op), first(first), second(second) {}
+
+    inline bool operator==(const PairKey & other) const
+    { return op == other.op && first == other.first && second == other.second; }
+
+    PairOperation op;
+    GstCaps *first;
+    GstCaps *second;
+};
+
+inline uint qHash(const PairKey & key)
+{
+    return ::qHash(quintptr(key.first)) ^ (::qHash(quintptr(key.second)) * 31u) ^ uint(key.op);
+}
+
+struct StringEntry
+{
+    CapsPtr caps;
+};
+
+//the entry holds references to both caps, so that their addresses,
+//which are used in the key, cannot be reused while the entry exists
+struct PairEntry
+{
+    CapsPtr first;
+    CapsPtr second;
+    CapsPtr intersection;
+    bool result;
+};
+
+} //anonymous namespace
+
+struct QTGSTREAMER_NO_EXPORT CapsCache::Data
+{
+    mutable QMutex mutex;
+    QCache<QByteArray, StringEntry> strings;
+    QCache<PairKey, PairEntry> pairs;
+    Statistics statistics;
+
+    //Looks up the entry of the given pair. On a hit, this copies the result and
+    //updates the counters. The mutex must be locked.
+    bool lookup(const PairKey & key, CapsPtr *intersection, bool *result);
+    //Computes the result of the operation without holding the mutex and stores it.
+    void compute(const PairKey & key, const CapsPtr & first, const CapsPtr & second,
+                 CapsPtr *intersection, bool *result);
+};
+
+bool CapsCache::Data::lookup(const PairKey & key, CapsPtr *intersection, bool *result)
+{
+    PairEntry *entry = pairs.object(key);
+    bool isSubset = (key.op == Subset);
+
+    if (!entry) {
+        ++(isSubset ? statistics.subsetMisses : statistics.intersectionMisses);
+        return false;
+    }
+
+    ++(isSubset ? statistics.subsetHits : statistics.intersectionHits);
+    if (intersection) {
+        *intersection = entry->intersection;
+    }
+    *result = entry->result;
+    return true;
+}
+
+void CapsCache::Data::compute(const PairKey & key, const CapsPtr & first, const CapsPtr & second,
+                              CapsPtr *intersection, bool *result)
+{
+    PairEntry *entry = new PairEntry;
+    entry->first = first;
+    entry->second = second;
+
+    switch (key.op) {
+    case Intersection:
+        entry->intersection = CapsPtr::wrap(gst_caps_intersect(key.first, key.second), false);
+        entry->result = !gst_caps_is_empty(entry->intersection);
+        *intersection = entry->intersection;
+        break;
+    case CanIntersect:
+        entry->result = gst_caps_can_intersect(key.first, key.second);
+        break;
+    case Subset:
+        entry->result = gst_caps_is_subset(key.first, key.second);
+        break;
+    }
+    *result = entry->result;
+
+    //another thread may have stored the same pair in the meantime,
+    //in which case this replaces its equivalent entry
+    QMutexLocker lock(&mutex);
+    pairs.insert(key, entry);
+}
+
+#endif //DOXYGEN_RUN
+
+CapsCache::Statistics::Statistics()
+    : parseHits(0), parseMisses(0),
+      intersectionHits(0), intersectionMisses(0),
+      subsetHits(0), subsetMisses(0),
+      stringEntries(0), pairEntries(0)
+{
+}
+
+CapsCache::CapsCache(int capacity)
+  : d(new Data)
+{
+    setCapacity(capacity);
+}
+
+CapsCache::~CapsCache()
+{
+    delete d;
+}
+
+int CapsCache::capacity() const
+{
+    QMutexLocker lock(&d->mutex);
+    return d->strings.maxCost();
+}
+
+void CapsCache::setCapacity(int capacity)
+{
+    QMutexLocker lock(&d->mutex);
+    d->strings.setMaxCost(capacity);
+    d->pairs.setMaxCost(capacity);
+}
+
+CapsPtr CapsCache::fromString(const char *string)
+{
+    QByteArray key(string);
+
+    {
+        QMutexLocker lock(&d->mutex);
+        StringEntry *entry = d->strings.object(key);
+        if (entry) {
+            ++d->statistics.parseHits;
+            return entry->caps;
+        }
+        ++d->statistics.parseMisses;
+    }
+
+    //parse without holding the lock, so that other threads are not blocked
+    StringEntry *entry = new StringEntry;
+    entry->caps = CapsPtr::wrap(gst_caps_from_string(string), false);
+    CapsPtr caps = entry->caps;
+
+    QMutexLocker lock(&d->mutex);
+    StringEntry *existing = d->strings.object(key);
+    if (existing) {
+        //another thread parsed the same string in the meantime;
+        //keep its caps, so that all callers share the same object
+        delete entry;
+        return existing->caps;
+    }
+    d->strings.insert(key, entry);
+    return caps;
+}
+
+CapsPtr CapsCache::getIntersection(const CapsPtr & caps1, const CapsPtr & caps2)
+{
+    if (caps1.isNull() || caps2.isNull()) {
+        return CapsPtr();
+    }
+
+    PairKey key(Intersection, caps1, caps2);
+    CapsPtr intersection;
+    bool result;
+
+    {
+        QMutexLocker lock(&d->mutex);
+        if (d->lookup(key, &intersection, &result)) {
+            return intersection;
+        }
+    }
+
+    d->compute(key, caps1, caps2, &intersection, &result);
+    return intersection;
+}
+
+bool CapsCache::canIntersect(const CapsPtr & caps1, const CapsPtr & caps2)
+{
+    if (caps1.isNull() || caps2.isNull()) {
+        return false;
+    }
+
+    //the operation is symmetric, so both orders share one entry
+    GstCaps *first = caps1;
+    GstCaps *second = caps2;
+    if (first > second) {
+        qSwap(first, second);
+    }
+
+    PairKey key(CanIntersect, first, second);
+    bool result;
+
+    {
+        QMutexLocker lock(&d->mutex);
+
+        //a known intersection also answers this question
+        PairEntry *entry = d->pairs.object(PairKey(Intersection, caps1, caps2));
+        if (!entry) {
+            entry = d->pairs.object(PairKey(Intersection, caps2, caps1));
+        }
+        if (entry) {
+            ++d->statistics.intersectionHits;
+            return entry->result;
+        }
+
+        if (d->lookup(key, NULL, &result)) {
+            return result;
+        }
+    }
+
+    d->compute(key, caps1, caps2, NULL, &result);
+    return result;
+}
+
+bool CapsCache::isSubset(const CapsPtr & subset, const CapsPtr & superset)
+{
+    if (subset.isNull() || superset.isNull()) {
+        return false;
+    }
+
+    PairKey key(Subset, subset, superset);
+    bool result;
+
+    {
+        QMutexLocker lock(&d->mutex);
+        if (d->lookup(key, NULL, &result)) {
+            return result;
+        }
+    }
+
+    d->compute(key, subset, superset, NULL, &result);
+    return result;
+}
+
+CapsCache::Statistics CapsCache::statistics() const
+{
+    QMutexLocker lock(&d->mutex);
+    Statistics statistics = d->statistics;
+    statistics.stringEntries = d->strings.size();
+    statistics.pairEntries = d->pairs.size();
+    return statistics;
+}
+
+void CapsCache::resetStatistics()
+{
+    QMutexLocker lock(&d->mutex);
+    d->statistics = Statistics();
+}
+
+void CapsCache::clear()
+{
+    QMutexLocker lock(&d->mutex);
+    d->strings.clear();
+    d->pairs.clear();
+}
+
+} //namespace QGst
@@ -0,0 +1,119 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef QGST_CAPSCACHE_H
+#define QGST_CAPSCACHE_H
+
+#include "caps.h"
+#include <QtCore/QString>
+
+namespace QGst {
+
+/*! \headerfile capscache.h <QGst/CapsCache>
+ * \brief A memoising cache for parsing and comparing Caps
+ *
+ * Parsing caps strings and intersecting caps are relatively expensive operations.
+ * Code that repeatedly does this with the same small set of caps, for example to
+ * choose between the branches of a dynamically built pipeline, can use a CapsCache
+ * instead of the equivalent methods of Caps.
+ *
+ * fromString() interns caps by their string, so it returns the same Caps object for
+ * the same string. getIntersection(), canIntersect() and isSubset() remember their
+ * results for each pair of caps. Pairs are identified by the Caps objects themselves,
+ * not by their contents, so these only hit the cache for caps that are reused, such as
+ * the interned caps that fromString() returns. The cache keeps a reference to every
+ * Caps object that it knows about.
+ *
+ * Each of the two tables, for strings and for pairs, holds at most capacity() entries.
+ * When a table is full, its least recently used entry is evicted. The hit and miss
+ * counters in statistics() can be used to tune the capacity.
+ * \code
+ * QGst::CapsCache cache;
+ * QGst::CapsPtr raw = cache.fromString("video/x-raw");
+ * QGst::CapsPtr yuv = cache.fromString("video/x-raw, format=(string)I420");
+ * if (cache.canIntersect(raw, yuv)) ...
+ * //caps from elsewhere, such as Pad::allowedCaps(), are new objects on each call;
+ * //intern them first, or they will never hit the cache and only evict other entries
+ * QGst::CapsPtr allowed = cache.fromString(pad->allowedCaps()->toString());
+ * \endcode
+ *
+ * All the methods of this class are thread-safe.
+ *
+ * \note The caps that this class returns are shared with the cache and with other
+ * callers, so they must not be modified. Use Caps::copy() or Caps::makeWritable()
+ * to obtain caps that can be modified.
+ */
+class QTGSTREAMER_EXPORT CapsCache
+{
+public:
+    /*! \brief Hit and miss counters of a CapsCache
+     *
+     * getIntersection() and canIntersect() share the intersection counters. */
+    struct Statistics
+    {
+        Statistics();
+
+        quint64 parseHits;
+        quint64 parseMisses;
+        quint64 intersectionHits;
+        quint64 intersectionMisses;
+        quint64 subsetHits;
+        quint64 subsetMisses;
+        /*! The current number of entries in the string and in the pair table. */
+        int stringEntries;
+        int pairEntries;
+    };
+
+    explicit CapsCache(int capacity = 256);
+    ~CapsCache();
+
+    int capacity() const;
+    /*! Sets the maximum number of entries of each table, evicting the
+     * least recently used entries if there are more than \a capacity. */
+    void setCapacity(int capacity);
+
+    /*! Returns the caps that \a string describes, parsing it only the first time.
+     * Strings that cannot be parsed are remembered as well and return a null CapsPtr. */
+    CapsPtr fromString(const char *string);
+    inline CapsPtr fromString(const QString & string); ///< \overload
+
+    /*! Equivalent to caps1->getIntersection(caps2) */
+    CapsPtr getIntersection(const CapsPtr & caps1, const CapsPtr & caps2);
+    /*! Equivalent to caps1->canIntersect(caps2) */
+    bool canIntersect(const CapsPtr & caps1, const CapsPtr & caps2);
+    /*! Equivalent to subset->isSubsetOf(superset) */
+    bool isSubset(const CapsPtr & subset, const CapsPtr & superset);
+
+    Statistics statistics() const;
+    void resetStatistics();
+
+    /*! Removes all the entries and releases the caps that the cache holds. */
+    void clear();
+
+private:
+    Q_DISABLE_COPY(CapsCache)
+    struct Data;
+    Data *d;
+};
+
+inline CapsPtr CapsCache::fromString(const QString & string)
+{
+    return fromString(string.toUtf8().constData());
+}
+
+} //namespace QGst
+
+#endif
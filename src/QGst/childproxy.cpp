@@ -16,6 +16,7 @@
 */
 #include "childproxy.h"
 #include <gst/gst.h>
+#include <QtCore/QDebug>
 
 namespace QGst {
 
@@ -58,4 +59,49 @@ QGlib::Value ChildProxy::childProperty(const char *name) const
     }
 }
 
+void ChildProxy::setChildProperties(const QList< QPair<QByteArray, QGlib::Value> > & properties)
+{
+    //<child, its properties>, in the order in which the children first appear
+    QList< QPair< GObject*, QList< QPair<QGlib::PropertyHandle, QGlib::Value> > > > children;
+
+    for (int i = 0; i < properties.size(); ++i) {
+        GObject *child;
+        GParamSpec *param;
+        if (!gst_child_proxy_lookup(object<GstChildProxy>(), properties[i].first.constData(),
+                                    &child, &param)) {
+            qWarning() << "QGst::ChildProxy::setChildProperties: Could not find property"
+                       << properties[i].first;
+            continue;
+        }
+
+        int index = 0;
+        while (index < children.size() && children[index].first != child) {
+            ++index;
+        }
+        if (index == children.size()) {
+            children.append(qMakePair(child,
+                                      QList< QPair<QGlib::PropertyHandle, QGlib::Value> >()));
+        } else {
+            g_object_unref(child);
+        }
+
+        QGlib::PropertyHandle handle(G_OBJECT_TYPE(child), g_param_spec_get_name(param));
+        g_param_spec_unref(param);
+        children[index].second.append(qMakePair(handle, properties[i].second));
+    }
+
+    for (int i = 0; i < children.size(); ++i) {
+        QGlib::ObjectPtr::wrap(children[i].first, false)->setProperties(children[i].second);
+    }
+}
+
+QList<QGlib::Value> ChildProxy::childProperties(const QList<QByteArray> & names) const
+{
+    QList<QGlib::Value> result;
+    for (int i = 0; i < names.size(); ++i) {
+        result.append(childProperty(names[i].constData()));
+    }
+    return result;
+}
+
 }
@@ -36,6 +36,17 @@ public:
                            QGlib::ParamSpecPtr *paramSpec) const;
     QGlib::Value childProperty(const char *name) const;
     template <typename T> void setChildProperty(const char *name, const T & value);
+
+    /*! Sets several properties of children at once. The names use the "child::property"
+     * syntax of findChildProperty(). The properties are grouped by child and set with
+     * QGlib::ObjectBase::setProperties(), so each child emits notify only once for
+     * each of its properties, after all of them have been set.
+     */
+    void setChildProperties(const QList< QPair<QByteArray, QGlib::Value> > & properties);
+
+    /*! Returns the values of the children properties with the given \a names, in the same
+     * order. The Value of a property that cannot be found is invalid. */
+    QList<QGlib::Value> childProperties(const QList<QByteArray> & names) const;
 };
 
 template <typename T>
@@ -47,7 +58,7 @@ void ChildProxy::setChildProperty(const char *name, const T & value)
         QGlib::Value v;
         v.init(param->valueType());
         v.set<T>(value);
-        object->setProperty(param->name(), value);
+        object->setProperty(param->name().toUtf8(), v);
     }
 }
 
@@ -0,0 +1,627 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "customelement.h"
+#include "borrow_p.h"
+#include <QtCore/QByteArray>
+#include <QtCore/QMutex>
+#include <QtCore/QDebug>
+#include <gst/gst.h>
+#include <gst/base/gstbasetransform.h>
+#include <gst/base/gstbasesrc.h>
+#include <gst/base/gstbasesink.h>
+#include <cstring>
+
+namespace QGst {
+
+//BEGIN ElementClass
+
+void ElementClass::setMetadata(const char *longName, const char *classification,
+                               const char *description, const char *author)
+{
+    gst_element_class_set_metadata(GST_ELEMENT_CLASS(m_class), longName,
+                                   classification, description, author);
+}
+
+void ElementClass::addPadTemplate(const char *name, PadDirection direction,
+                                  PadPresence presence, const CapsPtr & caps)
+{
+    gst_element_class_add_pad_template(GST_ELEMENT_CLASS(m_class),
+            gst_pad_template_new(name, static_cast<GstPadDirection>(direction),
+                                 static_cast<GstPadPresence>(presence), caps));
+}
+
+//END ElementClass
+
+//BEGIN glue
+
+template <typename Parent>
+struct QGstCustomInstance
+{
+    Parent parent;
+    CustomElement *impl;
+};
+
+struct CustomElementTypeInfo
+{
+    Private::CustomElementKind kind;
+    Private::CustomElementCreateFunction create;
+    Private::CustomElementClassInitFunction classInit;
+};
+
+namespace Private {
+
+struct CustomElementGlue
+{
+    static GQuark typeInfoQuark();
+    static GType parentType(CustomElementKind kind);
+    static guint16 instanceSize(CustomElementKind kind);
+    static void classInit(gpointer klass, gpointer data);
+    static void instanceInit(GTypeInstance *instance, gpointer klass);
+
+    template <typename Parent>
+    static CustomElement *impl(Parent *object)
+    {
+        return reinterpret_cast<QGstCustomInstance<Parent>*>(object)->impl;
+    }
+
+    template <typename Parent>
+    static void finalize(GObject *object)
+    {
+        delete impl(reinterpret_cast<Parent*>(object));
+        G_OBJECT_CLASS(g_type_class_peek_parent(G_OBJECT_GET_CLASS(object)))->finalize(object);
+    }
+
+    //pads created with CustomElement::addPad()
+    static GstFlowReturn chain(GstPad *pad, GstObject *parent, GstBuffer *buffer);
+    static gboolean event(GstPad *pad, GstObject *parent, GstEvent *event);
+    static gboolean query(GstPad *pad, GstObject *parent, GstQuery *query);
+
+    //GstBaseTransform
+    static CustomTransform *transform(GstBaseTransform *trans)
+    {
+        return static_cast<CustomTransform*>(impl(trans));
+    }
+    static gboolean transformStart(GstBaseTransform *trans);
+    static gboolean transformStop(GstBaseTransform *trans);
+    static gboolean transformSetCaps(GstBaseTransform *trans, GstCaps *incaps, GstCaps *outcaps);
+    static GstCaps *transformCaps(GstBaseTransform *trans, GstPadDirection direction,
+                                  GstCaps *caps, GstCaps *filter);
+    static gboolean transformSize(GstBaseTransform *trans, GstPadDirection direction,
+                                  GstCaps *caps, gsize size, GstCaps *othercaps, gsize *othersize);
+    static GstFlowReturn transformIp(GstBaseTransform *trans, GstBuffer *buffer);
+    static GstFlowReturn transformCopy(GstBaseTransform *trans, GstBuffer *inbuf, GstBuffer *outbuf);
+
+    //GstBaseSrc
+    static CustomSource *source(GstBaseSrc *src)
+    {
+        return static_cast<CustomSource*>(impl(src));
+    }
+    static gboolean srcStart(GstBaseSrc *src);
+    static gboolean srcStop(GstBaseSrc *src);
+    static gboolean srcSetCaps(GstBaseSrc *src, GstCaps *caps);
+    static gboolean srcIsSeekable(GstBaseSrc *src);
+    static GstFlowReturn srcFill(GstBaseSrc *src, guint64 offset, guint size, GstBuffer *buffer);
+
+    //GstBaseSink
+    static CustomSink *sink(GstBaseSink *sink)
+    {
+        return static_cast<CustomSink*>(impl(sink));
+    }
+    static gboolean sinkStart(GstBaseSink *sink);
+    static gboolean sinkStop(GstBaseSink *sink);
+    static gboolean sinkSetCaps(GstBaseSink *sink, GstCaps *caps);
+    static GstFlowReturn sinkRender(GstBaseSink *sink, GstBuffer *buffer);
+    static GstFlowReturn sinkPreroll(GstBaseSink *sink, GstBuffer *buffer);
+};
+
+GQuark CustomElementGlue::typeInfoQuark()
+{
+    static GQuark quark = g_quark_from_static_string("QGstCustomElementTypeInfo");
+    return quark;
+}
+
+GType CustomElementGlue::parentType(CustomElementKind kind)
+{
+    switch (kind) {
+    case CustomElementKindInPlaceTransform:
+    case CustomElementKindCopyTransform:
+        return GST_TYPE_BASE_TRANSFORM;
+    case CustomElementKindSource:
+        return GST_TYPE_BASE_SRC;
+    case CustomElementKindSink:
+        return GST_TYPE_BASE_SINK;
+    default:
+        return GST_TYPE_ELEMENT;
+    }
+}
+
+guint16 CustomElementGlue::instanceSize(CustomElementKind kind)
+{
+    switch (kind) {
+    case CustomElementKindInPlaceTransform:
+    case CustomElementKindCopyTransform:
+        return sizeof(QGstCustomInstance<GstBaseTransform>);
+    case CustomElementKindSource:
+        return sizeof(QGstCustomInstance<GstBaseSrc>);
+    case CustomElementKindSink:
+        return sizeof(QGstCustomInstance<GstBaseSink>);
+    default:
+        return sizeof(QGstCustomInstance<GstElement>);
+    }
+}
+
+void CustomElementGlue::classInit(gpointer klass, gpointer data)
+{
+    const CustomElementTypeInfo *info = static_cast<const CustomElementTypeInfo*>(data);
+
+    switch (info->kind) {
+    case CustomElementKindInPlaceTransform:
+    case CustomElementKindCopyTransform:
+    {
+        G_OBJECT_CLASS(klass)->finalize = &CustomElementGlue::finalize<GstBaseTransform>;
+        GstBaseTransformClass *transformClass = GST_BASE_TRANSFORM_CLASS(klass);
+        transformClass->start = &CustomElementGlue::transformStart;
+        transformClass->stop = &CustomElementGlue::transformStop;
+        transformClass->set_caps = &CustomElementGlue::transformSetCaps;
+        transformClass->transform_caps = &CustomElementGlue::transformCaps;
+        transformClass->transform_size = &CustomElementGlue::transformSize;
+        if (info->kind == CustomElementKindInPlaceTransform) {
+            transformClass->transform_ip = &CustomElementGlue::transformIp;
+        } else {
+            transformClass->transform = &CustomElementGlue::transformCopy;
+        }
+        break;
+    }
+    case CustomElementKindSource:
+    {
+        G_OBJECT_CLASS(klass)->finalize = &CustomElementGlue::finalize<GstBaseSrc>;
+        GstBaseSrcClass *srcClass = GST_BASE_SRC_CLASS(klass);
+        srcClass->start = &CustomElementGlue::srcStart;
+        srcClass->stop = &CustomElementGlue::srcStop;
+        srcClass->set_caps = &CustomElementGlue::srcSetCaps;
+        srcClass->is_seekable = &CustomElementGlue::srcIsSeekable;
+        srcClass->fill = &CustomElementGlue::srcFill;
+        break;
+    }
+    case CustomElementKindSink:
+    {
+        G_OBJECT_CLASS(klass)->finalize = &CustomElementGlue::finalize<GstBaseSink>;
+        GstBaseSinkClass *sinkClass = GST_BASE_SINK_CLASS(klass);
+        sinkClass->start = &CustomElementGlue::sinkStart;
+        sinkClass->stop = &CustomElementGlue::sinkStop;
+        sinkClass->set_caps = &CustomElementGlue::sinkSetCaps;
+        sinkClass->render = &CustomElementGlue::sinkRender;
+        sinkClass->preroll = &CustomElementGlue::sinkPreroll;
+        break;
+    }
+    default:
+        G_OBJECT_CLASS(klass)->finalize = &CustomElementGlue::finalize<GstElement>;
+        break;
+    }
+
+    ElementClass elementClass(klass);
+    info->classInit(elementClass);
+}
+
+void CustomElementGlue::instanceInit(GTypeInstance *instance, gpointer klass)
+{
+    const CustomElementTypeInfo *info = static_cast<const CustomElementTypeInfo*>(
+            g_type_get_qdata(G_TYPE_FROM_CLASS(klass), typeInfoQuark()));
+
+    CustomElement *element = info->create();
+    element->m_element = GST_ELEMENT(instance);
+
+    switch (info->kind) {
+    case CustomElementKindInPlaceTransform:
+    case CustomElementKindCopyTransform:
+        reinterpret_cast<QGstCustomInstance<GstBaseTransform>*>(instance)->impl = element;
+        break;
+    case CustomElementKindSource:
+        reinterpret_cast<QGstCustomInstance<GstBaseSrc>*>(instance)->impl = element;
+        break;
+    case CustomElementKindSink:
+        reinterpret_cast<QGstCustomInstance<GstBaseSink>*>(instance)->impl = element;
+        break;
+    default:
+        reinterpret_cast<QGstCustomInstance<GstElement>*>(instance)->impl = element;
+        break;
+    }
+
+    element->initialize();
+}
+
+GstFlowReturn CustomElementGlue::chain(GstPad *pad, GstObject *parent, GstBuffer *buffer)
+{
+    Q_UNUSED(parent);
+    BufferPtr b = BufferPtr::wrap(buffer, false);
+    return static_cast<GstFlowReturn>(
+        static_cast<CustomElement*>(GST_PAD_CHAINDATA(pad))->chain(Private::borrow<Pad>(pad), b));
+}
+
+gboolean CustomElementGlue::event(GstPad *pad, GstObject *parent, GstEvent *event)
+{
+    Q_UNUSED(parent);
+    return static_cast<CustomElement*>(GST_PAD_EVENTDATA(pad))->event(
+            Private::borrow<Pad>(pad), EventPtr::wrap(event, false));
+}
+
+gboolean CustomElementGlue::query(GstPad *pad, GstObject *parent, GstQuery *query)
+{
+    Q_UNUSED(parent);
+    return static_cast<CustomElement*>(GST_PAD_QUERYDATA(pad))->query(
+            Private::borrow<Pad>(pad), Private::borrow<Query>(query));
+}
+
+gboolean CustomElementGlue::transformStart(GstBaseTransform *trans)
+{
+    return transform(trans)->start();
+}
+
+gboolean CustomElementGlue::transformStop(GstBaseTransform *trans)
+{
+    return transform(trans)->stop();
+}
+
+gboolean CustomElementGlue::transformSetCaps(GstBaseTransform *trans, GstCaps *incaps, GstCaps *outcaps)
+{
+    return transform(trans)->setCaps(CapsPtr::wrap(incaps), CapsPtr::wrap(outcaps));
+}
+
+GstCaps *CustomElementGlue::transformCaps(GstBaseTransform *trans, GstPadDirection direction,
+                                          GstCaps *caps, GstCaps *filter)
+{
+    CapsPtr result = transform(trans)->transformCaps(static_cast<PadDirection>(direction),
+                                                     CapsPtr::wrap(caps), CapsPtr::wrap(filter));
+    return result ? gst_caps_ref(result) : gst_caps_new_empty();
+}
+
+gboolean CustomElementGlue::transformSize(GstBaseTransform *trans, GstPadDirection direction,
+                                          GstCaps *caps, gsize size, GstCaps *othercaps,
+                                          gsize *othersize)
+{
+    size_t otherSize = 0;
+    bool ok = transform(trans)->transformSize(static_cast<PadDirection>(direction),
+                                              CapsPtr::wrap(caps), size,
+                                              CapsPtr::wrap(othercaps), &otherSize);
+    *othersize = otherSize;
+    return ok;
+}
+
+GstFlowReturn CustomElementGlue::transformIp(GstBaseTransform *trans, GstBuffer *buffer)
+{
+    CustomInPlaceTransform *self = static_cast<CustomInPlaceTransform*>(impl(trans));
+    return static_cast<GstFlowReturn>(self->transformInPlace(Private::borrow<Buffer>(buffer)));
+}
+
+GstFlowReturn CustomElementGlue::transformCopy(GstBaseTransform *trans, GstBuffer *inbuf, GstBuffer *outbuf)
+{
+    CustomCopyTransform *self = static_cast<CustomCopyTransform*>(impl(trans));
+    return static_cast<GstFlowReturn>(self->transform(Private::borrow<Buffer>(inbuf),
+                                                      Private::borrow<Buffer>(outbuf)));
+}
+
+gboolean CustomElementGlue::srcStart(GstBaseSrc *src)
+{
+    return source(src)->start();
+}
+
+gboolean CustomElementGlue::srcStop(GstBaseSrc *src)
+{
+    return source(src)->stop();
+}
+
+gboolean CustomElementGlue::srcSetCaps(GstBaseSrc *src, GstCaps *caps)
+{
+    return source(src)->setCaps(CapsPtr::wrap(caps));
+}
+
+gboolean CustomElementGlue::srcIsSeekable(GstBaseSrc *src)
+{
+    return source(src)->isSeekable();
+}
+
+GstFlowReturn CustomElementGlue::srcFill(GstBaseSrc *src, guint64 offset, guint size, GstBuffer *buffer)
+{
+    return static_cast<GstFlowReturn>(
+        source(src)->fill(offset, size, Private::borrow<Buffer>(buffer)));
+}
+
+gboolean CustomElementGlue::sinkStart(GstBaseSink *sink)
+{
+    return CustomElementGlue::sink(sink)->start();
+}
+
+gboolean CustomElementGlue::sinkStop(GstBaseSink *sink)
+{
+    return CustomElementGlue::sink(sink)->stop();
+}
+
+gboolean CustomElementGlue::sinkSetCaps(GstBaseSink *sink, GstCaps *caps)
+{
+    return CustomElementGlue::sink(sink)->setCaps(CapsPtr::wrap(caps));
+}
+
+GstFlowReturn CustomElementGlue::sinkRender(GstBaseSink *sink, GstBuffer *buffer)
+{
+    return static_cast<GstFlowReturn>(
+        CustomElementGlue::sink(sink)->render(Private::borrow<Buffer>(buffer)));
+}
+
+GstFlowReturn CustomElementGlue::sinkPreroll(GstBaseSink *sink, GstBuffer *buffer)
+{
+    return static_cast<GstFlowReturn>(
+        CustomElementGlue::sink(sink)->preroll(Private::borrow<Buffer>(buffer)));
+}
+
+Q_GLOBAL_STATIC(QMutex, s_registerMutex)
+
+QGlib::Type registerCustomElement(const char *elementName, CustomElementKind kind,
+                                  CustomElementCreateFunction create,
+                                  CustomElementClassInitFunction classInit)
+{
+    QByteArray typeName = QByteArray("QGstCustom-") + elementName;
+
+    //two threads may register the same element, e.g. from two StaticPlugins;
+    //the second one must find the type of the first instead of registering it again
+    QMutexLocker l(s_registerMutex());
+    GType type = g_type_from_name(typeName.constData());
+    if (type) {
+        return type;
+    }
+
+    GType parent = CustomElementGlue::parentType(kind);
+    GTypeQuery query;
+    g_type_query(parent, &query);
+
+    //types are never unregistered, so neither is this freed
+    CustomElementTypeInfo *info = new CustomElementTypeInfo;
+    info->kind = kind;
+    info->create = create;
+    info->classInit = classInit;
+
+    GTypeInfo typeInfo;
+    std::memset(&typeInfo, 0, sizeof(GTypeInfo));
+    typeInfo.class_size = query.class_size;
+    typeInfo.class_init = &CustomElementGlue::classInit;
+    typeInfo.class_data = info;
+    typeInfo.instance_size = CustomElementGlue::instanceSize(kind);
+    typeInfo.instance_init = &CustomElementGlue::instanceInit;
+
+    type = g_type_register_static(parent, typeName.constData(), &typeInfo, GTypeFlags(0));
+    g_type_set_qdata(type, CustomElementGlue::typeInfoQuark(), info);
+    return type;
+}
+
+} //namespace Private
+
+//END glue
+
+//BEGIN CustomElement
+
+CustomElement::CustomElement()
+  : m_element(NULL)
+{
+}
+
+CustomElement::~CustomElement()
+{
+}
+
+//static
+CustomElement *CustomElement::fromElement(const ElementPtr & element)
+{
+    if (element.isNull()) {
+        return NULL;
+    }
+
+    GType type = G_TYPE_FROM_INSTANCE(static_cast<GstElement*>(element));
+    const CustomElementTypeInfo *info = static_cast<const CustomElementTypeInfo*>(
+            g_type_get_qdata(type, Private::CustomElementGlue::typeInfoQuark()));
+    if (!info) {
+        return NULL;
+    }
+
+    switch (info->kind) {
+    case Private::CustomElementKindInPlaceTransform:
+    case Private::CustomElementKindCopyTransform:
+        return Private::CustomElementGlue::impl(GST_BASE_TRANSFORM(static_cast<GstElement*>(element)));
+    case Private::CustomElementKindSource:
+        return Private::CustomElementGlue::impl(GST_BASE_SRC(static_cast<GstElement*>(element)));
+    case Private::CustomElementKindSink:
+        return Private::CustomElementGlue::impl(GST_BASE_SINK(static_cast<GstElement*>(element)));
+    default:
+        return Private::CustomElementGlue::impl(static_cast<GstElement*>(element));
+    }
+}
+
+ElementPtr CustomElement::element() const
+{
+    return ElementPtr::wrap(m_element);
+}
+
+void CustomElement::initialize()
+{
+}
+
+PadPtr CustomElement::addPad(const char *templateName, const char *name)
+{
+    GstPadTemplate *padTemplate = gst_element_class_get_pad_template(
+            GST_ELEMENT_GET_CLASS(m_element), templateName);
+    if (!padTemplate) {
+        qWarning() << "QGst::CustomElement::addPad: There is no pad template called" << templateName;
+        return PadPtr();
+    }
+
+    GstPad *pad = gst_pad_new_from_template(padTemplate, name ? name : templateName);
+    if (GST_PAD_IS_SINK(pad)) {
+        gst_pad_set_chain_function_full(pad, &Private::CustomElementGlue::chain, this, NULL);
+    }
+    gst_pad_set_event_function_full(pad, &Private::CustomElementGlue::event, this, NULL);
+    gst_pad_set_query_function_full(pad, &Private::CustomElementGlue::query, this, NULL);
+
+    //the element takes the floating reference
+    PadPtr result = PadPtr::wrap(pad);
+    gst_element_add_pad(m_element, pad);
+    return result;
+}
+
+FlowReturn CustomElement::chain(Pad *pad, BufferPtr & buffer)
+{
+    Q_UNUSED(pad);
+    buffer.clear();
+    return FlowNotSupported;
+}
+
+bool CustomElement::event(Pad *pad, const EventPtr & event)
+{
+    return gst_pad_event_default(PadPtr(pad), GST_OBJECT(m_element), gst_event_ref(event));
+}
+
+bool CustomElement::query(Pad *pad, Query *query)
+{
+    return gst_pad_query_default(PadPtr(pad), GST_OBJECT(m_element), QueryPtr(query));
+}
+
+//END CustomElement
+
+//BEGIN CustomTransform
+
+bool CustomTransform::start()
+{
+    return true;
+}
+
+bool CustomTransform::stop()
+{
+    return true;
+}
+
+bool CustomTransform::setCaps(const CapsPtr & inCaps, const CapsPtr & outCaps)
+{
+    Q_UNUSED(inCaps);
+    Q_UNUSED(outCaps);
+    return true;
+}
+
+CapsPtr CustomTransform::transformCaps(PadDirection direction, const CapsPtr & caps,
+                                       const CapsPtr & filter)
+{
+    GstBaseTransformClass *parentClass =
+        GST_BASE_TRANSFORM_CLASS(g_type_class_peek(GST_TYPE_BASE_TRANSFORM));
+    return CapsPtr::wrap(parentClass->transform_caps(GST_BASE_TRANSFORM(static_cast<GstElement*>(element())),
+                                                     static_cast<GstPadDirection>(direction),
+                                                     caps, filter), false);
+}
+
+bool CustomTransform::transformSize(PadDirection direction, const CapsPtr & caps, size_t size,
+                                    const CapsPtr & otherCaps, size_t *otherSize)
+{
+    GstBaseTransformClass *parentClass =
+        GST_BASE_TRANSFORM_CLASS(g_type_class_peek(GST_TYPE_BASE_TRANSFORM));
+    gsize result = 0;
+    bool ok = parentClass->transform_size(GST_BASE_TRANSFORM(static_cast<GstElement*>(element())),
+                                          static_cast<GstPadDirection>(direction),
+                                          caps, size, otherCaps, &result);
+    *otherSize = result;
+    return ok;
+}
+
+void CustomTransform::setPassthrough(bool passthrough)
+{
+    gst_base_transform_set_passthrough(GST_BASE_TRANSFORM(static_cast<GstElement*>(element())), passthrough);
+}
+
+bool CustomTransform::isPassthrough() const
+{
+    return gst_base_transform_is_passthrough(GST_BASE_TRANSFORM(static_cast<GstElement*>(element())));
+}
+
+//END CustomTransform
+
+//BEGIN CustomSource
+
+bool CustomSource::start()
+{
+    return true;
+}
+
+bool CustomSource::stop()
+{
+    return true;
+}
+
+bool CustomSource::setCaps(const CapsPtr & caps)
+{
+    Q_UNUSED(caps);
+    return true;
+}
+
+bool CustomSource::isSeekable()
+{
+    return false;
+}
+
+void CustomSource::setLive(bool live)
+{
+    gst_base_src_set_live(GST_BASE_SRC(static_cast<GstElement*>(element())), live);
+}
+
+void CustomSource::setFormat(Format format)
+{
+    gst_base_src_set_format(GST_BASE_SRC(static_cast<GstElement*>(element())),
+                            static_cast<GstFormat>(format));
+}
+
+void CustomSource::setBlockSize(uint blockSize)
+{
+    gst_base_src_set_blocksize(GST_BASE_SRC(static_cast<GstElement*>(element())), blockSize);
+}
+
+//END CustomSource
+
+//BEGIN CustomSink
+
+bool CustomSink::start()
+{
+    return true;
+}
+
+bool CustomSink::stop()
+{
+    return true;
+}
+
+bool CustomSink::setCaps(const CapsPtr & caps)
+{
+    Q_UNUSED(caps);
+    return true;
+}
+
+FlowReturn CustomSink::preroll(Buffer *buffer)
+{
+    Q_UNUSED(buffer);
+    return FlowOk;
+}
+
+void CustomSink::setSync(bool sync)
+{
+    gst_base_sink_set_sync(GST_BASE_SINK(static_cast<GstElement*>(element())), sync);
+}
+
+//END CustomSink
+
+} //namespace QGst
@@ -0,0 +1,329 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef QGST_CUSTOMELEMENT_H
+#define QGST_CUSTOMELEMENT_H
+
+#include "element.h"
+#include "pad.h"
+#include "buffer.h"
+#include "event.h"
+#include "query.h"
+#include "caps.h"
+
+namespace QGst {
+
+namespace Private {
+    struct CustomElementGlue;
+}
+
+/*! \headerfile customelement.h <QGst/ElementClass>
+ * \brief The class of an element implemented in C++
+ *
+ * An ElementClass is passed to the static classInit() function of a CustomElement
+ * subclass when its GType is registered, to describe the element to GStreamer.
+ */
+class QTGSTREAMER_EXPORT ElementClass
+{
+public:
+    /*! Sets the metadata that gst-inspect and ElementFactory::metadata() show */
+    void setMetadata(const char *longName, const char *classification,
+                     const char *description, const char *author);
+
+    /*! Adds a pad template. The transforms, sources and sinks expect
+     * their templates to be called "sink" and "src". */
+    void addPadTemplate(const char *name, PadDirection direction,
+                        PadPresence presence, const CapsPtr & caps);
+
+private:
+    friend struct Private::CustomElementGlue;
+    explicit ElementClass(void *klass) : m_class(klass) {}
+    Q_DISABLE_COPY(ElementClass)
+
+    void *m_class;
+};
+
+/*! \headerfile customelement.h <QGst/CustomElement>
+ * \brief Base class for elements implemented in C++
+ *
+ * A subclass of CustomElement (or of one of CustomInPlaceTransform, CustomCopyTransform,
+ * CustomSource and CustomSink) is turned into a GstElement subtype with registerType()
+ * or StaticPlugin::addElement(). Every instance of that GstElement owns one instance of
+ * the C++ class, which is created with its default constructor and deleted together
+ * with the element.
+ *
+ * The subclass must have a static function that describes the element:
+ * \code
+ * class Counter : public QGst::CustomInPlaceTransform
+ * {
+ * public:
+ *     static void classInit(QGst::ElementClass & klass)
+ *     {
+ *         klass.setMetadata("Counter", "Filter", "Counts buffers", "Me");
+ *         klass.addPadTemplate("sink", QGst::PadSink, QGst::PadAlways, QGst::Caps::createAny());
+ *         klass.addPadTemplate("src", QGst::PadSrc, QGst::PadAlways, QGst::Caps::createAny());
+ *     }
+ *
+ * protected:
+ *     virtual QGst::FlowReturn transformInPlace(QGst::Buffer *buffer);
+ * };
+ * \endcode
+ *
+ * The virtual functions are called directly from the streaming threads of the element.
+ * The buffers that they receive as plain pointers are borrowed: no reference is taken,
+ * so they keep their writability, and the pointers are only valid during the call.
+ * Borrowing still creates the C++ wrapper of each new buffer, which costs a heap
+ * allocation per buffer on top of the virtual call.
+ *
+ * Plain CustomElement subclasses create their pads in initialize() with addPad(),
+ * which routes the data, events and queries of the pad to chain(), event() and query().
+ */
+class QTGSTREAMER_EXPORT CustomElement
+{
+public:
+    virtual ~CustomElement();
+
+    /*! Registers the GType of the element implemented by \a T, with the name
+     * "QGstCustom-" followed by \a elementName, and returns it. Registering
+     * the same name again returns the existing type. */
+    template <class T>
+    static QGlib::Type registerType(const char *elementName);
+
+    /*! Returns the CustomElement behind \a element, or NULL if \a element
+     * is not implemented in C++ */
+    static CustomElement *fromElement(const ElementPtr & element);
+
+    /*! Returns the GstElement that this object implements */
+    ElementPtr element() const;
+
+protected:
+    CustomElement();
+
+    /*! Called once the GstElement is constructed. Plain elements create
+     * their pads here. The default implementation does nothing. */
+    virtual void initialize();
+
+    /*! Creates a pad from the pad template called \a templateName, with the name
+     * \a name, or the name of the template if \a name is NULL, and adds it to the
+     * element. chain() is called for the buffers that arrive on sink pads, and
+     * event() and query() for the events and queries of all pads. */
+    PadPtr addPad(const char *templateName, const char *name = NULL);
+
+    /*! Called for every buffer that arrives on a sink pad created with addPad().
+     * The element owns \a buffer; pass it on with Pad::push(), which does not copy it.
+     * The default implementation drops the buffer and returns FlowNotSupported. */
+    virtual FlowReturn chain(Pad *pad, BufferPtr & buffer);
+    /*! Called for every event that arrives on a pad created with addPad(). The
+     * default implementation does what GStreamer does for elements that do not
+     * handle events; it forwards most events to all the pads of the other direction. */
+    virtual bool event(Pad *pad, const EventPtr & event);
+    /*! Called for every query that arrives on a pad created with addPad(). The
+     * default implementation forwards the query like GStreamer does by default. */
+    virtual bool query(Pad *pad, Query *query);
+
+private:
+    friend struct Private::CustomElementGlue;
+    Q_DISABLE_COPY(CustomElement)
+
+    GstElement *m_element;
+};
+
+/*! \headerfile customelement.h <QGst/CustomElement>
+ * \brief Common base of the transforms implemented in C++, on top of GstBaseTransform
+ *
+ * GstBaseTransform takes care of the pads, the caps negotiation, the allocation of
+ * output buffers and passthrough. Subclasses must add two "sink" and "src" pad templates
+ * and derive from either CustomInPlaceTransform or CustomCopyTransform.
+ */
+class QTGSTREAMER_EXPORT CustomTransform : public CustomElement
+{
+protected:
+    CustomTransform() {}
+
+    /*! Called when the element starts processing. The default implementation returns true. */
+    virtual bool start();
+    /*! Called when the element stops processing. The default implementation returns true. */
+    virtual bool stop();
+    /*! Called with the caps that were negotiated for the sink and the src pad.
+     * The default implementation returns true. */
+    virtual bool setCaps(const CapsPtr & inCaps, const CapsPtr & outCaps);
+    /*! Returns the caps that the pad of the other \a direction can have when the pad of
+     * \a direction has \a caps, intersected with \a filter if that is not null. The default
+     * implementation returns \a caps, for transforms that do not change the format. */
+    virtual CapsPtr transformCaps(PadDirection direction, const CapsPtr & caps, const CapsPtr & filter);
+    /*! Sets \a otherSize to the size of a buffer of the other \a direction when a buffer
+     * of \a direction with \a caps has \a size bytes. The default implementation
+     * sets it to \a size. */
+    virtual bool transformSize(PadDirection direction, const CapsPtr & caps, size_t size,
+                               const CapsPtr & otherCaps, size_t *otherSize);
+
+    /*! When enabled, buffers are pushed on unchanged, without calling the transform functions */
+    void setPassthrough(bool passthrough);
+    bool isPassthrough() const;
+
+private:
+    friend struct Private::CustomElementGlue;
+};
+
+/*! \headerfile customelement.h <QGst/CustomElement>
+ * \brief Base class for transforms that modify their buffers in place
+ */
+class QTGSTREAMER_EXPORT CustomInPlaceTransform : public CustomTransform
+{
+protected:
+    CustomInPlaceTransform() {}
+
+    /*! Modifies \a buffer. \a buffer is writable, unless the element is in passthrough mode. */
+    virtual FlowReturn transformInPlace(Buffer *buffer) = 0;
+
+private:
+    friend struct Private::CustomElementGlue;
+};
+
+/*! \headerfile customelement.h <QGst/CustomElement>
+ * \brief Base class for transforms that write their output to a new buffer
+ *
+ * The output buffers are allocated by GstBaseTransform, with the size that
+ * transformSize() returns, from the buffer pool or the allocator that
+ * downstream elements offer.
+ */
+class QTGSTREAMER_EXPORT CustomCopyTransform : public CustomTransform
+{
+protected:
+    CustomCopyTransform() {}
+
+    /*! Writes the result of transforming \a in into \a out */
+    virtual FlowReturn transform(Buffer *in, Buffer *out) = 0;
+
+private:
+    friend struct Private::CustomElementGlue;
+};
+
+/*! \headerfile customelement.h <QGst/CustomElement>
+ * \brief Base class for sources implemented in C++, on top of GstBaseSrc
+ *
+ * GstBaseSrc runs the streaming thread and allocates the buffers, so that subclasses
+ * only need to fill them. Subclasses must add a "src" pad template.
+ */
+class QTGSTREAMER_EXPORT CustomSource : public CustomElement
+{
+protected:
+    CustomSource() {}
+
+    /*! Called when the element starts producing data. The default implementation returns true. */
+    virtual bool start();
+    /*! Called when the element stops producing data. The default implementation returns true. */
+    virtual bool stop();
+    /*! Called with the caps that were negotiated. The default implementation returns true. */
+    virtual bool setCaps(const CapsPtr & caps);
+    /*! Returns whether the source can seek. The default implementation returns false. */
+    virtual bool isSeekable();
+
+    /*! Fills \a buffer, which holds \a size bytes, with the data at \a offset.
+     * \a offset and \a size are only meaningful in FormatBytes; otherwise \a size is the
+     * block size of the element. Return FlowEos when there is no more data. */
+    virtual FlowReturn fill(quint64 offset, uint size, Buffer *buffer) = 0;
+
+    /*! Makes this a live source, which only produces data in the playing state */
+    void setLive(bool live);
+    /*! Sets the format of the segments that the element outputs, FormatBytes by default */
+    void setFormat(Format format);
+    /*! Sets the size of the buffers that are passed to fill() */
+    void setBlockSize(uint blockSize);
+
+private:
+    friend struct Private::CustomElementGlue;
+};
+
+/*! \headerfile customelement.h <QGst/CustomElement>
+ * \brief Base class for sinks implemented in C++, on top of GstBaseSink
+ *
+ * GstBaseSink handles the preroll, the synchronization of buffers to the clock
+ * and the end of stream. Subclasses must add a "sink" pad template.
+ */
+class QTGSTREAMER_EXPORT CustomSink : public CustomElement
+{
+protected:
+    CustomSink() {}
+
+    /*! Called when the element starts consuming data. The default implementation returns true. */
+    virtual bool start();
+    /*! Called when the element stops consuming data. The default implementation returns true. */
+    virtual bool stop();
+    /*! Called with the caps that were negotiated. The default implementation returns true. */
+    virtual bool setCaps(const CapsPtr & caps);
+
+    /*! Called for every buffer, at the time it should be rendered if the sink is synchronized */
+    virtual FlowReturn render(Buffer *buffer) = 0;
+    /*! Called with the first buffer after each flush or state change to paused.
+     * The default implementation returns FlowOk. */
+    virtual FlowReturn preroll(Buffer *buffer);
+
+    /*! Selects whether buffers are rendered at the time of their timestamp (the default),
+     * or as fast as possible */
+    void setSync(bool sync);
+
+private:
+    friend struct Private::CustomElementGlue;
+};
+
+namespace Private {
+
+enum CustomElementKind {
+    CustomElementKindElement,
+    CustomElementKindInPlaceTransform,
+    CustomElementKindCopyTransform,
+    CustomElementKindSource,
+    CustomElementKindSink
+};
+
+typedef CustomElement *(*CustomElementCreateFunction)();
+typedef void (*CustomElementClassInitFunction)(ElementClass &);
+
+QTGSTREAMER_EXPORT QGlib::Type registerCustomElement(const char *elementName,
+                                                     CustomElementKind kind,
+                                                     CustomElementCreateFunction create,
+                                                     CustomElementClassInitFunction classInit);
+
+template <class T>
+CustomElement *createCustomElement()
+{
+    return new T;
+}
+
+//overload resolution picks the most derived base class of T
+inline CustomElementKind customElementKind(const CustomElement *) { return CustomElementKindElement; }
+//not defined; transforms must derive from CustomInPlaceTransform or CustomCopyTransform
+CustomElementKind customElementKind(const CustomTransform *);
+inline CustomElementKind customElementKind(const CustomInPlaceTransform *) { return CustomElementKindInPlaceTransform; }
+inline CustomElementKind customElementKind(const CustomCopyTransform *) { return CustomElementKindCopyTransform; }
+inline CustomElementKind customElementKind(const CustomSource *) { return CustomElementKindSource; }
+inline CustomElementKind customElementKind(const CustomSink *) { return CustomElementKindSink; }
+
+} //namespace Private
+
+//static
+template <class T>
+inline QGlib::Type CustomElement::registerType(const char *elementName)
+{
+    return Private::registerCustomElement(elementName,
+                                          Private::customElementKind(static_cast<const T*>(NULL)),
+                                          &Private::createCustomElement<T>, &T::classInit);
+}
+
+} //namespace QGst
+
+#endif
@@ -89,6 +89,15 @@ namespace QGst {
 }
 QGST_REGISTER_TYPE(QGst::PadDirection)
 
+namespace QGst {
+    enum PadPresence {
+        PadAlways,
+        PadSometimes,
+        PadRequest
+    };
+}
+QGST_REGISTER_TYPE(QGst::PadPresence)
+
 namespace QGst {
     enum PadFlag {
         PadFlagBlocked = (ObjectFlagLast << 0),
@@ -153,6 +162,46 @@ namespace QGst {
 }
 QGST_REGISTER_TYPE(QGst::PadMode)
 
+namespace QGst {
+    enum PadProbeType {
+        PadProbeTypeInvalid = 0,
+        PadProbeTypeIdle = (1 << 0),
+        PadProbeTypeBlock = (1 << 1),
+        PadProbeTypeBuffer = (1 << 4),
+        PadProbeTypeBufferList = (1 << 5),
+        PadProbeTypeEventDownstream = (1 << 6),
+        PadProbeTypeEventUpstream = (1 << 7),
+        PadProbeTypeEventFlush = (1 << 8),
+        PadProbeTypeQueryDownstream = (1 << 9),
+        PadProbeTypeQueryUpstream = (1 << 10),
+        PadProbeTypePush = (1 << 12),
+        PadProbeTypePull = (1 << 13),
+        PadProbeTypeBlocking = PadProbeTypeIdle | PadProbeTypeBlock,
+        PadProbeTypeDataDownstream = PadProbeTypeBuffer | PadProbeTypeBufferList | PadProbeTypeEventDownstream,
+        PadProbeTypeDataUpstream = PadProbeTypeEventUpstream,
+        PadProbeTypeDataBoth = PadProbeTypeDataDownstream | PadProbeTypeDataUpstream,
+        PadProbeTypeBlockDownstream = PadProbeTypeBlock | PadProbeTypeDataDownstream,
+        PadProbeTypeBlockUpstream = PadProbeTypeBlock | PadProbeTypeDataUpstream,
+        PadProbeTypeEventBoth = PadProbeTypeEventDownstream | PadProbeTypeEventUpstream,
+        PadProbeTypeQueryBoth = PadProbeTypeQueryDownstream | PadProbeTypeQueryUpstream,
+        PadProbeTypeAllBoth = PadProbeTypeDataBoth | PadProbeTypeQueryBoth,
+        PadProbeTypeScheduling = PadProbeTypePush | PadProbeTypePull
+    };
+    Q_DECLARE_FLAGS(PadProbeTypes, PadProbeType);
+}
+Q_DECLARE_OPERATORS_FOR_FLAGS(QGst::PadProbeTypes)
+QGST_REGISTER_TYPE(QGst::PadProbeTypes)
+
+namespace QGst {
+    enum PadProbeReturn {
+        PadProbeDrop,
+        PadProbeOk,
+        PadProbeRemove,
+        PadProbePass
+    };
+}
+QGST_REGISTER_TYPE(QGst::PadProbeReturn)
+
 
 namespace QGst {
     enum Rank {
@@ -195,9 +244,20 @@ namespace QGst {
         MessageQos             = (1 << 24),
         MessageAny             = ~0
     };
+    Q_DECLARE_FLAGS(MessageTypes, MessageType);
 }
+Q_DECLARE_OPERATORS_FOR_FLAGS(QGst::MessageTypes)
 QGST_REGISTER_TYPE(QGst::MessageType)
 
+namespace QGst {
+    enum BusSyncReply {
+        BusDrop,
+        BusPass,
+        BusAsync
+    };
+}
+QGST_REGISTER_TYPE(QGst::BusSyncReply)
+
 
 namespace QGst {
     enum ParseError {
@@ -516,4 +576,18 @@ namespace QGst {
 }
 Q_DECLARE_OPERATORS_FOR_FLAGS(QGst::MemoryFlags)
 QGST_REGISTER_TYPE(QGst::MemoryFlags)
+
+namespace QGst {
+    enum BufferPoolAcquireFlag {
+        //codegen: BufferPoolAcquireFlagDontWait=BUFFER_POOL_ACQUIRE_FLAG_DONTWAIT
+        BufferPoolAcquireFlagNone = 0,
+        BufferPoolAcquireFlagKeyUnit = (1 << 0),
+        BufferPoolAcquireFlagDontWait = (1 << 1),
+        BufferPoolAcquireFlagDiscont = (1 << 2),
+        BufferPoolAcquireFlagLast = (1 << 16)
+    };
+    Q_DECLARE_FLAGS(BufferPoolAcquireFlags, BufferPoolAcquireFlag);
+}
+Q_DECLARE_OPERATORS_FOR_FLAGS(QGst::BufferPoolAcquireFlags)
+QGST_REGISTER_TYPE(QGst::BufferPoolAcquireFlags)
 #endif
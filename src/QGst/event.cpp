@@ -125,7 +125,8 @@ Segment SegmentEvent::segment() const
 //********************************************************
 TagEventPtr TagEvent::create(const TagList & taglist)
 {
-    GstEvent * e = gst_event_new_tag(gst_tag_list_copy(taglist));
+    GstEvent * e = gst_event_new_tag(gst_tag_list_ref(
+            const_cast<GstTagList*>(static_cast<const GstTagList*>(taglist))));
     return TagEventPtr::wrap(e, false);
 }
 
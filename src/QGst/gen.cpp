@@ -33,6 +33,7 @@
 #include <gst/video/videooverlay.h>
 #include <gst/video/colorbalance.h>
 #include <gst/video/videoorientation.h>
+#include <gst/video/gstvideopool.h>
 #include <gst/app/gstappsrc.h>
 #include <gst/pbutils/gstdiscoverer.h>
 #include <gst/pbutils/pbutils-enumtypes.h>
@@ -203,6 +204,9 @@ namespace QGst {
     case QGst::QueryUri:
       cppClass = new QGst::UriQuery;
       break;
+    case QGst::QueryAllocation:
+      cppClass = new QGst::AllocationQuery;
+      break;
     default:
       cppClass = new QGst::Query;
       break;
@@ -367,6 +371,30 @@ namespace QGst {
   }
 } //namespace QGst
 
+#include "QGst/bufferpool.h"
+
+REGISTER_TYPE_IMPLEMENTATION(QGst::BufferPool,GST_TYPE_BUFFER_POOL)
+
+REGISTER_TYPE_IMPLEMENTATION(QGst::VideoBufferPool,GST_TYPE_VIDEO_BUFFER_POOL)
+
+namespace QGst {
+  QGlib::RefCountedObject *BufferPool_new(void *instance)
+  {
+    QGst::BufferPool *cppClass = new QGst::BufferPool;
+    cppClass->m_object = instance;
+    return cppClass;
+  }
+} //namespace QGst
+
+namespace QGst {
+  QGlib::RefCountedObject *VideoBufferPool_new(void *instance)
+  {
+    QGst::VideoBufferPool *cppClass = new QGst::VideoBufferPool;
+    cppClass->m_object = instance;
+    return cppClass;
+  }
+} //namespace QGst
+
 #include "QGst/clocktime.h"
 
 REGISTER_TYPE_IMPLEMENTATION(QGst::ClockTime,GST_TYPE_CLOCK_TIME)
@@ -490,6 +518,8 @@ REGISTER_TYPE_IMPLEMENTATION(QGst::StateChangeReturn,GST_TYPE_STATE_CHANGE_RETUR
 
 REGISTER_TYPE_IMPLEMENTATION(QGst::PadDirection,GST_TYPE_PAD_DIRECTION)
 
+REGISTER_TYPE_IMPLEMENTATION(QGst::PadPresence,GST_TYPE_PAD_PRESENCE)
+
 REGISTER_TYPE_IMPLEMENTATION(QGst::PadFlags,GST_TYPE_PAD_FLAGS)
 
 REGISTER_TYPE_IMPLEMENTATION(QGst::PadLinkReturn,GST_TYPE_PAD_LINK_RETURN)
@@ -498,10 +528,16 @@ REGISTER_TYPE_IMPLEMENTATION(QGst::FlowReturn,GST_TYPE_FLOW_RETURN)
 
 REGISTER_TYPE_IMPLEMENTATION(QGst::PadMode,GST_TYPE_PAD_MODE)
 
+REGISTER_TYPE_IMPLEMENTATION(QGst::PadProbeTypes,GST_TYPE_PAD_PROBE_TYPE)
+
+REGISTER_TYPE_IMPLEMENTATION(QGst::PadProbeReturn,GST_TYPE_PAD_PROBE_RETURN)
+
 REGISTER_TYPE_IMPLEMENTATION(QGst::Rank,GST_TYPE_RANK)
 
 REGISTER_TYPE_IMPLEMENTATION(QGst::MessageType,GST_TYPE_MESSAGE_TYPE)
 
+REGISTER_TYPE_IMPLEMENTATION(QGst::BusSyncReply,GST_TYPE_BUS_SYNC_REPLY)
+
 REGISTER_TYPE_IMPLEMENTATION(QGst::ParseError,GST_TYPE_PARSE_ERROR)
 
 REGISTER_TYPE_IMPLEMENTATION(QGst::UriType,GST_TYPE_URI_TYPE)
@@ -542,6 +578,8 @@ REGISTER_TYPE_IMPLEMENTATION(QGst::MapFlags,GST_TYPE_MAP_FLAGS)
 
 REGISTER_TYPE_IMPLEMENTATION(QGst::MemoryFlags,GST_TYPE_MEMORY_FLAGS)
 
+REGISTER_TYPE_IMPLEMENTATION(QGst::BufferPoolAcquireFlags,GST_TYPE_BUFFER_POOL_ACQUIRE_FLAGS)
+
 namespace QGst {
     BOOST_STATIC_ASSERT(static_cast<int>(MiniObjectFlagLockable) == static_cast<int>(GST_MINI_OBJECT_FLAG_LOCKABLE));
     BOOST_STATIC_ASSERT(static_cast<int>(MiniObjectFlagLockReadonly) == static_cast<int>(GST_MINI_OBJECT_FLAG_LOCK_READONLY));
@@ -582,6 +620,12 @@ namespace QGst {
     BOOST_STATIC_ASSERT(static_cast<int>(PadSink) == static_cast<int>(GST_PAD_SINK));
 }
 
+namespace QGst {
+    BOOST_STATIC_ASSERT(static_cast<int>(PadAlways) == static_cast<int>(GST_PAD_ALWAYS));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadSometimes) == static_cast<int>(GST_PAD_SOMETIMES));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadRequest) == static_cast<int>(GST_PAD_REQUEST));
+}
+
 namespace QGst {
     BOOST_STATIC_ASSERT(static_cast<int>(PadFlagBlocked) == static_cast<int>(GST_PAD_FLAG_BLOCKED));
     BOOST_STATIC_ASSERT(static_cast<int>(PadFlagFlushing) == static_cast<int>(GST_PAD_FLAG_FLUSHING));
@@ -629,6 +673,38 @@ namespace QGst {
     BOOST_STATIC_ASSERT(static_cast<int>(PadModePull) == static_cast<int>(GST_PAD_MODE_PULL));
 }
 
+namespace QGst {
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeInvalid) == static_cast<int>(GST_PAD_PROBE_TYPE_INVALID));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeIdle) == static_cast<int>(GST_PAD_PROBE_TYPE_IDLE));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeBlock) == static_cast<int>(GST_PAD_PROBE_TYPE_BLOCK));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeBuffer) == static_cast<int>(GST_PAD_PROBE_TYPE_BUFFER));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeBufferList) == static_cast<int>(GST_PAD_PROBE_TYPE_BUFFER_LIST));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeEventDownstream) == static_cast<int>(GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeEventUpstream) == static_cast<int>(GST_PAD_PROBE_TYPE_EVENT_UPSTREAM));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeEventFlush) == static_cast<int>(GST_PAD_PROBE_TYPE_EVENT_FLUSH));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeQueryDownstream) == static_cast<int>(GST_PAD_PROBE_TYPE_QUERY_DOWNSTREAM));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeQueryUpstream) == static_cast<int>(GST_PAD_PROBE_TYPE_QUERY_UPSTREAM));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypePush) == static_cast<int>(GST_PAD_PROBE_TYPE_PUSH));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypePull) == static_cast<int>(GST_PAD_PROBE_TYPE_PULL));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeBlocking) == static_cast<int>(GST_PAD_PROBE_TYPE_BLOCKING));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeDataDownstream) == static_cast<int>(GST_PAD_PROBE_TYPE_DATA_DOWNSTREAM));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeDataUpstream) == static_cast<int>(GST_PAD_PROBE_TYPE_DATA_UPSTREAM));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeDataBoth) == static_cast<int>(GST_PAD_PROBE_TYPE_DATA_BOTH));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeBlockDownstream) == static_cast<int>(GST_PAD_PROBE_TYPE_BLOCK_DOWNSTREAM));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeBlockUpstream) == static_cast<int>(GST_PAD_PROBE_TYPE_BLOCK_UPSTREAM));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeEventBoth) == static_cast<int>(GST_PAD_PROBE_TYPE_EVENT_BOTH));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeQueryBoth) == static_cast<int>(GST_PAD_PROBE_TYPE_QUERY_BOTH));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeAllBoth) == static_cast<int>(GST_PAD_PROBE_TYPE_ALL_BOTH));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeTypeScheduling) == static_cast<int>(GST_PAD_PROBE_TYPE_SCHEDULING));
+}
+
+namespace QGst {
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeDrop) == static_cast<int>(GST_PAD_PROBE_DROP));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeOk) == static_cast<int>(GST_PAD_PROBE_OK));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbeRemove) == static_cast<int>(GST_PAD_PROBE_REMOVE));
+    BOOST_STATIC_ASSERT(static_cast<int>(PadProbePass) == static_cast<int>(GST_PAD_PROBE_PASS));
+}
+
 namespace QGst {
     BOOST_STATIC_ASSERT(static_cast<int>(RankNone) == static_cast<int>(GST_RANK_NONE));
     BOOST_STATIC_ASSERT(static_cast<int>(RankMarginal) == static_cast<int>(GST_RANK_MARGINAL));
@@ -666,6 +742,12 @@ namespace QGst {
     BOOST_STATIC_ASSERT(static_cast<int>(MessageAny) == static_cast<int>(GST_MESSAGE_ANY));
 }
 
+namespace QGst {
+    BOOST_STATIC_ASSERT(static_cast<int>(BusDrop) == static_cast<int>(GST_BUS_DROP));
+    BOOST_STATIC_ASSERT(static_cast<int>(BusPass) == static_cast<int>(GST_BUS_PASS));
+    BOOST_STATIC_ASSERT(static_cast<int>(BusAsync) == static_cast<int>(GST_BUS_ASYNC));
+}
+
 namespace QGst {
     BOOST_STATIC_ASSERT(static_cast<int>(ParseErrorSyntax) == static_cast<int>(GST_PARSE_ERROR_SYNTAX));
     BOOST_STATIC_ASSERT(static_cast<int>(ParseErrorNoSuchElement) == static_cast<int>(GST_PARSE_ERROR_NO_SUCH_ELEMENT));
@@ -878,6 +960,14 @@ namespace QGst {
     BOOST_STATIC_ASSERT(static_cast<int>(MemoryFlagLast) == static_cast<int>(GST_MEMORY_FLAG_LAST));
 }
 
+namespace QGst {
+    BOOST_STATIC_ASSERT(static_cast<int>(BufferPoolAcquireFlagNone) == static_cast<int>(GST_BUFFER_POOL_ACQUIRE_FLAG_NONE));
+    BOOST_STATIC_ASSERT(static_cast<int>(BufferPoolAcquireFlagKeyUnit) == static_cast<int>(GST_BUFFER_POOL_ACQUIRE_FLAG_KEY_UNIT));
+    BOOST_STATIC_ASSERT(static_cast<int>(BufferPoolAcquireFlagDontWait) == static_cast<int>(GST_BUFFER_POOL_ACQUIRE_FLAG_DONTWAIT));
+    BOOST_STATIC_ASSERT(static_cast<int>(BufferPoolAcquireFlagDiscont) == static_cast<int>(GST_BUFFER_POOL_ACQUIRE_FLAG_DISCONT));
+    BOOST_STATIC_ASSERT(static_cast<int>(BufferPoolAcquireFlagLast) == static_cast<int>(GST_BUFFER_POOL_ACQUIRE_FLAG_LAST));
+}
+
 #include "QGst/parse.h"
 
 #include "QGst/colorbalance.h"
@@ -1047,6 +1137,8 @@ namespace Private {
     QGlib::GetType<Memory>().setQuarkData(q, reinterpret_cast<void*>(&Memory_new));
     QGlib::GetType<Element>().setQuarkData(q, reinterpret_cast<void*>(&Element_new));
     QGlib::GetType<Allocator>().setQuarkData(q, reinterpret_cast<void*>(&Allocator_new));
+    QGlib::GetType<BufferPool>().setQuarkData(q, reinterpret_cast<void*>(&BufferPool_new));
+    QGlib::GetType<VideoBufferPool>().setQuarkData(q, reinterpret_cast<void*>(&VideoBufferPool_new));
     QGlib::GetType<PluginFeature>().setQuarkData(q, reinterpret_cast<void*>(&PluginFeature_new));
     QGlib::GetType<DiscovererStreamInfo>().setQuarkData(q, reinterpret_cast<void*>(&DiscovererStreamInfo_new));
     QGlib::GetType<DiscovererContainerInfo>().setQuarkData(q, reinterpret_cast<void*>(&DiscovererContainerInfo_new));
@@ -119,7 +119,10 @@ QGST_WRAPPER_REFPOINTER_DECLARATION(ConvertQuery)
 QGST_WRAPPER_REFPOINTER_DECLARATION(FormatsQuery)
 QGST_WRAPPER_REFPOINTER_DECLARATION(BufferingQuery)
 QGST_WRAPPER_REFPOINTER_DECLARATION(UriQuery)
+QGST_WRAPPER_REFPOINTER_DECLARATION(AllocationQuery)
 QGST_WRAPPER_DECLARATION(Buffer)
+QGST_WRAPPER_DECLARATION(BufferPool)
+QGST_WRAPPER_DECLARATION(VideoBufferPool)
 QGST_WRAPPER_DECLARATION(Allocator)
 QGST_WRAPPER_DECLARATION(Memory)
 QGST_WRAPPER_DECLARATION(BufferList)
@@ -149,6 +152,7 @@ namespace QGst {
     typedef QSharedPointer<SharedStructure> StructurePtr;
     typedef QSharedPointer<const SharedStructure> StructureConstPtr;
     class AllocationParams;
+    class BufferPoolConfig;
     class MapInfo;
     class Segment;
 }
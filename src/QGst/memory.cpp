@@ -18,6 +18,19 @@
 #include "memory.h"
 #include "buffer.h"
 #include <gst/gst.h>
+#ifndef QTGSTREAMER_NO_ALLOCATORS
+# include <gst/allocators/allocators.h>
+#endif
+
+#ifdef Q_OS_UNIX
+# include <unistd.h>
+#endif
+#ifdef Q_OS_LINUX
+# include <sys/syscall.h>
+# ifndef MFD_CLOEXEC
+#  define MFD_CLOEXEC 0x0001U
+# endif
+#endif
 
 namespace QGst {
 
@@ -53,6 +66,110 @@ size_t MapInfo::maxSize() const
 
 //-----------------------
 
+static void deleteByteArray(void *data)
+{
+    delete static_cast<QByteArray*>(data);
+}
+
+//static
+MemoryPtr Memory::wrap(void *data, size_t size, MemoryFlags flags,
+                       DestroyNotify notify, void *userData)
+{
+    GstMemory *memory = gst_memory_new_wrapped(
+            static_cast<GstMemoryFlags>(static_cast<unsigned int>(flags)),
+            data, size, 0, size, userData, notify);
+    return MemoryPtr::wrap(memory, false);
+}
+
+//static
+MemoryPtr Memory::fromData(const QByteArray & data)
+{
+    //the copy shares the data of the original and keeps it alive
+    QByteArray *copy = new QByteArray(data);
+    return wrap(const_cast<char*>(copy->constData()), copy->size(),
+                MemoryFlagReadonly, &deleteByteArray, copy);
+}
+
+#ifndef QTGSTREAMER_NO_ALLOCATORS
+static GstAllocator *fdAllocator()
+{
+    static volatile gsize allocator = 0;
+    if (g_once_init_enter(&allocator)) {
+        //the allocator lives as long as the process, like the ones of gst_allocator_find()
+#if GST_CHECK_VERSION(1, 6, 0)
+        GstAllocator *a = gst_fd_allocator_new();
+#else
+        GstAllocator *a = gst_dmabuf_allocator_new();
+#endif
+        g_once_init_leave(&allocator, reinterpret_cast<gsize>(a));
+    }
+    return reinterpret_cast<GstAllocator*>(allocator);
+}
+#endif //QTGSTREAMER_NO_ALLOCATORS
+
+//static
+MemoryPtr Memory::fromFd(int fd, size_t size, bool closeFd)
+{
+#if defined(QTGSTREAMER_NO_ALLOCATORS)
+    //built without the gstreamer-allocators library
+    Q_UNUSED(size);
+# ifdef Q_OS_UNIX
+    if (closeFd) {
+        close(fd);
+    }
+# else
+    Q_UNUSED(fd);
+    Q_UNUSED(closeFd);
+# endif
+    return MemoryPtr();
+#elif GST_CHECK_VERSION(1, 10, 0)
+    //keep the mapping between map() calls; fd memory is typically mapped once per frame
+    int flags = GST_FD_MEMORY_FLAG_KEEP_MAPPED;
+    if (!closeFd) {
+        flags |= GST_FD_MEMORY_FLAG_DONT_CLOSE;
+    }
+    GstMemory *memory = gst_fd_allocator_alloc(fdAllocator(), fd, size,
+                                               static_cast<GstFdMemoryFlags>(flags));
+    return MemoryPtr::wrap(memory, false);
+#else
+    //without GST_FD_MEMORY_FLAG_DONT_CLOSE the allocator always takes
+    //ownership of the descriptor, so it gets a duplicate instead
+    if (!closeFd) {
+        fd = dup(fd);
+        if (fd < 0) {
+            return MemoryPtr();
+        }
+    }
+# if GST_CHECK_VERSION(1, 6, 0)
+    GstMemory *memory = gst_fd_allocator_alloc(fdAllocator(), fd, size,
+                                               GST_FD_MEMORY_FLAG_KEEP_MAPPED);
+# else
+    GstMemory *memory = gst_dmabuf_allocator_alloc(fdAllocator(), fd, size);
+# endif
+    return MemoryPtr::wrap(memory, false);
+#endif
+}
+
+//static
+MemoryPtr Memory::createMemfd(size_t size, const char *name)
+{
+#if defined(Q_OS_LINUX) && defined(SYS_memfd_create)
+    int fd = syscall(SYS_memfd_create, name, MFD_CLOEXEC);
+    if (fd < 0) {
+        return MemoryPtr();
+    }
+    if (ftruncate(fd, size) < 0) {
+        close(fd);
+        return MemoryPtr();
+    }
+    return fromFd(fd, size);
+#else
+    Q_UNUSED(size);
+    Q_UNUSED(name);
+    return MemoryPtr();
+#endif
+}
+
 AllocatorPtr Memory::allocator() const
 {
     return AllocatorPtr::wrap(object<GstMemory>()->allocator);
@@ -78,6 +195,31 @@ bool Memory::isType(const char *type) const
     return gst_memory_is_type(object<GstMemory>(), type);
 }
 
+bool Memory::isFdMemory() const
+{
+#if defined(QTGSTREAMER_NO_ALLOCATORS)
+    return false;
+#elif GST_CHECK_VERSION(1, 6, 0)
+    return gst_is_fd_memory(object<GstMemory>());
+#else
+    return gst_is_dmabuf_memory(object<GstMemory>());
+#endif
+}
+
+int Memory::fd() const
+{
+    if (!isFdMemory()) {
+        return -1;
+    }
+#if defined(QTGSTREAMER_NO_ALLOCATORS)
+    return -1;
+#elif GST_CHECK_VERSION(1, 6, 0)
+    return gst_fd_memory_get_fd(object<GstMemory>());
+#else
+    return gst_dmabuf_memory_get_fd(object<GstMemory>());
+#endif
+}
+
 bool Memory::map(MapInfo &info, MapFlags flags)
 {
     return gst_memory_map(object<GstMemory>(), static_cast<GstMapInfo*>(info.m_object),
@@ -19,6 +19,7 @@
 
 #include "global.h"
 #include "miniobject.h"
+#include <QtCore/QByteArray>
 
 namespace QGst {
 
@@ -52,6 +53,32 @@ class QTGSTREAMER_EXPORT Memory : public MiniObject
 {
     QGST_WRAPPER(Memory)
 public:
+    /*! Function that is called to release data that was wrapped with wrap() */
+    typedef void (*DestroyNotify)(void *userData);
+
+    /*! Creates a Memory that uses the \a size bytes at \a data without copying them.
+     * \a notify is called with \a userData when GStreamer no longer uses the memory.
+     * Pass MemoryFlagReadonly in \a flags if the data must not be modified;
+     * GStreamer will then copy the data instead of writing to it. */
+    static MemoryPtr wrap(void *data, size_t size, MemoryFlags flags = MemoryFlags(),
+                          DestroyNotify notify = NULL, void *userData = NULL);
+    /*! Creates a read-only Memory that shares the data of \a data without copying it.
+     * The data is kept alive until GStreamer releases the memory. */
+    static MemoryPtr fromData(const QByteArray & data);
+
+    /*! Creates a Memory that maps the first \a size bytes of the file descriptor \a fd.
+     * The descriptor is closed together with the memory, unless \a closeFd is false.
+     * Memory created this way can be handed to another process by passing
+     * the descriptor, see fd() and offset(). With GStreamer older than 1.10 the memory
+     * uses a duplicate of \a fd when \a closeFd is false. Returns a null pointer if
+     * QtGStreamer was built without the gstreamer-allocators library. */
+    static MemoryPtr fromFd(int fd, size_t size, bool closeFd = true);
+    /*! Creates a Memory of \a size bytes backed by an anonymous memfd, which can
+     * be shared with other processes without copying. \a name only appears
+     * in /proc for debugging. Returns a null pointer if memfd is not available,
+     * which is the case on systems other than Linux. */
+    static MemoryPtr createMemfd(size_t size, const char *name = "qtgstreamer");
+
     QGst::AllocatorPtr allocator() const;
 
     size_t size() const;
@@ -60,6 +87,14 @@ public:
 
     bool isType(const char *type) const;
 
+    /*! Returns true if this memory maps a file descriptor, as the memory
+     * created by fromFd() and createMemfd() does. */
+    bool isFdMemory() const;
+    /*! Returns the file descriptor of fd memory, or -1 for other memory. The data of this
+     * memory starts offset() bytes into the descriptor. The descriptor belongs to the
+     * memory and must not be closed. */
+    int fd() const;
+
     bool map(MapInfo &info, MapFlags flags);
     void unmap(MapInfo &info);
 };
@@ -157,7 +157,8 @@ QString InfoMessage::debugMessage() const
 
 TagMessagePtr TagMessage::create(const ObjectPtr & source, const TagList & taglist)
 {
-    GstMessage *m = gst_message_new_tag(source, gst_tag_list_copy(taglist));
+    GstMessage *m = gst_message_new_tag(source, gst_tag_list_ref(
+            const_cast<GstTagList*>(static_cast<const GstTagList*>(taglist))));
     return TagMessagePtr::wrap(m, false);
 }
 
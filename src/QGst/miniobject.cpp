@@ -36,14 +36,19 @@ void MiniObject::ref(bool increaseRef)
         if (increaseRef) {
             gst_mini_object_ref(GST_MINI_OBJECT(m_object));
         }
+    } else if (!increaseRef) {
+        //this wrapper is shared and already holds a reference
+        //on the native object, so drop the one passed to us
+        gst_mini_object_unref(GST_MINI_OBJECT(m_object));
     }
 }
 
 void MiniObject::unref()
 {
     if (Private::ObjectStore::take(this)) {
+        //this may finalize the native object, which deletes this wrapper
+        //from the weak reference notify set in wrapMiniObject()
         gst_mini_object_unref(GST_MINI_OBJECT(m_object));
-        delete this;
     }
 }
 
@@ -51,9 +56,9 @@ MiniObjectPtr MiniObject::makeWritable() const
 {
     /*
      * Calling gst_*_make_writable() below is tempting but wrong.
-     * Since MiniObjects and Caps do not share the same C++ instance in various wrappings, calling
-     * gst_*_make_writable() on an already writable object and wrapping the result is wrong,
-     * since it would just return the same pointer and we would wrap it in a new C++ instance.
+     * The C++ instance is shared by all the RefPointers that wrap the same native object and
+     * it holds a single reference on it. gst_*_make_writable() steals a reference from the
+     * original object when it makes a copy, which would drop the reference of the wrapper.
      */
     if (!isWritable()) {
         return copy();
@@ -65,9 +70,29 @@ MiniObjectPtr MiniObject::makeWritable() const
 
 namespace Private {
 
+static void miniObjectWeakNotify(void *cppInstance, GstMiniObject *object)
+{
+    ObjectStore::removeWrapper(object);
+    delete static_cast<QGlib::RefCountedObject*>(cppInstance);
+}
+
+static QGlib::RefCountedObject *createMiniObjectWrapper(void *miniObject)
+{
+    QGlib::RefCountedObject *cppClass =
+        QGlib::constructWrapper(GST_MINI_OBJECT_TYPE(miniObject), miniObject);
+    gst_mini_object_weak_ref(GST_MINI_OBJECT(miniObject), &miniObjectWeakNotify, cppClass);
+    return cppClass;
+}
+
 QGlib::RefCountedObject *wrapMiniObject(void *miniObject)
 {
-    return QGlib::constructWrapper(GST_MINI_OBJECT_TYPE(miniObject), miniObject);
+    //The wrapper lives as long as the native object does, like the wrappers of GObjects.
+    //It is looked up in the sharded ObjectStore rather than in the qdata of the object,
+    //as gst_mini_object_get_qdata() takes a single process-wide lock. The weak reference
+    //only touches that lock when the wrapper is created and when the object is finalized.
+    //The caller holds a reference on the native object, so the wrapper cannot be deleted
+    //while we are using it.
+    return ObjectStore::wrapper(miniObject, &createMiniObjectWrapper);
 }
 
 } //namespace Private
@@ -18,16 +18,41 @@
 
 #include <QtCore/QMutex>
 #include <QtCore/QHash>
-#include <QtCore/QAtomicInt>
 
 #include "objectstore_p.h"
 
 namespace {
+    /* The store is split in a number of independently locked shards, selected
+     * by the address of the wrapper, so that threads that ref/unref different
+     * wrappers do not serialize on a single mutex. Each shard is padded to its
+     * own cache line to avoid false sharing between neighbouring mutexes.
+     *
+     * The shards also map native mini objects to their wrappers. These entries
+     * are selected by the address of the native object instead.
+     */
+    enum { ShardCount = 64 }; //must be a power of two
+
+    struct Shard
+    {
+        QMutex mutex;
+        QHash<const void *, int> refCount;
+        QHash<const void *, QGlib::RefCountedObject *> wrappers;
+        char padding[64 - sizeof(QMutex) - sizeof(QHash<const void *, int>)
+                        - sizeof(QHash<const void *, QGlib::RefCountedObject *>)];
+    };
+
     class GlobalStore
     {
     public:
-        QMutex mutex;
-        QHash<const void *, QAtomicInt> refCount;
+        inline Shard & shardFor(const void *ptr)
+        {
+            //wrappers are heap allocated, so the lowest bits carry no information
+            quintptr p = reinterpret_cast<quintptr>(ptr);
+            p ^= p >> 12;
+            return shards[(p >> 4) & (ShardCount - 1)];
+        }
+
+        Shard shards[ShardCount];
     };
 }
 
@@ -38,48 +63,64 @@ namespace Private {
 
 bool ObjectStore::put(const void * ptr)
 {
-    bool mustAddStrongRef = false;
     GlobalStore *const gs = globalStore();
-    if (!gs) return mustAddStrongRef;
+    if (!gs) return false;
 
-    QMutexLocker lock(&gs->mutex);
-    if (!gs->refCount.contains(ptr)) {
-        gs->refCount.insert(ptr, QAtomicInt(0));
-        mustAddStrongRef = true;
-    }
-    (gs->refCount[ptr]).ref();
+    Shard & shard = gs->shardFor(ptr);
+    QMutexLocker lock(&shard.mutex);
 
-    return mustAddStrongRef;
+    //returns true if this is the first reference that the bindings hold
+    return ++shard.refCount[ptr] == 1;
 }
 
 bool ObjectStore::take(const void * ptr)
 {
-    bool mustSubtractStrongRef = false;
     GlobalStore *const gs = globalStore();
-    if (!gs) return mustSubtractStrongRef;
+    if (!gs) return false;
 
-    QMutexLocker lock(&gs->mutex);
+    Shard & shard = gs->shardFor(ptr);
+    QMutexLocker lock(&shard.mutex);
+
+    QHash<const void *, int>::iterator it = shard.refCount.find(ptr);
 
     //Make sure there are no extra unrefs()
-    Q_ASSERT(gs->refCount.contains(ptr));
+    Q_ASSERT(it != shard.refCount.end());
 
-    if (!gs->refCount.contains(ptr)) {
+    if (it == shard.refCount.end()) {
         return false;
     }
 
     //Decrease our bindings (weak) reference count
-    (gs->refCount[ptr]).deref();
-
-#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
-    if (!gs->refCount[ptr].load()) {
-#else
-    if (!gs->refCount[ptr]) {
-#endif
-        //refCount is 0
-        gs->refCount.remove(ptr);
-        mustSubtractStrongRef = true;
+    if (--it.value() == 0) {
+        shard.refCount.erase(it);
+        return true;
     }
-    return mustSubtractStrongRef;
+    return false;
+}
+
+QGlib::RefCountedObject *ObjectStore::wrapper(void *object, WrapperFactory factory)
+{
+    GlobalStore *const gs = globalStore();
+    if (!gs) return factory(object);
+
+    Shard & shard = gs->shardFor(object);
+    QMutexLocker lock(&shard.mutex);
+
+    QGlib::RefCountedObject *& cppClass = shard.wrappers[object];
+    if (!cppClass) {
+        cppClass = factory(object);
+    }
+    return cppClass;
+}
+
+void ObjectStore::removeWrapper(const void *object)
+{
+    GlobalStore *const gs = globalStore();
+    if (!gs) return;
+
+    Shard & shard = gs->shardFor(object);
+    QMutexLocker lock(&shard.mutex);
+    shard.wrappers.remove(object);
 }
 
 bool ObjectStore::isEmpty()
@@ -87,10 +128,11 @@ bool ObjectStore::isEmpty()
     GlobalStore *const gs = globalStore();
     if (!gs) return true;
 
-    QMutexLocker lock(&gs->mutex);
-
-    if (gs->refCount.count()>0) {
-        return false;
+    for (int i = 0; i < ShardCount; ++i) {
+        QMutexLocker lock(&gs->shards[i].mutex);
+        if (!gs->shards[i].refCount.isEmpty()) {
+            return false;
+        }
     }
 
     return true;
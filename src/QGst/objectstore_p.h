@@ -21,6 +21,10 @@
 /* WARNING: This header should only be included from
  * QtGStreamer source files and should not be installed */
 
+namespace QGlib {
+class RefCountedObject;
+}
+
 namespace QGst {
 namespace Private {
 
@@ -30,6 +34,15 @@ public:
     static bool put(const void * ptr);
     static bool take(const void * ptr);
     static bool isEmpty();
+
+    typedef QGlib::RefCountedObject *(*WrapperFactory)(void *object);
+
+    /* Returns the wrapper of the native \a object, calling \a factory
+     * to create it if there is none yet. The factory runs with the
+     * shard of \a object locked, so it is called at most once per object
+     * until removeWrapper() is called for it. */
+    static QGlib::RefCountedObject *wrapper(void *object, WrapperFactory factory);
+    static void removeWrapper(const void *object);
 };
 
 }
@@ -19,6 +19,9 @@
 #include "element.h"
 #include "query.h"
 #include "event.h"
+#include "buffer.h"
+#include "bufferlist.h"
+#include "borrow_p.h"
 #include <QtCore/QDebug>
 #include <gst/gst.h>
 
@@ -114,4 +117,203 @@ bool Pad::sendEvent(const EventPtr &event)
     return gst_pad_send_event(object<GstPad>(), event);
 }
 
+FlowReturn Pad::push(BufferPtr & buffer)
+{
+    if (buffer.isNull()) {
+        qWarning() << "QGst::Pad::push: Cannot push a null buffer";
+        return FlowError;
+    }
+
+    GstBuffer *buf = buffer;
+    gst_buffer_ref(buf);
+    buffer.clear();
+    return static_cast<FlowReturn>(gst_pad_push(object<GstPad>(), buf));
+}
+
+bool Pad::pushEvent(const EventPtr & event)
+{
+    return gst_pad_push_event(object<GstPad>(), gst_event_ref(event));
+}
+
+//********************************************************
+
+static inline GstPadProbeInfo *probeInfo(void *info)
+{
+    return static_cast<GstPadProbeInfo*>(info);
+}
+
+namespace {
+
+//the wrappers behind the views of a PadProbeInfo, on the stack of the trampoline
+struct PadProbeViews
+{
+    Private::StackWrapper<Buffer> buffer;
+    Private::StackWrapper<BufferList> bufferList;
+    Private::StackWrapper<Event> event;
+    Private::StackWrapper<Query> query;
+};
+
+inline PadProbeViews *probeViews(void *views)
+{
+    return static_cast<PadProbeViews*>(views);
+}
+
+}
+
+PadProbeTypes PadProbeInfo::type() const
+{
+    return static_cast<PadProbeType>(static_cast<int>(GST_PAD_PROBE_INFO_TYPE(probeInfo(m_info))));
+}
+
+ulong PadProbeInfo::id() const
+{
+    return GST_PAD_PROBE_INFO_ID(probeInfo(m_info));
+}
+
+Pad *PadProbeInfo::pad() const
+{
+    return Private::borrow<Pad>(static_cast<GstPad*>(m_pad));
+}
+
+Buffer *PadProbeInfo::buffer() const
+{
+    GstPadProbeInfo *info = probeInfo(m_info);
+    if (!(GST_PAD_PROBE_INFO_TYPE(info) & GST_PAD_PROBE_TYPE_BUFFER)) {
+        return NULL;
+    }
+    return Private::borrow<Buffer>(GST_PAD_PROBE_INFO_BUFFER(info));
+}
+
+BufferList *PadProbeInfo::bufferList() const
+{
+    GstPadProbeInfo *info = probeInfo(m_info);
+    if (!(GST_PAD_PROBE_INFO_TYPE(info) & GST_PAD_PROBE_TYPE_BUFFER_LIST)) {
+        return NULL;
+    }
+    return Private::borrow<BufferList>(GST_PAD_PROBE_INFO_BUFFER_LIST(info));
+}
+
+Event *PadProbeInfo::event() const
+{
+    GstPadProbeInfo *info = probeInfo(m_info);
+    if (!(GST_PAD_PROBE_INFO_TYPE(info) & (GST_PAD_PROBE_TYPE_EVENT_BOTH | GST_PAD_PROBE_TYPE_EVENT_FLUSH))) {
+        return NULL;
+    }
+    return Private::borrow<Event>(GST_PAD_PROBE_INFO_EVENT(info));
+}
+
+Query *PadProbeInfo::query() const
+{
+    GstPadProbeInfo *info = probeInfo(m_info);
+    if (!(GST_PAD_PROBE_INFO_TYPE(info) & GST_PAD_PROBE_TYPE_QUERY_BOTH)) {
+        return NULL;
+    }
+    return Private::borrow<Query>(GST_PAD_PROBE_INFO_QUERY(info));
 }
+
+Buffer *PadProbeInfo::bufferView() const
+{
+    GstPadProbeInfo *info = probeInfo(m_info);
+    if (!(GST_PAD_PROBE_INFO_TYPE(info) & GST_PAD_PROBE_TYPE_BUFFER)) {
+        return NULL;
+    }
+    //set on every call, in case setBuffer() replaced the buffer
+    Private::StackWrapper<Buffer> & view = probeViews(m_views)->buffer;
+    view.setObject(GST_PAD_PROBE_INFO_BUFFER(info));
+    return view.get();
+}
+
+BufferList *PadProbeInfo::bufferListView() const
+{
+    GstPadProbeInfo *info = probeInfo(m_info);
+    if (!(GST_PAD_PROBE_INFO_TYPE(info) & GST_PAD_PROBE_TYPE_BUFFER_LIST)) {
+        return NULL;
+    }
+    Private::StackWrapper<BufferList> & view = probeViews(m_views)->bufferList;
+    view.setObject(GST_PAD_PROBE_INFO_BUFFER_LIST(info));
+    return view.get();
+}
+
+Event *PadProbeInfo::eventView() const
+{
+    GstPadProbeInfo *info = probeInfo(m_info);
+    if (!(GST_PAD_PROBE_INFO_TYPE(info) & (GST_PAD_PROBE_TYPE_EVENT_BOTH | GST_PAD_PROBE_TYPE_EVENT_FLUSH))) {
+        return NULL;
+    }
+    Private::StackWrapper<Event> & view = probeViews(m_views)->event;
+    view.setObject(GST_PAD_PROBE_INFO_EVENT(info));
+    return view.get();
+}
+
+Query *PadProbeInfo::queryView() const
+{
+    GstPadProbeInfo *info = probeInfo(m_info);
+    if (!(GST_PAD_PROBE_INFO_TYPE(info) & GST_PAD_PROBE_TYPE_QUERY_BOTH)) {
+        return NULL;
+    }
+    Private::StackWrapper<Query> & view = probeViews(m_views)->query;
+    view.setObject(GST_PAD_PROBE_INFO_QUERY(info));
+    return view.get();
+}
+
+quint64 PadProbeInfo::offset() const
+{
+    return GST_PAD_PROBE_INFO_OFFSET(probeInfo(m_info));
+}
+
+uint PadProbeInfo::size() const
+{
+    return GST_PAD_PROBE_INFO_SIZE(probeInfo(m_info));
+}
+
+void PadProbeInfo::setBuffer(const BufferPtr & buffer)
+{
+    GstPadProbeInfo *info = probeInfo(m_info);
+    Q_ASSERT(GST_PAD_PROBE_INFO_TYPE(info) & GST_PAD_PROBE_TYPE_BUFFER);
+    if (buffer.isNull()) {
+        qWarning() << "QGst::PadProbeInfo::setBuffer: Cannot pass on a null buffer";
+        return;
+    }
+
+    //the probe owns the reference of the data it passes on
+    GstBuffer *old = GST_PAD_PROBE_INFO_BUFFER(info);
+    GST_PAD_PROBE_INFO_DATA(info) = gst_buffer_ref(buffer);
+    if (old) {
+        gst_buffer_unref(old);
+    }
+}
+
+//********************************************************
+
+struct PadProbeTrampoline
+{
+    static GstPadProbeReturn invoke(GstPad *pad, GstPadProbeInfo *info, gpointer userData)
+    {
+        //constructing the views only sets their vtable pointers
+        PadProbeViews views;
+        PadProbeInfo probeInfo(pad, info, &views);
+        return static_cast<GstPadProbeReturn>(
+            static_cast<Private::PadProbeCallbackBase*>(userData)->invoke(probeInfo));
+    }
+
+    static void destroy(gpointer userData)
+    {
+        delete static_cast<Private::PadProbeCallbackBase*>(userData);
+    }
+};
+
+//********************************************************
+
+ulong Pad::addProbeImpl(PadProbeTypes mask, Private::PadProbeCallbackBase *callback)
+{
+    return gst_pad_add_probe(object<GstPad>(), static_cast<GstPadProbeType>(static_cast<int>(mask)),
+                             &PadProbeTrampoline::invoke, callback,
+                             &PadProbeTrampoline::destroy);
+}
+
+void Pad::removeProbe(ulong id)
+{
+    gst_pad_remove_probe(object<GstPad>(), id);
+}
+
+} //namespace QGst
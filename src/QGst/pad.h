@@ -21,6 +21,105 @@
 
 namespace QGst {
 
+/*! \headerfile pad.h <QGst/Pad>
+ * \brief The data that a pad probe was called for
+ *
+ * A PadProbeInfo is passed to the callbacks installed with Pad::addProbe(). The data
+ * accessors return borrowed wrappers: no reference is taken on the native objects, so
+ * they stay writable if nobody else holds them, and the pointers are only valid until
+ * the callback returns.
+ *
+ * There are two kinds of accessors. bufferView(), bufferListView(), eventView() and
+ * queryView() return wrappers that live in the PadProbeInfo itself, so they cost no
+ * allocation or lookup, but they cannot be held in a RefPointer, nor be passed to
+ * anything that does, such as MiniObject::makeWritable(). buffer(), bufferList(),
+ * event() and query() return the shared wrappers that RefPointer::wrap() returns,
+ * which can be held in a RefPointer to keep them for longer; these are created when
+ * an accessor is first called for a native object, so calling buffer() allocates
+ * a wrapper for every new buffer.
+ */
+class QTGSTREAMER_EXPORT PadProbeInfo
+{
+public:
+    /*! \returns the type of this probe call; one data type and one scheduling type */
+    PadProbeTypes type() const;
+    /*! \returns the id that Pad::addProbe() returned for this probe */
+    ulong id() const;
+    /*! \returns the pad that the probe is installed on (borrowed) */
+    Pad *pad() const;
+
+    /*! \returns the buffer, if type() contains PadProbeTypeBuffer, or NULL (borrowed) */
+    Buffer *buffer() const;
+    /*! \returns the buffer list, if type() contains PadProbeTypeBufferList, or NULL (borrowed) */
+    BufferList *bufferList() const;
+    /*! \returns the event, if type() contains one of the event types, or NULL (borrowed) */
+    Event *event() const;
+    /*! \returns the query, if type() contains one of the query types, or NULL (borrowed) */
+    Query *query() const;
+
+    /*! \returns the same as buffer(), as a view that cannot be held in a RefPointer */
+    Buffer *bufferView() const;
+    /*! \returns the same as bufferList(), as a view that cannot be held in a RefPointer */
+    BufferList *bufferListView() const;
+    /*! \returns the same as event(), as a view that cannot be held in a RefPointer */
+    Event *eventView() const;
+    /*! \returns the same as query(), as a view that cannot be held in a RefPointer */
+    Query *queryView() const;
+
+    /*! \returns the offset of the data, for pull mode probes */
+    quint64 offset() const;
+    /*! \returns the size of the data, for pull mode probes */
+    uint size() const;
+
+    /*! Replaces the buffer that is passed on with \a buffer. This is the way to modify
+     * a buffer that is not writable: copy it, modify the copy and set it here.
+     * A null \a buffer is ignored; return PadProbeDrop to drop the data instead. */
+    void setBuffer(const BufferPtr & buffer);
+
+private:
+    friend struct PadProbeTrampoline;
+    PadProbeInfo(void *pad, void *info, void *views) : m_pad(pad), m_info(info), m_views(views) {}
+    Q_DISABLE_COPY(PadProbeInfo)
+
+    void *m_pad;
+    void *m_info;
+    void *m_views;
+};
+
+namespace Private {
+
+/* Type-erased callback of Pad::addProbe() */
+class QTGSTREAMER_EXPORT PadProbeCallbackBase
+{
+public:
+    virtual ~PadProbeCallbackBase() {}
+    virtual PadProbeReturn invoke(PadProbeInfo & info) = 0;
+};
+
+template <typename Function>
+class PadProbeCallback : public PadProbeCallbackBase
+{
+public:
+    PadProbeCallback(Function function) : m_function(function) {}
+    virtual PadProbeReturn invoke(PadProbeInfo & info) { return m_function(info); }
+private:
+    Function m_function;
+};
+
+template <class T>
+class PadProbeMemberCallback : public PadProbeCallbackBase
+{
+public:
+    typedef PadProbeReturn (T::*Method)(PadProbeInfo &);
+    PadProbeMemberCallback(T *receiver, Method method) : m_receiver(receiver), m_method(method) {}
+    virtual PadProbeReturn invoke(PadProbeInfo & info) { return (m_receiver->*m_method)(info); }
+private:
+    T *m_receiver;
+    Method m_method;
+};
+
+} //namespace Private
+
 /*! \headerfile pad.h <QGst/Pad>
  * \brief Wrapper class for GstPad
  */
@@ -56,8 +155,65 @@ public:
 
     bool query(const QueryPtr & query);
     bool sendEvent(const EventPtr & event);
+
+    /*! Pushes \a buffer to the peer of this source pad and returns the result of
+     * the peer's chain function. This is meant to be used from the streaming
+     * thread of an element, see CustomElement::chain().
+     * \note this takes the reference of \a buffer and makes it null, so that
+     * downstream elements can modify the buffer without copying it.
+     * Pushing a null buffer returns FlowError. */
+    FlowReturn push(BufferPtr & buffer);
+    /*! Sends \a event to the peer of this pad. Unlike sendEvent(), which gives
+     * the event to this pad, this is for pads that belong to the calling element. */
+    bool pushEvent(const EventPtr & event);
+
+    /*! Installs a probe that calls \a callback for the data types and scheduling
+     * modes in \a mask. \a callback can be a function pointer or any object that can
+     * be called as PadProbeReturn callback(QGst::PadProbeInfo & info), such as a
+     * C++11 lambda. Its return value decides what happens to the data, see
+     * PadProbeReturn. Returns an id for removeProbe(), or 0 if the probe was not
+     * installed; idle probes on an idle pad run immediately and may return 0.
+     *
+     * The callback is invoked directly from the streaming thread, without going
+     * through QGlib::Value or a signal emission. The views of PadProbeInfo, such as
+     * PadProbeInfo::bufferView(), give access to the data without allocating.
+     * \code
+     * int frames = 0;
+     * pad->addProbe(QGst::PadProbeTypeBuffer, [&frames](QGst::PadProbeInfo &) {
+     *     ++frames;
+     *     return QGst::PadProbeOk;
+     * });
+     * \endcode
+     */
+    template <typename Function>
+    ulong addProbe(PadProbeTypes mask, Function callback);
+
+    /*! \overload
+     * Calls \a method on \a receiver. \a receiver must outlive the probe. */
+    template <class T>
+    ulong addProbe(PadProbeTypes mask, T *receiver,
+                   PadProbeReturn (T::*method)(PadProbeInfo &));
+
+    /*! Removes the probe with the given \a id */
+    void removeProbe(ulong id);
+
+private:
+    ulong addProbeImpl(PadProbeTypes mask, Private::PadProbeCallbackBase *callback);
 };
 
+template <typename Function>
+inline ulong Pad::addProbe(PadProbeTypes mask, Function callback)
+{
+    return addProbeImpl(mask, new Private::PadProbeCallback<Function>(callback));
+}
+
+template <class T>
+inline ulong Pad::addProbe(PadProbeTypes mask, T *receiver,
+                           PadProbeReturn (T::*method)(PadProbeInfo &))
+{
+    return addProbeImpl(mask, new Private::PadProbeMemberCallback<T>(receiver, method));
+}
+
 }
 
 QGST_REGISTER_TYPE(QGst::Pad)
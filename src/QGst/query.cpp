@@ -17,6 +17,9 @@
 */
 #include "query.h"
 #include "element.h"
+#include "caps.h"
+#include "allocator.h"
+#include "bufferpool.h"
 #include "../QGlib/error.h"
 #include "../QGlib/string_p.h"
 #include <QtCore/QUrl>
@@ -399,4 +402,69 @@ void UriQuery::setUri(const QUrl & uri)
     gst_query_set_uri(object<GstQuery>(), uri.toEncoded());
 }
 
+//********************************************************
+
+AllocationQueryPtr AllocationQuery::create(const CapsPtr & caps, bool needPool)
+{
+    return AllocationQueryPtr::wrap(gst_query_new_allocation(caps, needPool), false);
+}
+
+CapsPtr AllocationQuery::caps() const
+{
+    GstCaps *c;
+    gst_query_parse_allocation(object<GstQuery>(), &c, NULL);
+    return CapsPtr::wrap(c);
+}
+
+bool AllocationQuery::needPool() const
+{
+    gboolean n;
+    gst_query_parse_allocation(object<GstQuery>(), NULL, &n);
+    return n;
+}
+
+uint AllocationQuery::allocationParamCount() const
+{
+    return gst_query_get_n_allocation_params(object<GstQuery>());
+}
+
+AllocatorPtr AllocationQuery::allocator(uint index) const
+{
+    GstAllocator *a;
+    gst_query_parse_nth_allocation_param(object<GstQuery>(), index, &a, NULL);
+    return AllocatorPtr::wrap(a, false);
+}
+
+AllocationParams AllocationQuery::allocationParams(uint index) const
+{
+    AllocationParams params;
+    gst_query_parse_nth_allocation_param(object<GstQuery>(), index, NULL, params);
+    return params;
+}
+
+void AllocationQuery::addAllocationParam(const AllocatorPtr & allocator,
+                                         const AllocationParams & params)
+{
+    gst_query_add_allocation_param(object<GstQuery>(), allocator, params);
+}
+
+uint AllocationQuery::allocationPoolCount() const
+{
+    return gst_query_get_n_allocation_pools(object<GstQuery>());
+}
+
+BufferPoolPtr AllocationQuery::allocationPool(uint index, uint *size,
+                                              uint *minBuffers, uint *maxBuffers) const
+{
+    GstBufferPool *p;
+    gst_query_parse_nth_allocation_pool(object<GstQuery>(), index, &p, size, minBuffers, maxBuffers);
+    return BufferPoolPtr::wrap(p, false);
+}
+
+void AllocationQuery::addAllocationPool(const BufferPoolPtr & pool, uint size,
+                                        uint minBuffers, uint maxBuffers)
+{
+    gst_query_add_allocation_pool(object<GstQuery>(), pool, size, minBuffers, maxBuffers);
+}
+
 } //namespace QGst
@@ -213,6 +213,35 @@ public:
     void setUri(const QUrl & uri);
 };
 
+/*! \headerfile query.h <QGst/Query>
+ * \brief Wrapper class for queries of type QGst::AllocationQuery
+ *
+ * Sent upstream by an element that is about to receive buffers, to find out how the
+ * upstream element would like them to be allocated. Downstream elements answer by
+ * adding the allocators and buffer pools they can provide, see
+ * CustomAllocator::create() for offering an allocator implemented in C++.
+ */
+class QTGSTREAMER_EXPORT AllocationQuery : public Query
+{
+    QGST_WRAPPER_FAKE_SUBCLASS(Allocation, Query)
+public:
+    static AllocationQueryPtr create(const CapsPtr & caps, bool needPool);
+
+    CapsPtr caps() const;
+    bool needPool() const;
+
+    uint allocationParamCount() const;
+    AllocatorPtr allocator(uint index) const;
+    AllocationParams allocationParams(uint index) const;
+    void addAllocationParam(const AllocatorPtr & allocator, const AllocationParams & params);
+
+    uint allocationPoolCount() const;
+    BufferPoolPtr allocationPool(uint index, uint *size = NULL,
+                                 uint *minBuffers = NULL, uint *maxBuffers = NULL) const;
+    void addAllocationPool(const BufferPoolPtr & pool, uint size,
+                           uint minBuffers, uint maxBuffers);
+};
+
 } //namespace QGst
 
 QGST_REGISTER_TYPE(QGst::Query)
@@ -225,5 +254,6 @@ QGST_REGISTER_SUBCLASS(Query, Convert)
 QGST_REGISTER_SUBCLASS(Query, Formats)
 QGST_REGISTER_SUBCLASS(Query, Buffering)
 QGST_REGISTER_SUBCLASS(Query, Uri)
+QGST_REGISTER_SUBCLASS(Query, Allocation)
 
 #endif
@@ -50,6 +50,14 @@ Structure Sample::info() const
     return Structure(gst_sample_get_info(object<GstSample>()));
 }
 
+StructureConstPtr Sample::infoView() const
+{
+    //share the structure instead of copying it; the view keeps the sample alive
+    const GstStructure *structure = gst_sample_get_info(object<GstSample>());
+    return SharedStructure::fromMiniObject(const_cast<GstStructure *>(structure),
+                                           MiniObjectPtr(const_cast<Sample*>(this)));
+}
+
 Segment Sample::segment() const
 {
     return Segment(gst_sample_get_segment(object<GstSample>()));
@@ -38,6 +38,10 @@ public:
     BufferPtr buffer() const;
     CapsPtr caps() const;
     Structure info() const;
+    /*! Returns a read-only view of the info structure of this sample, without copying it.
+     * The view keeps a reference to the sample. Use info() or SharedStructure::copy()
+     * to obtain a Structure that can be modified. */
+    StructureConstPtr infoView() const;
     Segment segment() const;
 };
 } //namespace QGst
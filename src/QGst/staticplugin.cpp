@@ -0,0 +1,89 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "staticplugin.h"
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <gst/gst.h>
+
+namespace QGst {
+
+struct StaticPlugin::Data
+{
+    struct Entry
+    {
+        QByteArray name;
+        Rank rank;
+        QGlib::Type type;
+    };
+
+    static gboolean init(GstPlugin *plugin, gpointer userData);
+
+    QByteArray name;
+    QByteArray description;
+    QByteArray version;
+    QByteArray license;
+    QList<Entry> elements;
+};
+
+//static
+gboolean StaticPlugin::Data::init(GstPlugin *plugin, gpointer userData)
+{
+    Data *d = static_cast<Data*>(userData);
+    Q_FOREACH(const Entry & entry, d->elements) {
+        if (!gst_element_register(plugin, entry.name.constData(), entry.rank, entry.type)) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+StaticPlugin::StaticPlugin(const char *name, const char *description,
+                           const char *version, const char *license)
+  : d(new Data)
+{
+    d->name = name;
+    d->description = description;
+    d->version = version;
+    d->license = license;
+}
+
+StaticPlugin::~StaticPlugin()
+{
+    delete d;
+}
+
+void StaticPlugin::addElement(const char *name, QGlib::Type type, Rank rank)
+{
+    Data::Entry entry;
+    entry.name = name;
+    entry.rank = rank;
+    entry.type = type;
+    d->elements.append(entry);
+}
+
+bool StaticPlugin::registerPlugin()
+{
+    //the init function is called before gst_plugin_register_static_full() returns
+    return gst_plugin_register_static_full(GST_VERSION_MAJOR, GST_VERSION_MINOR,
+                                           d->name.constData(), d->description.constData(),
+                                           &Data::init, d->version.constData(),
+                                           d->license.constData(), "QtGStreamer",
+                                           "QtGStreamer", "http://gstreamer.freedesktop.org/",
+                                           d);
+}
+
+} //namespace QGst
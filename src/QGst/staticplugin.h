@@ -0,0 +1,77 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef QGST_STATICPLUGIN_H
+#define QGST_STATICPLUGIN_H
+
+#include "customelement.h"
+
+namespace QGst {
+
+/*! \headerfile staticplugin.h <QGst/StaticPlugin>
+ * \brief Registers elements implemented in C++ as a GStreamer plugin of the application
+ *
+ * A StaticPlugin collects elements implemented with CustomElement and registers them
+ * with GStreamer as a plugin that lives in the application itself. Afterwards, the
+ * elements can be created with ElementFactory::make() and used in the pipeline
+ * descriptions of Parse::launch(), like the elements of any other plugin.
+ * \code
+ * QGst::StaticPlugin plugin("myplugin", "My elements");
+ * plugin.addElement<Counter>("counter");
+ * plugin.registerPlugin();
+ *
+ * QGst::ElementPtr bin = QGst::Parse::launch("videotestsrc ! counter ! fakesink");
+ * \endcode
+ *
+ * \note GStreamer must be initialized before calling registerPlugin()
+ */
+class QTGSTREAMER_EXPORT StaticPlugin
+{
+public:
+    /*! \a license must be one of the licenses that GStreamer knows,
+     * otherwise GStreamer refuses to load the plugin */
+    StaticPlugin(const char *name, const char *description,
+                 const char *version = "1.0", const char *license = "LGPL");
+    ~StaticPlugin();
+
+    /*! Adds the element implemented by \a T, with the factory name \a name.
+     * \a rank is used by autoplugging elements such as decodebin to choose
+     * between elements that handle the same caps. */
+    template <class T>
+    void addElement(const char *name, Rank rank = RankNone);
+    /*! \overload
+     * Adds an element of a GType that was registered by other means */
+    void addElement(const char *name, QGlib::Type type, Rank rank = RankNone);
+
+    /*! Registers the plugin and its elements with GStreamer. Elements that are
+     * added after this call are not registered. Returns false on failure. */
+    bool registerPlugin();
+
+private:
+    Q_DISABLE_COPY(StaticPlugin)
+    struct Data;
+    Data *d;
+};
+
+template <class T>
+inline void StaticPlugin::addElement(const char *name, Rank rank)
+{
+    addElement(name, CustomElement::registerType<T>(name), rank);
+}
+
+} //namespace QGst
+
+#endif
@@ -131,6 +131,151 @@ void Structure::setValue(const char *fieldName, const QGlib::Value & value)
     gst_structure_set_value(d->structure, fieldName, value);
 }
 
+#ifndef DOXYGEN_RUN
+
+static inline const GValue *typedField(const GstStructure *structure, QGlib::Quark field, GType type)
+{
+    if (!structure) {
+        return NULL;
+    }
+    const GValue *value = gst_structure_id_get_value(structure, field);
+    return (value && G_VALUE_HOLDS(value, type)) ? value : NULL;
+}
+
+static gboolean visitStructureField(GQuark field, const GValue *value, gpointer data)
+{
+    return static_cast<Private::StructureFieldVisitorBase*>(data)->visit(field, value);
+}
+
+#endif //DOXYGEN_RUN
+
+bool Structure::getBoolean(QGlib::Quark field, bool *value) const
+{
+    const GValue *v = typedField(d->structure, field, G_TYPE_BOOLEAN);
+    if (v) {
+        *value = g_value_get_boolean(v);
+    }
+    return v != NULL;
+}
+
+bool Structure::getInt(QGlib::Quark field, int *value) const
+{
+    const GValue *v = typedField(d->structure, field, G_TYPE_INT);
+    if (v) {
+        *value = g_value_get_int(v);
+    }
+    return v != NULL;
+}
+
+bool Structure::getUint(QGlib::Quark field, uint *value) const
+{
+    const GValue *v = typedField(d->structure, field, G_TYPE_UINT);
+    if (v) {
+        *value = g_value_get_uint(v);
+    }
+    return v != NULL;
+}
+
+bool Structure::getInt64(QGlib::Quark field, qint64 *value) const
+{
+    const GValue *v = typedField(d->structure, field, G_TYPE_INT64);
+    if (v) {
+        *value = g_value_get_int64(v);
+    }
+    return v != NULL;
+}
+
+bool Structure::getUint64(QGlib::Quark field, quint64 *value) const
+{
+    const GValue *v = typedField(d->structure, field, G_TYPE_UINT64);
+    if (v) {
+        *value = g_value_get_uint64(v);
+    }
+    return v != NULL;
+}
+
+bool Structure::getDouble(QGlib::Quark field, double *value) const
+{
+    const GValue *v = typedField(d->structure, field, G_TYPE_DOUBLE);
+    if (v) {
+        *value = g_value_get_double(v);
+    }
+    return v != NULL;
+}
+
+bool Structure::getFraction(QGlib::Quark field, Fraction *value) const
+{
+    const GValue *v = typedField(d->structure, field, GST_TYPE_FRACTION);
+    if (v) {
+        value->numerator = gst_value_get_fraction_numerator(v);
+        value->denominator = gst_value_get_fraction_denominator(v);
+    }
+    return v != NULL;
+}
+
+const char *Structure::getString(QGlib::Quark field) const
+{
+    const GValue *v = typedField(d->structure, field, G_TYPE_STRING);
+    return v ? g_value_get_string(v) : NULL;
+}
+
+void Structure::setBoolean(QGlib::Quark field, bool value)
+{
+    Q_ASSERT(isValid());
+    gst_structure_id_set(d->structure, field, G_TYPE_BOOLEAN, static_cast<gboolean>(value), NULL);
+}
+
+void Structure::setInt(QGlib::Quark field, int value)
+{
+    Q_ASSERT(isValid());
+    gst_structure_id_set(d->structure, field, G_TYPE_INT, value, NULL);
+}
+
+void Structure::setUint(QGlib::Quark field, uint value)
+{
+    Q_ASSERT(isValid());
+    gst_structure_id_set(d->structure, field, G_TYPE_UINT, value, NULL);
+}
+
+void Structure::setInt64(QGlib::Quark field, qint64 value)
+{
+    Q_ASSERT(isValid());
+    gst_structure_id_set(d->structure, field, G_TYPE_INT64, static_cast<gint64>(value), NULL);
+}
+
+void Structure::setUint64(QGlib::Quark field, quint64 value)
+{
+    Q_ASSERT(isValid());
+    gst_structure_id_set(d->structure, field, G_TYPE_UINT64, static_cast<guint64>(value), NULL);
+}
+
+void Structure::setDouble(QGlib::Quark field, double value)
+{
+    Q_ASSERT(isValid());
+    gst_structure_id_set(d->structure, field, G_TYPE_DOUBLE, value, NULL);
+}
+
+void Structure::setFraction(QGlib::Quark field, const Fraction & value)
+{
+    Q_ASSERT(isValid());
+    gst_structure_id_set(d->structure, field, GST_TYPE_FRACTION,
+                         value.numerator, value.denominator, NULL);
+}
+
+void Structure::setString(QGlib::Quark field, const char *value)
+{
+    Q_ASSERT(isValid());
+    gst_structure_id_set(d->structure, field, G_TYPE_STRING, value, NULL);
+}
+
+bool Structure::forEachFieldImpl(Private::StructureFieldVisitorBase & visitor) const
+{
+    if (!d->structure) {
+        return true;
+    }
+    return gst_structure_foreach(d->structure, &visitStructureField, &visitor);
+}
+
 unsigned int Structure::numberOfFields() const
 {
     return d->structure ? gst_structure_n_fields(d->structure) : 0;
@@ -24,10 +24,34 @@
 #include "global.h"
 #include "../QGlib/type.h"
 #include "../QGlib/value.h"
+#include "../QGlib/quark.h"
+#include "structs.h"
 #include <QtCore/QString>
 
 namespace QGst {
 
+#ifndef DOXYGEN_RUN
+namespace Private {
+
+struct QTGSTREAMER_EXPORT StructureFieldVisitorBase
+{
+    virtual ~StructureFieldVisitorBase() {}
+    virtual bool visit(QGlib::Quark field, const GValue *value) = 0;
+};
+
+template <typename Function>
+struct StructureFieldVisitor : public StructureFieldVisitorBase
+{
+    StructureFieldVisitor(Function function) : m_function(function) {}
+    virtual bool visit(QGlib::Quark field, const GValue *value)
+    { return m_function(field, value); }
+
+    Function m_function;
+};
+
+} //namespace Private
+#endif //DOXYGEN_RUN
+
 /*! \headerfile structure.h <QGst/Structure>
  * \brief Wrapper for GstStructure
  *
@@ -40,6 +64,17 @@ namespace QGst {
  * the setName() method. Afterwards, you can set values with setValue() and retrieve them
  * with value().
  *
+ * Code that reads the same fields repeatedly, for example when parsing the element
+ * messages of "level" or "rtpjitterbuffer", should prefer the typed getters and setters
+ * that take a QGlib::Quark, such as getInt() and setDouble(). They access the GValue of
+ * the field directly instead of copying it into a QGlib::Value and they do not need to
+ * look up the field name on each call:
+ * \code
+ * static const QGlib::Quark rms = QGlib::Quark::fromString("rms");
+ * double value;
+ * if (structure->getDouble(rms, &value)) ...
+ * \endcode
+ *
  * Structure is also serializable. You can use toString() to serialize it into a string
  * and fromString() to deserialize it.
  *
@@ -67,6 +102,38 @@ public:
     inline void setValue(const char *fieldName, const T & value);
     void setValue(const char *fieldName, const QGlib::Value & value);
 
+    /*! These return true and set \a value if the field \a field exists and holds
+     * a value of the requested type. Otherwise they return false and leave \a value
+     * untouched. */
+    bool getBoolean(QGlib::Quark field, bool *value) const;
+    bool getInt(QGlib::Quark field, int *value) const; ///< \overload
+    bool getUint(QGlib::Quark field, uint *value) const; ///< \overload
+    bool getInt64(QGlib::Quark field, qint64 *value) const; ///< \overload
+    bool getUint64(QGlib::Quark field, quint64 *value) const; ///< \overload
+    bool getDouble(QGlib::Quark field, double *value) const; ///< \overload
+    bool getFraction(QGlib::Quark field, Fraction *value) const; ///< \overload
+    /*! Returns the UTF-8 string held by the field \a field, or NULL if the field does not
+     * exist or does not hold a string. The string is not copied, so it is only valid
+     * until the structure is modified or destroyed. */
+    const char *getString(QGlib::Quark field) const;
+
+    void setBoolean(QGlib::Quark field, bool value);
+    void setInt(QGlib::Quark field, int value);
+    void setUint(QGlib::Quark field, uint value);
+    void setInt64(QGlib::Quark field, qint64 value);
+    void setUint64(QGlib::Quark field, quint64 value);
+    void setDouble(QGlib::Quark field, double value);
+    void setFraction(QGlib::Quark field, const Fraction & value);
+    void setString(QGlib::Quark field, const char *value);
+
+    /*! Calls \a function for each field of the structure, in order, with the field's
+     * quark and its GValue, which is not copied. \a function must have the signature
+     * <tt>bool function(QGlib::Quark field, const GValue *value)</tt> and return false
+     * to stop the iteration, in which case this function also returns false.
+     * The structure must not be modified from \a function. */
+    template <typename Function>
+    inline bool forEachField(Function function) const;
+
     unsigned int numberOfFields() const;
     QString fieldName(unsigned int fieldNumber) const;
     QGlib::Type fieldType(const char *fieldName) const;
@@ -86,6 +153,8 @@ public:
 private:
     friend class SharedStructure;
 
+    bool forEachFieldImpl(Private::StructureFieldVisitorBase & visitor) const;
+
     struct Data;
 
     QTGSTREAMER_NO_EXPORT
@@ -100,6 +169,13 @@ inline void Structure::setValue(const char *fieldName, const T & value)
     setValue(fieldName, QGlib::Value::create(value));
 }
 
+template <typename Function>
+inline bool Structure::forEachField(Function function) const
+{
+    Private::StructureFieldVisitor<Function> visitor(function);
+    return forEachFieldImpl(visitor);
+}
+
 //static
 inline Structure Structure::fromString(const QString & str)
 {
@@ -140,6 +216,7 @@ private:
     friend class Message;
     friend class Event;
     friend class Query;
+    friend class Sample;
 
     struct Data;
 
@@ -59,6 +59,128 @@ SamplePtr getSampleTag(GstTagList * list, const gchar * tag, int index)
 
 #ifndef DOXYGEN_RUN
 
+enum CommonTagId {
+    CommonTitle, CommonArtist, CommonAlbum, CommonGenre, CommonComment,
+    CommonCodec, CommonVideoCodec, CommonAudioCodec, CommonContainerFormat,
+    CommonLanguageCode, CommonTrackNumber, CommonTrackCount, CommonBitrate,
+    CommonNominalBitrate, CommonDuration, CommonImage, CommonTagCount
+};
+
+//interned tag names, so that they can be compared by pointer with the names
+//that gst_tag_list_foreach() passes, which are interned as well
+static const gchar *s_commonTagNames[CommonTagCount];
+
+static void initCommonTagNames()
+{
+    static gsize initialized = 0;
+    if (g_once_init_enter(&initialized)) {
+        s_commonTagNames[CommonTitle] = g_intern_static_string(GST_TAG_TITLE);
+        s_commonTagNames[CommonArtist] = g_intern_static_string(GST_TAG_ARTIST);
+        s_commonTagNames[CommonAlbum] = g_intern_static_string(GST_TAG_ALBUM);
+        s_commonTagNames[CommonGenre] = g_intern_static_string(GST_TAG_GENRE);
+        s_commonTagNames[CommonComment] = g_intern_static_string(GST_TAG_COMMENT);
+        s_commonTagNames[CommonCodec] = g_intern_static_string(GST_TAG_CODEC);
+        s_commonTagNames[CommonVideoCodec] = g_intern_static_string(GST_TAG_VIDEO_CODEC);
+        s_commonTagNames[CommonAudioCodec] = g_intern_static_string(GST_TAG_AUDIO_CODEC);
+        s_commonTagNames[CommonContainerFormat] = g_intern_static_string(GST_TAG_CONTAINER_FORMAT);
+        s_commonTagNames[CommonLanguageCode] = g_intern_static_string(GST_TAG_LANGUAGE_CODE);
+        s_commonTagNames[CommonTrackNumber] = g_intern_static_string(GST_TAG_TRACK_NUMBER);
+        s_commonTagNames[CommonTrackCount] = g_intern_static_string(GST_TAG_TRACK_COUNT);
+        s_commonTagNames[CommonBitrate] = g_intern_static_string(GST_TAG_BITRATE);
+        s_commonTagNames[CommonNominalBitrate] = g_intern_static_string(GST_TAG_NOMINAL_BITRATE);
+        s_commonTagNames[CommonDuration] = g_intern_static_string(GST_TAG_DURATION);
+        s_commonTagNames[CommonImage] = g_intern_static_string(GST_TAG_IMAGE);
+        g_once_init_leave(&initialized, 1);
+    }
+}
+
+static QString peekStringTag(const GstTagList *list, const gchar *tag)
+{
+    const gchar *value = NULL;
+    gst_tag_list_peek_string_index(list, tag, 0, &value);
+    return QString::fromUtf8(value);
+}
+
+static quint32 peekUintTag(const GstTagList *list, const gchar *tag)
+{
+    guint value = 0;
+    gst_tag_list_get_uint_index(list, tag, 0, &value);
+    return value;
+}
+
+static void extractCommonTag(const GstTagList *list, const gchar *tag, gpointer data)
+{
+    CommonTags *tags = static_cast<CommonTags*>(data);
+
+    int id = 0;
+    while (id < CommonTagCount && s_commonTagNames[id] != tag) {
+        ++id;
+    }
+
+    switch (id) {
+    case CommonTitle:
+        tags->title = peekStringTag(list, tag);
+        break;
+    case CommonArtist:
+        tags->artist = peekStringTag(list, tag);
+        break;
+    case CommonAlbum:
+        tags->album = peekStringTag(list, tag);
+        break;
+    case CommonGenre:
+        tags->genre = peekStringTag(list, tag);
+        break;
+    case CommonComment:
+        tags->comment = peekStringTag(list, tag);
+        break;
+    case CommonCodec:
+        tags->codec = peekStringTag(list, tag);
+        break;
+    case CommonVideoCodec:
+        tags->videoCodec = peekStringTag(list, tag);
+        break;
+    case CommonAudioCodec:
+        tags->audioCodec = peekStringTag(list, tag);
+        break;
+    case CommonContainerFormat:
+        tags->containerFormat = peekStringTag(list, tag);
+        break;
+    case CommonLanguageCode:
+        tags->languageCode = peekStringTag(list, tag);
+        break;
+    case CommonTrackNumber:
+        tags->trackNumber = peekUintTag(list, tag);
+        break;
+    case CommonTrackCount:
+        tags->trackCount = peekUintTag(list, tag);
+        break;
+    case CommonBitrate:
+        tags->bitrate = peekUintTag(list, tag);
+        break;
+    case CommonNominalBitrate:
+        tags->nominalBitrate = peekUintTag(list, tag);
+        break;
+    case CommonDuration:
+    {
+        guint64 value = 0;
+        gst_tag_list_get_uint64_index(list, tag, 0, &value);
+        tags->duration = value;
+        break;
+    }
+    case CommonImage:
+        tags->imageCount = gst_tag_list_get_tag_size(list, tag);
+        break;
+    default:
+        break;
+    }
+}
+
+CommonTags::CommonTags()
+    : trackNumber(0), trackCount(0), bitrate(0), nominalBitrate(0),
+      duration(0), imageCount(0)
+{
+}
+
 struct QTGSTREAMER_NO_EXPORT TagList::Data : public QSharedData
 {
     Data();
@@ -79,7 +201,8 @@ TagList::Data::Data(const GstTagList *tl)
     : QSharedData()
 {
     if (tl && GST_IS_TAG_LIST(tl)) {
-        taglist = gst_tag_list_copy(tl);
+        //share the native list; it is copied in TagList::writableTagList() when modified
+        taglist = gst_tag_list_ref(const_cast<GstTagList*>(tl));
     } else {
         taglist = gst_tag_list_new_empty();
     }
@@ -88,7 +211,7 @@ TagList::Data::Data(const GstTagList *tl)
 TagList::Data::Data(const TagList::Data & other)
     : QSharedData(other)
 {
-    taglist = gst_tag_list_copy(other.taglist);
+    taglist = gst_tag_list_ref(other.taglist);
 }
 
 TagList::Data::~Data()
@@ -123,6 +246,14 @@ TagList & TagList::operator=(const TagList & other)
     return *this;
 }
 
+GstTagList *TagList::writableTagList()
+{
+    //d-> detaches from other TagLists; then the native list is copied
+    //only if it is still shared, e.g. with a message or an event
+    d->taglist = gst_tag_list_make_writable(d->taglist);
+    return d->taglist;
+}
+
 bool TagList::isEmpty() const
 {
     return gst_tag_list_is_empty(d->taglist);
@@ -130,7 +261,7 @@ bool TagList::isEmpty() const
 
 void TagList::insert(const TagList & other, TagMergeMode mode)
 {
-    gst_tag_list_insert(d->taglist, other.d->taglist, static_cast<GstTagMergeMode>(mode));
+    gst_tag_list_insert(writableTagList(), other.d->taglist, static_cast<GstTagMergeMode>(mode));
 }
 
 //static
@@ -153,7 +284,7 @@ QGlib::Value TagList::tagValue(const char *tag, int index) const
 
 void TagList::setTagValue(const char *tag, const QGlib::Value & value, TagMergeMode mode)
 {
-    gst_tag_list_add_value(d->taglist, static_cast<GstTagMergeMode>(mode), tag, value);
+    gst_tag_list_add_value(writableTagList(), static_cast<GstTagMergeMode>(mode), tag, value);
 }
 
 int TagList::tagValueCount(const char *tag) const
@@ -169,12 +300,12 @@ void TagList::clear()
 
 void TagList::removeTag(const char *tag)
 {
-    gst_tag_list_remove_tag(d->taglist, tag);
+    gst_tag_list_remove_tag(writableTagList(), tag);
 }
 
 TagList::operator GstTagList*()
 {
-    return d->taglist;
+    return writableTagList();
 }
 
 TagList::operator const GstTagList*() const
@@ -182,6 +313,15 @@ TagList::operator const GstTagList*() const
     return d->taglist;
 }
 
+CommonTags TagList::commonTags() const
+{
+    initCommonTagNames();
+
+    CommonTags tags;
+    gst_tag_list_foreach(d->taglist, &extractCommonTag, &tags);
+    return tags;
+}
+
 QString TagList::title(int index) const
 {
     return getStringTag(d->taglist, GST_TAG_TITLE, index);
@@ -189,7 +329,7 @@ QString TagList::title(int index) const
 
 void TagList::setTitle(const QString & value, TagMergeMode mode)
 {
-    gst_tag_list_add_value(d->taglist, static_cast<GstTagMergeMode>(mode),
+    gst_tag_list_add_value(writableTagList(), static_cast<GstTagMergeMode>(mode),
                            GST_TAG_TITLE, QGlib::Value::create(value));
 }
 
@@ -205,7 +345,7 @@ QString TagList::titleSortName() const
 
 void TagList::setTitleSortName(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_TITLE_SORTNAME, QGlib::Value::create(value));
 }
 
@@ -216,7 +356,7 @@ QString TagList::artist(int index) const
 
 void TagList::setArtist(const QString & value, TagMergeMode mode)
 {
-    gst_tag_list_add_value(d->taglist, static_cast<GstTagMergeMode>(mode),
+    gst_tag_list_add_value(writableTagList(), static_cast<GstTagMergeMode>(mode),
                            GST_TAG_ARTIST, QGlib::Value::create(value));
 }
 
@@ -232,7 +372,7 @@ QString TagList::artistSortName() const
 
 void TagList::setArtistSortName(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_ARTIST_SORTNAME, QGlib::Value::create(value));
 }
 
@@ -243,7 +383,7 @@ QString TagList::composer(int index) const
 
 void TagList::setComposer(const QString & value, TagMergeMode mode)
 {
-    gst_tag_list_add_value(d->taglist, static_cast<GstTagMergeMode>(mode),
+    gst_tag_list_add_value(writableTagList(), static_cast<GstTagMergeMode>(mode),
                            GST_TAG_COMPOSER, QGlib::Value::create(value));
 }
 
@@ -266,7 +406,7 @@ QDate TagList::date() const
 void TagList::setDate(const QDate & value)
 {
     GDate * date = g_date_new_julian(value.toJulianDay());
-    gst_tag_list_add (d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_DATE, date, NULL);
+    gst_tag_list_add (writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_DATE, date, NULL);
 }
 
 QString TagList::genre(int index) const
@@ -276,7 +416,7 @@ QString TagList::genre(int index) const
 
 void TagList::setGenre(const QString & value, TagMergeMode mode)
 {
-    gst_tag_list_add_value(d->taglist, static_cast<GstTagMergeMode>(mode),
+    gst_tag_list_add_value(writableTagList(), static_cast<GstTagMergeMode>(mode),
                            GST_TAG_GENRE, QGlib::Value::create(value));
 }
 
@@ -292,7 +432,7 @@ QString TagList::comment(int index) const
 
 void TagList::setComment(const QString & value, TagMergeMode mode)
 {
-    gst_tag_list_add_value(d->taglist, static_cast<GstTagMergeMode>(mode),
+    gst_tag_list_add_value(writableTagList(), static_cast<GstTagMergeMode>(mode),
                            GST_TAG_COMMENT, QGlib::Value::create(value));
 }
 
@@ -308,7 +448,7 @@ QString TagList::extendedComment(int index) const
 
 void TagList::setExtendedComment(const QString & value, TagMergeMode mode)
 {
-    gst_tag_list_add_value(d->taglist, static_cast<GstTagMergeMode>(mode),
+    gst_tag_list_add_value(writableTagList(), static_cast<GstTagMergeMode>(mode),
                            GST_TAG_EXTENDED_COMMENT, QGlib::Value::create(value));
 }
 
@@ -324,7 +464,7 @@ quint32 TagList::trackNumber() const
 
 void TagList::setTrackNumber(quint32 value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_TRACK_NUMBER, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_TRACK_NUMBER, value, NULL);
 }
 
 quint32 TagList::trackCount() const
@@ -334,7 +474,7 @@ quint32 TagList::trackCount() const
 
 void TagList::setTrackCount(quint32 value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_TRACK_COUNT, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_TRACK_COUNT, value, NULL);
 }
 
 quint32 TagList::albumVolumeNumber() const
@@ -344,7 +484,7 @@ quint32 TagList::albumVolumeNumber() const
 
 void TagList::setAlbumVolumeNumber(quint32 value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_ALBUM_VOLUME_NUMBER, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_ALBUM_VOLUME_NUMBER, value, NULL);
 }
 
 quint32 TagList::albumVolumeCount() const
@@ -354,7 +494,7 @@ quint32 TagList::albumVolumeCount() const
 
 void TagList::setAlbumVolumeCount(quint32 value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_ALBUM_VOLUME_COUNT, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_ALBUM_VOLUME_COUNT, value, NULL);
 }
 
 QString TagList::location(int index) const
@@ -364,7 +504,7 @@ QString TagList::location(int index) const
 
 void TagList::setLocation(const QString & value, TagMergeMode mode)
 {
-    gst_tag_list_add_value(d->taglist, static_cast<GstTagMergeMode>(mode),
+    gst_tag_list_add_value(writableTagList(), static_cast<GstTagMergeMode>(mode),
                            GST_TAG_LOCATION, QGlib::Value::create(value));
 }
 
@@ -380,7 +520,7 @@ QString TagList::homepage(int index) const
 
 void TagList::setHomepage(const QString & value, TagMergeMode mode)
 {
-    gst_tag_list_add_value(d->taglist, static_cast<GstTagMergeMode>(mode),
+    gst_tag_list_add_value(writableTagList(), static_cast<GstTagMergeMode>(mode),
                            GST_TAG_HOMEPAGE, QGlib::Value::create(value));
 }
 
@@ -396,7 +536,7 @@ QString TagList::description(int index) const
 
 void TagList::setDescription(const QString & value, TagMergeMode mode)
 {
-    gst_tag_list_add_value(d->taglist, static_cast<GstTagMergeMode>(mode),
+    gst_tag_list_add_value(writableTagList(), static_cast<GstTagMergeMode>(mode),
                            GST_TAG_DESCRIPTION, QGlib::Value::create(value));
 }
 
@@ -412,7 +552,7 @@ QString TagList::version() const
 
 void TagList::setVersion(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_VERSION, QGlib::Value::create(value));
 }
 
@@ -423,7 +563,7 @@ QString TagList::isrc() const
 
 void TagList::setIsrc(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_ISRC, QGlib::Value::create(value));
 }
 
@@ -434,7 +574,7 @@ QString TagList::organization(int index) const
 
 void TagList::setOrganization(const QString & value, TagMergeMode mode)
 {
-    gst_tag_list_add_value(d->taglist, static_cast<GstTagMergeMode>(mode),
+    gst_tag_list_add_value(writableTagList(), static_cast<GstTagMergeMode>(mode),
                            GST_TAG_ORGANIZATION, QGlib::Value::create(value));
 }
 
@@ -450,7 +590,7 @@ QString TagList::copyright() const
 
 void TagList::setCopyright(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_COPYRIGHT, QGlib::Value::create(value));
 }
 
@@ -461,7 +601,7 @@ QString TagList::copyrightUri() const
 
 void TagList::setCopyrightUri(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_COPYRIGHT_URI, QGlib::Value::create(value));
 }
 
@@ -472,7 +612,7 @@ QString TagList::contact(int index) const
 
 void TagList::setContact(const QString & value, TagMergeMode mode)
 {
-    gst_tag_list_add_value(d->taglist, static_cast<GstTagMergeMode>(mode),
+    gst_tag_list_add_value(writableTagList(), static_cast<GstTagMergeMode>(mode),
                            GST_TAG_CONTACT, QGlib::Value::create(value));
 }
 
@@ -488,7 +628,7 @@ QString TagList::license() const
 
 void TagList::setLicense(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_LICENSE, QGlib::Value::create(value));
 }
 
@@ -499,7 +639,7 @@ QString TagList::licenseUri() const
 
 void TagList::setLicenseUri(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_LICENSE_URI, QGlib::Value::create(value));
 }
 
@@ -510,7 +650,7 @@ QString TagList::performer(int index) const
 
 void TagList::setPerformer(const QString & value, TagMergeMode mode)
 {
-    gst_tag_list_add_value(d->taglist, static_cast<GstTagMergeMode>(mode),
+    gst_tag_list_add_value(writableTagList(), static_cast<GstTagMergeMode>(mode),
                            GST_TAG_PERFORMER, QGlib::Value::create(value));
 }
 
@@ -528,7 +668,7 @@ quint64 TagList::duration() const
 
 void TagList::setDuration(quint64 value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_DURATION, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_DURATION, value, NULL);
 }
 
 QString TagList::codec() const
@@ -538,7 +678,7 @@ QString TagList::codec() const
 
 void TagList::setCodec(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_CODEC, QGlib::Value::create(value));
 }
 
@@ -549,7 +689,7 @@ QString TagList::videoCodec() const
 
 void TagList::setVideoCodec(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_VIDEO_CODEC, QGlib::Value::create(value));
 }
 
@@ -560,7 +700,7 @@ QString TagList::audioCodec() const
 
 void TagList::setAudioCodec(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_AUDIO_CODEC, QGlib::Value::create(value));
 }
 
@@ -571,7 +711,7 @@ QString TagList::subtitleCodec() const
 
 void TagList::setSubtitleCodec(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_SUBTITLE_CODEC, QGlib::Value::create(value));
 }
 
@@ -582,7 +722,7 @@ QString TagList::containerFormat() const
 
 void TagList::setContainerFormat(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_CONTAINER_FORMAT, QGlib::Value::create(value));
 }
 
@@ -593,7 +733,7 @@ quint32 TagList::bitrate() const
 
 void TagList::setBitrate(quint32 value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_BITRATE, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_BITRATE, value, NULL);
 }
 
 quint32 TagList::nominalBitrate() const
@@ -603,7 +743,7 @@ quint32 TagList::nominalBitrate() const
 
 void TagList::setNominalBitrate(quint32 value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_NOMINAL_BITRATE, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_NOMINAL_BITRATE, value, NULL);
 }
 
 quint32 TagList::minimumBitrate() const
@@ -613,7 +753,7 @@ quint32 TagList::minimumBitrate() const
 
 void TagList::setMinimumBitrate(quint32 value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_MINIMUM_BITRATE, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_MINIMUM_BITRATE, value, NULL);
 }
 
 quint32 TagList::maximumBitrate() const
@@ -623,7 +763,7 @@ quint32 TagList::maximumBitrate() const
 
 void TagList::setMaximumBitrate(quint32 value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_MAXIMUM_BITRATE, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_MAXIMUM_BITRATE, value, NULL);
 }
 
 quint32 TagList::serial() const
@@ -633,7 +773,7 @@ quint32 TagList::serial() const
 
 void TagList::setSerial(quint32 value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_SERIAL, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_SERIAL, value, NULL);
 }
 
 QString TagList::encoder() const
@@ -643,7 +783,7 @@ QString TagList::encoder() const
 
 void TagList::setEncoder(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_ENCODER, QGlib::Value::create(value));
 }
 
@@ -654,7 +794,7 @@ quint32 TagList::encoderVersion() const
 
 void TagList::setEncoderVersion(quint32 value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_ENCODER_VERSION, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_ENCODER_VERSION, value, NULL);
 }
 
 double TagList::trackGain() const
@@ -664,7 +804,7 @@ double TagList::trackGain() const
 
 void TagList::setTrackGain(double value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_TRACK_GAIN, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_TRACK_GAIN, value, NULL);
 }
 
 double TagList::trackPeak() const
@@ -674,7 +814,7 @@ double TagList::trackPeak() const
 
 void TagList::setTrackPeak(double value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_TRACK_PEAK, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_TRACK_PEAK, value, NULL);
 }
 
 double TagList::albumGain() const
@@ -684,7 +824,7 @@ double TagList::albumGain() const
 
 void TagList::setAlbumGain(double value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_ALBUM_GAIN, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_ALBUM_GAIN, value, NULL);
 }
 
 double TagList::albumPeak() const
@@ -694,7 +834,7 @@ double TagList::albumPeak() const
 
 void TagList::setAlbumPeak(double value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_ALBUM_PEAK, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_ALBUM_PEAK, value, NULL);
 }
 
 double TagList::referenceLevel() const
@@ -704,7 +844,7 @@ double TagList::referenceLevel() const
 
 void TagList::setReferenceLevel(double value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_REFERENCE_LEVEL, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_REFERENCE_LEVEL, value, NULL);
 }
 
 QString TagList::languageCode() const
@@ -714,7 +854,7 @@ QString TagList::languageCode() const
 
 void TagList::setLanguageCode(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_LANGUAGE_CODE, QGlib::Value::create(value));
 }
 
@@ -725,7 +865,7 @@ SamplePtr TagList::image(int index) const
 
 void TagList::setImage(const SamplePtr & value, TagMergeMode mode)
 {
-    gst_tag_list_add_value(d->taglist, static_cast<GstTagMergeMode>(mode),
+    gst_tag_list_add_value(writableTagList(), static_cast<GstTagMergeMode>(mode),
                            GST_TAG_IMAGE, QGlib::Value::create(value));
 }
 
@@ -741,7 +881,7 @@ SamplePtr TagList::previewImage() const
 
 void TagList::setPreviewImage(const SamplePtr & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_PREVIEW_IMAGE, QGlib::Value::create(value));
 }
 
@@ -752,7 +892,7 @@ SamplePtr TagList::attachment(int index) const
 
 void TagList::setAttachment(const SamplePtr & value, TagMergeMode mode)
 {
-    gst_tag_list_add_value(d->taglist, static_cast<GstTagMergeMode>(mode),
+    gst_tag_list_add_value(writableTagList(), static_cast<GstTagMergeMode>(mode),
                            GST_TAG_ATTACHMENT, QGlib::Value::create(value));
 }
 
@@ -768,7 +908,7 @@ double TagList::beatsPerMinute() const
 
 void TagList::setBeatsPerMinute(double value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_BEATS_PER_MINUTE, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_BEATS_PER_MINUTE, value, NULL);
 }
 
 QString TagList::keywords(int index) const
@@ -778,7 +918,7 @@ QString TagList::keywords(int index) const
 
 void TagList::setKeywords(const QString & value, TagMergeMode mode)
 {
-    gst_tag_list_add_value(d->taglist, static_cast<GstTagMergeMode>(mode),
+    gst_tag_list_add_value(writableTagList(), static_cast<GstTagMergeMode>(mode),
                            GST_TAG_KEYWORDS, QGlib::Value::create(value));
 }
 
@@ -794,7 +934,7 @@ QString TagList::geoLocationName() const
 
 void TagList::seGeoLocationName(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_GEO_LOCATION_NAME, QGlib::Value::create(value));
 }
 
@@ -805,7 +945,7 @@ double TagList::geoLocationLatitude() const
 
 void TagList::setGeoLocationLatitude(double value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                      GST_TAG_GEO_LOCATION_LATITUDE, value, NULL);
 }
 
@@ -816,7 +956,7 @@ double TagList::geoLocationLongitude() const
 
 void TagList::setGeoLocationLongitude(double value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                      GST_TAG_GEO_LOCATION_LONGITUDE, value, NULL);
 }
 
@@ -827,7 +967,7 @@ double TagList::geoLocationElevation() const
 
 void TagList::setGeoLocationElevation(double value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                      GST_TAG_GEO_LOCATION_ELEVATION, value, NULL);
 }
 
@@ -838,7 +978,7 @@ QString TagList::geoLocationCountry() const
 
 void TagList::setGeoLocationCountry(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_GEO_LOCATION_COUNTRY, QGlib::Value::create(value));
 }
 
@@ -849,7 +989,7 @@ QString TagList::geoLocationCity() const
 
 void TagList::setGeoLocationCity(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_GEO_LOCATION_CITY, QGlib::Value::create(value));
 }
 
@@ -860,7 +1000,7 @@ QString TagList::geoLocationSublocation() const
 
 void TagList::setGeoLocationSublocation(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_GEO_LOCATION_SUBLOCATION, QGlib::Value::create(value));
 }
 
@@ -871,7 +1011,7 @@ double TagList::geoLocationMovementSpeed() const
 
 void TagList::setGeoLocationMovementSpeed(double value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                      GST_TAG_GEO_LOCATION_MOVEMENT_SPEED, value, NULL);
 }
 
@@ -882,7 +1022,7 @@ double TagList::geoLocationMovementDirection() const
 
 void TagList::setGeoLocationMovementDirection(double value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                      GST_TAG_GEO_LOCATION_MOVEMENT_DIRECTION, value, NULL);
 }
 
@@ -893,7 +1033,7 @@ double TagList::geoLocationCaptureDirection() const
 
 void TagList::setGeoLocationCaptureDirector(double value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                      GST_TAG_GEO_LOCATION_CAPTURE_DIRECTION, value, NULL);
 }
 
@@ -904,7 +1044,7 @@ QString TagList::showName(int index) const
 
 void TagList::setShowName(const QString & value, TagMergeMode mode)
 {
-    gst_tag_list_add_value(d->taglist, static_cast<GstTagMergeMode>(mode),
+    gst_tag_list_add_value(writableTagList(), static_cast<GstTagMergeMode>(mode),
                            GST_TAG_SHOW_NAME, QGlib::Value::create(value));
 }
 
@@ -920,7 +1060,7 @@ QString TagList::showSortName() const
 
 void TagList::setShowSortName(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_SHOW_SORTNAME, QGlib::Value::create(value));
 }
 
@@ -931,7 +1071,7 @@ quint32 TagList::showEpisodeNumber() const
 
 void TagList::setShowEpisodeNumber(quint32 value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_SHOW_EPISODE_NUMBER, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_SHOW_EPISODE_NUMBER, value, NULL);
 }
 
 quint32 TagList::showSeasonNumber() const
@@ -941,7 +1081,7 @@ quint32 TagList::showSeasonNumber() const
 
 void TagList::setShowSeasonNumber(quint32 value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_SHOW_SEASON_NUMBER, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_SHOW_SEASON_NUMBER, value, NULL);
 }
 
 QString TagList::lyrics(int index) const
@@ -951,7 +1091,7 @@ QString TagList::lyrics(int index) const
 
 void TagList::setLyrics(const QString & value, TagMergeMode mode)
 {
-    gst_tag_list_add_value(d->taglist, static_cast<GstTagMergeMode>(mode),
+    gst_tag_list_add_value(writableTagList(), static_cast<GstTagMergeMode>(mode),
                            GST_TAG_LYRICS, QGlib::Value::create(value));
 }
 
@@ -967,7 +1107,7 @@ QString TagList::composerSortName() const
 
 void TagList::setComposerSortName(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_COMPOSER_SORTNAME, QGlib::Value::create(value));
 }
 
@@ -978,7 +1118,7 @@ QString TagList::grouping() const
 
 void TagList::setGrouping(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_GROUPING, QGlib::Value::create(value));
 }
 
@@ -989,7 +1129,7 @@ quint32 TagList::userRating() const
 
 void TagList::setUserRating(quint32 value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_USER_RATING, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_USER_RATING, value, NULL);
 }
 
 QString TagList::deviceManufacturer() const
@@ -999,7 +1139,7 @@ QString TagList::deviceManufacturer() const
 
 void TagList::setDeviceManufacturer(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_DEVICE_MANUFACTURER, QGlib::Value::create(value));
 }
 
@@ -1010,7 +1150,7 @@ QString TagList::deviceModel() const
 
 void TagList::setDeviceModel(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_DEVICE_MODEL, QGlib::Value::create(value));
 }
 
@@ -1021,7 +1161,7 @@ QString TagList::imageOrientation() const
 
 void TagList::setImageOrientation(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_IMAGE_ORIENTATION, QGlib::Value::create(value));
 }
 
@@ -1032,7 +1172,7 @@ double TagList::geoLocationHorizontalError() const
 
 void TagList::setGeoLocationHorizontalError(double value)
 {
-    gst_tag_list_add(d->taglist, GST_TAG_MERGE_REPLACE_ALL, GST_TAG_GEO_LOCATION_HORIZONTAL_ERROR, value, NULL);
+    gst_tag_list_add(writableTagList(), GST_TAG_MERGE_REPLACE_ALL, GST_TAG_GEO_LOCATION_HORIZONTAL_ERROR, value, NULL);
 }
 
 QString TagList::applicationName() const
@@ -1042,7 +1182,7 @@ QString TagList::applicationName() const
 
 void TagList::setApplicationName(const QString & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_APPLICATION_NAME, QGlib::Value::create(value));
 }
 
@@ -1053,7 +1193,7 @@ SamplePtr TagList::applicationData() const
 
 void TagList::setApplicationData(const SamplePtr & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_APPLICATION_DATA, QGlib::Value::create(value));
 }
 
@@ -1064,7 +1204,7 @@ QDateTime TagList::dateTime() const
 
 void TagList::setDateTime(const QDateTime & value)
 {
-    gst_tag_list_add_value(d->taglist, GST_TAG_MERGE_REPLACE_ALL,
+    gst_tag_list_add_value(writableTagList(), GST_TAG_MERGE_REPLACE_ALL,
                            GST_TAG_DATE_TIME, QGlib::Value::create(value));
 }
 
@@ -28,6 +28,35 @@ class QDateTime;
 
 namespace QGst {
 
+/*! \headerfile taglist.h <QGst/TagList>
+ * \brief The most commonly used tags of a TagList
+ *
+ * This is filled by TagList::commonTags() with the first value of each tag.
+ * Tags that are not present in the list are left empty or zero.
+ */
+struct QTGSTREAMER_EXPORT CommonTags
+{
+    CommonTags();
+
+    QString title;
+    QString artist;
+    QString album;
+    QString genre;
+    QString comment;
+    QString codec;
+    QString videoCodec;
+    QString audioCodec;
+    QString containerFormat;
+    QString languageCode;
+    quint32 trackNumber;
+    quint32 trackCount;
+    quint32 bitrate;
+    quint32 nominalBitrate;
+    quint64 duration;
+    /*! The number of GST_TAG_IMAGE values in the list. */
+    int imageCount;
+};
+
 /*! \headerfile taglist.h <QGst/TagList>
  * \brief Wrapper class for GstTagList
  *
@@ -64,6 +93,12 @@ namespace QGst {
  * tl.setAuthor("George", QGst::TagMergeReplaceAll); //now there is only one author, "George"
  * \endcode
  *
+ * Copies of a TagList, as well as TagLists constructed from a GstTagList, share the
+ * underlying GstTagList by reference. The native list is only copied when one of the
+ * sharing copies is modified, so passing tags around, for example from a TagMessage,
+ * does not copy them. To read many tags at once, use commonTags(), which visits the
+ * native list only once instead of looking up each tag separately.
+ *
  * \note This class is implicitly shared.
  */
 
@@ -91,9 +126,15 @@ public:
     void clear();
     void removeTag(const char *tag);
 
+    /*! Returns the native list, copying it first if it is shared with another owner. */
     operator GstTagList*();
     operator const GstTagList*() const;
 
+    /*! Extracts the common tags in a single pass over the list.
+     * This is considerably cheaper than calling the individual helpers
+     * below for each of these tags. */
+    CommonTags commonTags() const;
+
     //Begin helpers
 
     QString title(int index = 0) const;
@@ -336,6 +377,8 @@ public:
     void setGeoLocationHorizontalError(double value);
 
 private:
+    GstTagList *writableTagList();
+
     struct Data;
     QSharedDataPointer<Data> d;
 };
@@ -0,0 +1,153 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "videoframe.h"
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+namespace QGst {
+
+static inline GstVideoFrame *videoFrame(void *frame)
+{
+    return static_cast<GstVideoFrame*>(frame);
+}
+
+VideoFrame::VideoFrame()
+    : m_frame(g_slice_new0(GstVideoFrame)), m_mapped(false)
+{
+}
+
+VideoFrame::VideoFrame(const SamplePtr & sample, MapFlags flags)
+    : m_frame(g_slice_new0(GstVideoFrame)), m_mapped(false)
+{
+    map(sample, flags);
+}
+
+VideoFrame::VideoFrame(const BufferPtr & buffer, const CapsPtr & caps, MapFlags flags)
+    : m_frame(g_slice_new0(GstVideoFrame)), m_mapped(false)
+{
+    map(buffer, caps, flags);
+}
+
+VideoFrame::~VideoFrame()
+{
+    unmap();
+    g_slice_free(GstVideoFrame, videoFrame(m_frame));
+}
+
+bool VideoFrame::map(const SamplePtr & sample, MapFlags flags)
+{
+    if (!sample) {
+        unmap();
+        return false;
+    }
+    return map(sample->buffer(), sample->caps(), flags);
+}
+
+bool VideoFrame::map(const BufferPtr & buffer, const CapsPtr & caps, MapFlags flags)
+{
+    unmap();
+
+    GstVideoInfo info;
+    if (!buffer || !caps || !gst_video_info_from_caps(&info, caps)) {
+        return false;
+    }
+
+    //gst_video_frame_map() keeps its own reference to the buffer while mapped
+    m_mapped = gst_video_frame_map(videoFrame(m_frame), &info, buffer,
+                                   static_cast<GstMapFlags>(static_cast<int>(flags)));
+    return m_mapped;
+}
+
+void VideoFrame::unmap()
+{
+    if (m_mapped) {
+        gst_video_frame_unmap(videoFrame(m_frame));
+        m_mapped = false;
+    }
+}
+
+bool VideoFrame::isValid() const
+{
+    return m_mapped;
+}
+
+BufferPtr VideoFrame::buffer() const
+{
+    return m_mapped ? BufferPtr::wrap(videoFrame(m_frame)->buffer) : BufferPtr();
+}
+
+MapFlags VideoFrame::flags() const
+{
+    return m_mapped ? MapFlags(static_cast<int>(videoFrame(m_frame)->map[0].flags)) : MapFlags();
+}
+
+int VideoFrame::width() const
+{
+    return m_mapped ? GST_VIDEO_FRAME_WIDTH(videoFrame(m_frame)) : 0;
+}
+
+int VideoFrame::height() const
+{
+    return m_mapped ? GST_VIDEO_FRAME_HEIGHT(videoFrame(m_frame)) : 0;
+}
+
+const char *VideoFrame::formatName() const
+{
+    return m_mapped ? GST_VIDEO_INFO_NAME(&videoFrame(m_frame)->info) : NULL;
+}
+
+size_t VideoFrame::size() const
+{
+    return m_mapped ? GST_VIDEO_FRAME_SIZE(videoFrame(m_frame)) : 0;
+}
+
+uint VideoFrame::planeCount() const
+{
+    return m_mapped ? GST_VIDEO_FRAME_N_PLANES(videoFrame(m_frame)) : 0;
+}
+
+VideoPlane VideoFrame::plane(uint index) const
+{
+    if (index >= planeCount()) {
+        return VideoPlane();
+    }
+    GstVideoFrame *frame = videoFrame(m_frame);
+    return VideoPlane(static_cast<quint8*>(GST_VIDEO_FRAME_PLANE_DATA(frame, index)),
+                      GST_VIDEO_FRAME_PLANE_STRIDE(frame, index));
+}
+
+uint VideoFrame::componentCount() const
+{
+    return m_mapped ? GST_VIDEO_FRAME_N_COMPONENTS(videoFrame(m_frame)) : 0;
+}
+
+VideoComponent VideoFrame::component(uint index) const
+{
+    if (index >= componentCount()) {
+        return VideoComponent();
+    }
+    GstVideoFrame *frame = videoFrame(m_frame);
+    return VideoComponent(static_cast<quint8*>(GST_VIDEO_FRAME_COMP_DATA(frame, index)),
+                          GST_VIDEO_FRAME_COMP_STRIDE(frame, index),
+                          GST_VIDEO_FRAME_COMP_PSTRIDE(frame, index),
+                          GST_VIDEO_FRAME_COMP_WIDTH(frame, index),
+                          GST_VIDEO_FRAME_COMP_HEIGHT(frame, index),
+                          GST_VIDEO_FRAME_COMP_DEPTH(frame, index),
+                          GST_VIDEO_FRAME_COMP_PLANE(frame, index));
+}
+
+} //namespace QGst
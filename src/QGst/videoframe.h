@@ -0,0 +1,156 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef QGST_VIDEOFRAME_H
+#define QGST_VIDEOFRAME_H
+
+#include "global.h"
+#include "buffer.h"
+#include "caps.h"
+#include "sample.h"
+
+namespace QGst {
+
+/*! \headerfile videoframe.h <QGst/VideoFrame>
+ * \brief A view of one plane of a mapped VideoFrame
+ *
+ * The lines of the plane start every stride() bytes, which may be
+ * more than the size of the visible pixels of a line.
+ */
+class VideoPlane
+{
+public:
+    inline VideoPlane() : m_data(NULL), m_stride(0) {}
+    inline VideoPlane(quint8 *data, int stride) : m_data(data), m_stride(stride) {}
+
+    inline bool isNull() const { return m_data == NULL; }
+    inline quint8 *data() const { return m_data; }
+    inline int stride() const { return m_stride; }
+    /*! Returns a pointer to the start of line \a y of the plane. */
+    inline quint8 *line(int y) const { return m_data + y * m_stride; }
+
+private:
+    quint8 *m_data;
+    int m_stride;
+};
+
+/*! \headerfile videoframe.h <QGst/VideoFrame>
+ * \brief A view of one color component (e.g. Y, U, V, R, G, B or alpha) of a mapped VideoFrame
+ *
+ * data() points to the first sample of the component, which may be in the middle of
+ * a plane that holds several interleaved components. The sample at (x, y) is found at
+ * data() + y * stride() + x * pixelStride().
+ */
+class VideoComponent
+{
+public:
+    inline VideoComponent()
+        : m_data(NULL), m_stride(0), m_pixelStride(0), m_width(0), m_height(0),
+          m_depth(0), m_plane(0) {}
+    inline VideoComponent(quint8 *data, int stride, int pixelStride, int width, int height,
+                          int depth, uint plane)
+        : m_data(data), m_stride(stride), m_pixelStride(pixelStride), m_width(width),
+          m_height(height), m_depth(depth), m_plane(plane) {}
+
+    inline bool isNull() const { return m_data == NULL; }
+    inline quint8 *data() const { return m_data; }
+    inline int stride() const { return m_stride; }
+    /*! Returns the distance in bytes between two horizontally adjacent samples. */
+    inline int pixelStride() const { return m_pixelStride; }
+    /*! Returns the width of the component, which is smaller than the width of
+     * the frame for subsampled components, such as the chroma of I420. */
+    inline int width() const { return m_width; }
+    inline int height() const { return m_height; }
+    /*! Returns the number of bits of each sample. */
+    inline int depth() const { return m_depth; }
+    /*! Returns the index of the plane that holds this component. */
+    inline uint plane() const { return m_plane; }
+
+private:
+    quint8 *m_data;
+    int m_stride;
+    int m_pixelStride;
+    int m_width;
+    int m_height;
+    int m_depth;
+    uint m_plane;
+};
+
+/*! \headerfile videoframe.h <QGst/VideoFrame>
+ * \brief Wrapper class for GstVideoFrame
+ *
+ * VideoFrame maps the data of a raw video buffer and describes the layout of its planes,
+ * as given by the buffer's video metadata if it has any, or as derived from the caps
+ * otherwise. This takes care of padded frames, such as the output of many hardware
+ * decoders, where the planes do not start where a tightly packed layout would put them.
+ *
+ * The frame is unmapped when the VideoFrame is destroyed:
+ * \code
+ * QGst::SamplePtr sample = appSink.pullSample();
+ * QGst::VideoFrame frame(sample);
+ * if (frame.isValid()) {
+ *     QGst::VideoComponent luma = frame.component(0);
+ *     for (int y = 0; y < luma.height(); ++y) {
+ *         processLine(luma.data() + y * luma.stride(), luma.width());
+ *     }
+ * }
+ * \endcode
+ *
+ * Mapping for reading does not copy the data, even if the buffer is shared.
+ * Mapping for writing requires a writable buffer.
+ */
+class QTGSTREAMER_EXPORT VideoFrame
+{
+public:
+    VideoFrame();
+    /*! Maps the buffer of \a sample, using the caps of the sample to describe it. */
+    explicit VideoFrame(const SamplePtr & sample, MapFlags flags = MapRead);
+    /*! Maps \a buffer, which holds a frame in the raw video format described by \a caps. */
+    VideoFrame(const BufferPtr & buffer, const CapsPtr & caps, MapFlags flags = MapRead);
+    ~VideoFrame();
+
+    bool map(const SamplePtr & sample, MapFlags flags = MapRead);
+    bool map(const BufferPtr & buffer, const CapsPtr & caps, MapFlags flags = MapRead);
+    void unmap();
+
+    /*! Returns true if a frame is currently mapped. */
+    bool isValid() const;
+
+    BufferPtr buffer() const;
+    MapFlags flags() const;
+
+    int width() const;
+    int height() const;
+    /*! Returns the name of the video format, e.g. "I420" or "RGBA". */
+    const char *formatName() const;
+    /*! Returns the size of the frame in bytes. */
+    size_t size() const;
+
+    uint planeCount() const;
+    VideoPlane plane(uint index) const;
+
+    uint componentCount() const;
+    VideoComponent component(uint index) const;
+
+private:
+    Q_DISABLE_COPY(VideoFrame)
+    void *m_frame;
+    bool m_mapped;
+};
+
+} //namespace QGst
+
+#endif
@@ -19,6 +19,55 @@
 #include <QGlib/Error>
 #include <QGst/Allocator>
 #include <QGst/Memory>
+#include <cstring>
+
+struct Counters
+{
+    int allocs;
+    int frees;
+    int maps;
+    int unmaps;
+    bool destroyed;
+};
+
+class CountingAllocator : public QGst::CustomAllocator
+{
+public:
+    explicit CountingAllocator(Counters *counters)
+        : QGst::CustomAllocator("CountingMemory"), m_counters(counters) {}
+    virtual ~CountingAllocator() { m_counters->destroyed = true; }
+
+protected:
+    virtual bool alloc(Block & block, size_t size, size_t align)
+    {
+        Q_UNUSED(align);
+        block.data = new quint8[size];
+        block.size = size;
+        m_counters->allocs++;
+        return true;
+    }
+
+    virtual void free(Block & block)
+    {
+        delete [] block.data;
+        m_counters->frees++;
+    }
+
+    virtual quint8 *map(Block & block, QGst::MapFlags flags)
+    {
+        m_counters->maps++;
+        return QGst::CustomAllocator::map(block, flags);
+    }
+
+    virtual void unmap(Block & block)
+    {
+        Q_UNUSED(block);
+        m_counters->unmaps++;
+    }
+
+private:
+    Counters *m_counters;
+};
 
 class AllocatorTest : public QGstTest
 {
@@ -27,6 +76,7 @@ private Q_SLOTS:
 
     void testAllocationParams();
     void testAllocator();
+    void testCustomAllocator();
 };
 
 void AllocatorTest::testAllocationParams()
@@ -79,6 +129,91 @@ void AllocatorTest::testAllocator()
     system->free(mem);
 }
 
+void AllocatorTest::testCustomAllocator()
+{
+    Counters counters = { 0, 0, 0, 0, false };
+    QGst::AllocatorPtr allocator = QGst::CustomAllocator::create(new CountingAllocator(&counters));
+    QVERIFY(allocator);
+    QVERIFY(QGst::CustomAllocator::fromAllocator(allocator));
+    QVERIFY(!QGst::CustomAllocator::fromAllocator(QGst::Allocator::getSystemMemory()));
+
+    QGst::AllocationParams params;
+    params.setAlign(63);
+    params.setPrefix(8);
+    params.setPadding(8);
+    params.setFlags(QGst::MemoryFlagZeroPrefixed | QGst::MemoryFlagZeroPadded);
+
+    QGst::MemoryPtr mem = allocator->alloc(100, params);
+    QVERIFY(mem);
+    QCOMPARE(counters.allocs, 1);
+    QVERIFY(mem->isType("CountingMemory"));
+    QCOMPARE(mem->size(), static_cast<size_t>(100));
+    QCOMPARE(mem->offset(), static_cast<size_t>(8));
+    QCOMPARE(mem->maxSize(), static_cast<size_t>(116));
+
+    {
+        QGst::MapInfo info;
+        QVERIFY(mem->map(info, QGst::MapWrite));
+        quint8 *start = info.data() - mem->offset();
+        QCOMPARE(reinterpret_cast<quintptr>(start) & 63, static_cast<quintptr>(0));
+        QCOMPARE(start[0], static_cast<quint8>(0));
+        QCOMPARE(info.data()[100], static_cast<quint8>(0));
+        memset(info.data(), 'x', 100);
+        info.data()[10] = 'y';
+        mem->unmap(info);
+    }
+
+    //sharing does not allocate
+    GstMemory *shared = gst_memory_share(mem, 10, 20);
+    QVERIFY(shared);
+    QCOMPARE(counters.allocs, 1);
+    QCOMPARE(shared->size, static_cast<gsize>(20));
+    {
+        GstMapInfo info;
+        QVERIFY(gst_memory_map(shared, &info, GST_MAP_READ));
+        QCOMPARE(info.data[0], static_cast<guint8>('y'));
+        gst_memory_unmap(shared, &info);
+    }
+
+    GstMemory *next = gst_memory_share(mem, 40, 20);
+    gsize offset;
+    QVERIFY(!gst_memory_is_span(shared, next, &offset));
+    gst_memory_unref(next);
+    next = gst_memory_share(mem, 10 + 20, -1);
+    QCOMPARE(next->size, static_cast<gsize>(70));
+    QVERIFY(gst_memory_is_span(shared, next, &offset));
+    QCOMPARE(offset, static_cast<gsize>(10));
+    gst_memory_unref(next);
+
+    gst_memory_unref(shared);
+    QCOMPARE(counters.frees, 0);
+
+    //copying allocates from the same allocator
+    GstMemory *copied = gst_memory_copy(mem, 10, 20);
+    QVERIFY(copied);
+    QCOMPARE(counters.allocs, 2);
+    QCOMPARE(copied->allocator, static_cast<GstAllocator*>(allocator));
+    {
+        GstMapInfo info;
+        QVERIFY(gst_memory_map(copied, &info, GST_MAP_READ));
+        QCOMPARE(info.size, static_cast<gsize>(20));
+        QCOMPARE(info.data[0], static_cast<guint8>('y'));
+        QCOMPARE(info.data[1], static_cast<guint8>('x'));
+        gst_memory_unmap(copied, &info);
+    }
+    gst_memory_unref(copied);
+    QCOMPARE(counters.frees, 1);
+
+    mem.clear();
+    QCOMPARE(counters.frees, 2);
+    QCOMPARE(counters.maps, counters.unmaps);
+
+    //the implementation lives as long as the GstAllocator
+    QVERIFY(!counters.destroyed);
+    allocator.clear();
+    QVERIFY(counters.destroyed);
+}
+
 QTEST_APPLESS_MAIN(AllocatorTest)
 
 #include "moc_qgsttest.cpp"
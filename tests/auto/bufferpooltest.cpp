@@ -0,0 +1,135 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "qgsttest.h"
+#include <QGst/BufferPool>
+
+class BufferPoolTest : public QGstTest
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void configTest();
+    void recycleTest();
+    void dontWaitTest();
+    void videoPoolTest();
+};
+
+void BufferPoolTest::configTest()
+{
+    QGst::BufferPoolPtr pool = QGst::BufferPool::create();
+    QVERIFY(!pool.isNull());
+    QVERIFY(!pool->isActive());
+
+    QGst::CapsPtr caps = QGst::Caps::fromString("audio/x-raw");
+    QGst::AllocationParams params;
+    params.setAlign(15);
+
+    QGst::BufferPoolConfig config = pool->config();
+    config.setParams(caps, 1024, 2, 4);
+    config.setAllocator(QGst::Allocator::getSystemMemory(), params);
+    QVERIFY(pool->setConfig(config));
+
+    config = pool->config();
+    QVERIFY(config.caps()->equals(caps));
+    QCOMPARE(config.size(), 1024U);
+    QCOMPARE(config.minBuffers(), 2U);
+    QCOMPARE(config.maxBuffers(), 4U);
+    QCOMPARE(config.allocationParams().align(), (size_t) 15);
+
+    QVERIFY(pool->setActive(true));
+    QVERIFY(pool->isActive());
+    //the configuration of an active pool is read-only
+    QVERIFY(!pool->setConfig(config));
+    QVERIFY(pool->setActive(false));
+}
+
+void BufferPoolTest::recycleTest()
+{
+    QGst::BufferPoolPtr pool = QGst::BufferPool::create();
+    QGst::BufferPoolConfig config = pool->config();
+    config.setParams(QGst::CapsPtr(), 100, 1, 1);
+    QVERIFY(pool->setConfig(config));
+    QVERIFY(pool->setActive(true));
+
+    QGst::BufferPtr buffer = pool->acquireBuffer();
+    QVERIFY(!buffer.isNull());
+    QCOMPARE(buffer->size(), (quint32) 100);
+    GstBuffer *first = buffer;
+
+    //dropping the last reference returns the buffer to the pool
+    buffer.clear();
+    buffer = pool->acquireBuffer();
+    QCOMPARE(static_cast<GstBuffer*>(buffer), first);
+
+    buffer.clear();
+    QVERIFY(pool->setActive(false));
+}
+
+void BufferPoolTest::dontWaitTest()
+{
+    QGst::BufferPoolPtr pool = QGst::BufferPool::create();
+    QGst::BufferPoolConfig config = pool->config();
+    config.setParams(QGst::CapsPtr(), 100, 1, 1);
+    QVERIFY(pool->setConfig(config));
+
+    QGst::FlowReturn result = QGst::FlowOk;
+    QVERIFY(pool->acquireBuffer(QGst::BufferPoolAcquireFlagNone, &result).isNull());
+    QCOMPARE(result, QGst::FlowFlushing);
+
+    QVERIFY(pool->setActive(true));
+    QGst::BufferPtr buffer = pool->acquireBuffer();
+    QVERIFY(!buffer.isNull());
+
+    QVERIFY(pool->acquireBuffer(QGst::BufferPoolAcquireFlagDontWait, &result).isNull());
+    QCOMPARE(result, QGst::FlowEos);
+
+    buffer.clear();
+    QVERIFY(!pool->acquireBuffer(QGst::BufferPoolAcquireFlagDontWait, &result).isNull());
+    QCOMPARE(result, QGst::FlowOk);
+    QVERIFY(pool->setActive(false));
+}
+
+void BufferPoolTest::videoPoolTest()
+{
+    QVERIFY(QGst::VideoBufferPool::create(QGst::Caps::fromString("audio/x-raw")).isNull());
+
+    QGst::CapsPtr caps = QGst::Caps::fromString("video/x-raw, format=(string)RGBA, "
+                                                "width=(int)320, height=(int)240, "
+                                                "framerate=(fraction)30/1");
+    QGst::VideoBufferPoolPtr pool = QGst::VideoBufferPool::create(caps, 2, 4);
+    QVERIFY(!pool.isNull());
+    QVERIFY(pool->hasOption("GstBufferPoolOptionVideoMeta"));
+
+    QGst::BufferPoolConfig config = pool->config();
+    QVERIFY(config.hasOption("GstBufferPoolOptionVideoMeta"));
+    QCOMPARE(config.size(), 320U * 240U * 4U);
+
+    config.setVideoAlignment(0, 0, 0, 0, 31);
+    QVERIFY(config.hasOption("GstBufferPoolOptionVideoAlignment"));
+    QVERIFY(pool->setConfig(config));
+
+    QVERIFY(pool->setActive(true));
+    QGst::BufferPtr buffer = pool->acquireBuffer();
+    QVERIFY(!buffer.isNull());
+    QVERIFY(buffer->size() >= 320U * 240U * 4U);
+    buffer.clear();
+    QVERIFY(pool->setActive(false));
+}
+
+QTEST_APPLESS_MAIN(BufferPoolTest)
+
+#include "moc_qgsttest.cpp"
+#include "bufferpooltest.moc"
@@ -28,6 +28,12 @@ private Q_SLOTS:
     void flagsTest();
     void copyTest();
     void memoryPeekTest();
+    void wrapTest();
+    void fromDataTest();
+    void composeTest();
+
+private:
+    static void onDataReleased(void *userData) { ++*static_cast<int*>(userData); }
 };
 
 void BufferTest::simpleTest()
@@ -88,6 +94,64 @@ void BufferTest::memoryPeekTest()
     QVERIFY(m->isWritable());
 
 }
+
+void BufferTest::wrapTest()
+{
+    char data[16] = "wrapped data";
+    int released = 0;
+
+    QGst::BufferPtr buffer = QGst::Buffer::wrap(data, sizeof(data), QGst::MemoryFlags(),
+                                                &BufferTest::onDataReleased, &released);
+    QCOMPARE(buffer->size(), (quint32) sizeof(data));
+
+    QGst::MapInfo info;
+    QVERIFY(buffer->map(info, QGst::MapRead));
+    QCOMPARE(static_cast<void*>(info.data()), static_cast<void*>(data));
+    buffer->unmap(info);
+
+    QCOMPARE(released, 0);
+    buffer.clear();
+    QCOMPARE(released, 1);
+}
+
+void BufferTest::fromDataTest()
+{
+    QByteArray data("shared payload");
+    QGst::BufferPtr buffer = QGst::Buffer::fromData(data);
+    QCOMPARE(buffer->size(), (quint32) data.size());
+
+    //the buffer must share the data of the byte array instead of copying it
+    QGst::MapInfo info;
+    QVERIFY(buffer->map(info, QGst::MapRead));
+    QCOMPARE(reinterpret_cast<const char*>(info.data()), data.constData());
+    buffer->unmap(info);
+
+    //and it must keep it alive after the original is gone
+    data = QByteArray();
+    char bytes[14];
+    QCOMPARE(buffer->extract(0, bytes, sizeof(bytes)), (uint) sizeof(bytes));
+    QCOMPARE(QByteArray(bytes, sizeof(bytes)), QByteArray("shared payload"));
+}
+
+void BufferTest::composeTest()
+{
+    QGst::BufferPtr buffer = QGst::Buffer::create(0);
+    const uint initialCount = buffer->memoryCount();
+
+    buffer->appendMemory(QGst::Memory::fromData("world"));
+    buffer->insertMemory(initialCount, QGst::Memory::fromData("hello "));
+    QCOMPARE(buffer->memoryCount(), initialCount + 2);
+    QCOMPARE(buffer->size(), (quint32) 11);
+
+    char bytes[11];
+    buffer->extract(0, bytes, sizeof(bytes));
+    QCOMPARE(QByteArray(bytes, sizeof(bytes)), QByteArray("hello world"));
+
+    buffer->replaceMemory(initialCount + 1, QGst::Memory::fromData("there"));
+    buffer->extract(0, bytes, sizeof(bytes));
+    QCOMPARE(QByteArray(bytes, sizeof(bytes)), QByteArray("hello there"));
+}
+
 QTEST_APPLESS_MAIN(BufferTest)
 
 #include "moc_qgsttest.cpp"
@@ -20,17 +20,68 @@
 #include <QGst/Structure>
 #include <QGst/Message>
 
+struct ElementMessageDropper
+{
+    explicit ElementMessageDropper(int *seen) : m_seen(seen) {}
+    QGst::BusSyncReply operator()(QGst::Message *message)
+    {
+        ++*m_seen;
+        //the message has the class of its type, like the wrappers of MessagePtr::wrap()
+        return dynamic_cast<QGst::ElementMessage*>(message) ? QGst::BusDrop : QGst::BusPass;
+    }
+    int *m_seen;
+};
+
+struct CountingDropper
+{
+    explicit CountingDropper(QAtomicInt *seen) : m_seen(seen) {}
+    QGst::BusSyncReply operator()(QGst::Message *)
+    {
+        m_seen->ref();
+        return QGst::BusDrop;
+    }
+    QAtomicInt *m_seen;
+};
+
+class ElementPostThread : public QThread
+{
+public:
+    QGst::BusPtr bus;
+    enum { MessageCount = 1000 };
+
+private:
+    virtual void run()
+    {
+        for (int i = 0; i < MessageCount; ++i) {
+            bus->post(QGst::ElementMessage::create(bus, QGst::Structure("dropped")));
+        }
+    }
+};
+
 class BusTest : public QGstTest
 {
     Q_OBJECT
 private:
     void messageClosure(const QGst::MessagePtr &);
+    QGst::BusSyncReply countingSyncHandler(QGst::Message *message);
 
 private Q_SLOTS:
     void watchTest();
     void watchTestWithWatchRemoval();
+    void syncHandlerTest();
+    void syncHandlerReplaceTest();
+    void watchFilterTest();
+    void watchCoalescingTest();
+    void watchNoTypesTest();
 
 private:
+    void countingClosure(const QGst::MessagePtr &);
+    void batchHandler(const QList<QGst::MessagePtr> & messages);
+    void runEventLoop();
+
+    QList<QGst::MessagePtr> m_batch;
+    int m_batches;
+
     QEventLoop m_eventLoop;
     int m_messagesReceived;
 };
@@ -120,6 +171,171 @@ void BusTest::watchTestWithWatchRemoval()
     thread.bus->removeSignalWatch();
 }
 
+QGst::BusSyncReply BusTest::countingSyncHandler(QGst::Message *message)
+{
+    Q_UNUSED(message);
+    ++m_messagesReceived;
+    return QGst::BusPass;
+}
+
+//The sync handler is called from post(), before the message is queued
+void BusTest::syncHandlerTest()
+{
+    QGst::BusPtr bus = QGst::Bus::create();
+
+    int seen = 0;
+    bus->setSyncHandler(ElementMessageDropper(&seen));
+    bus->post(QGst::ElementMessage::create(bus, QGst::Structure("dropped")));
+    bus->post(QGst::ApplicationMessage::create(bus, QGst::Structure("passed")));
+    QCOMPARE(seen, 2);
+
+    QGst::MessagePtr msg = bus->pop();
+    QVERIFY(!msg.isNull());
+    QCOMPARE(msg->type(), QGst::MessageApplication);
+    QVERIFY(bus->pop().isNull());
+
+    //a new handler replaces the previous one
+    m_messagesReceived = 0;
+    bus->setSyncHandler(this, &BusTest::countingSyncHandler);
+    bus->post(QGst::ElementMessage::create(bus, QGst::Structure("passed")));
+    QCOMPARE(m_messagesReceived, 1);
+    QCOMPARE(seen, 2);
+    QVERIFY(!bus->pop().isNull());
+
+    bus->unsetSyncHandler();
+    bus->post(QGst::ElementMessage::create(bus, QGst::Structure("passed")));
+    QCOMPARE(m_messagesReceived, 1);
+    QVERIFY(!bus->pop().isNull());
+}
+
+//Replacing the handler while another thread posts must not let any message
+//through without a handler; each one is dropped by either the old or the new one
+void BusTest::syncHandlerReplaceTest()
+{
+    ElementPostThread thread;
+    thread.bus = QGst::Bus::create();
+
+    QAtomicInt seen(0);
+    thread.bus->setSyncHandler(CountingDropper(&seen));
+    thread.start();
+    while (!thread.isFinished()) {
+        thread.bus->setSyncHandler(CountingDropper(&seen));
+    }
+    thread.wait();
+
+    QCOMPARE(seen.fetchAndAddRelaxed(0), int(ElementPostThread::MessageCount));
+    QVERIFY(!thread.bus->hasPendingMessages());
+    thread.bus->unsetSyncHandler();
+}
+
+void BusTest::countingClosure(const QGst::MessagePtr & msg)
+{
+    QCOMPARE(msg->type(), QGst::MessageApplication);
+    ++m_messagesReceived;
+}
+
+void BusTest::batchHandler(const QList<QGst::MessagePtr> & messages)
+{
+    m_batch = messages;
+    ++m_batches;
+}
+
+void BusTest::runEventLoop()
+{
+    //the messages are already on the bus, so one dispatch is enough
+    QTimer::singleShot(200, &m_eventLoop, SLOT(quit()));
+    m_eventLoop.exec();
+}
+
+void BusTest::watchFilterTest()
+{
+    QGst::BusPtr bus = QGst::Bus::create();
+    m_messagesReceived = 0;
+    bus->addSignalWatch(QGst::MessageApplication);
+    QGlib::connect(bus, "message", this, &BusTest::countingClosure);
+
+    for (int i = 0; i < 5; ++i) {
+        bus->post(QGst::ElementMessage::create(bus, QGst::Structure("ignored")));
+        bus->post(QGst::ApplicationMessage::create(bus, QGst::Structure("delivered")));
+    }
+    runEventLoop();
+
+    QCOMPARE(m_messagesReceived, 5);
+    QVERIFY(!bus->hasPendingMessages()); //the others were discarded
+
+    bus->removeSignalWatch(QGst::MessageApplication);
+}
+
+void BusTest::watchCoalescingTest()
+{
+    QGst::BusPtr bus = QGst::Bus::create();
+    QGst::BusPtr sourceA = QGst::Bus::create();
+    QGst::BusPtr sourceB = QGst::Bus::create();
+
+    m_messagesReceived = 0;
+    m_batches = 0;
+    m_batch.clear();
+    bus->addSignalWatch(QGst::MessageApplication | QGst::MessageElement);
+    QGlib::connect(bus, "message", this, &BusTest::countingClosure);
+    bus->setCoalescingHandler(QGst::MessageElement, this, &BusTest::batchHandler);
+
+    for (int i = 0; i < 10; ++i) {
+        QGst::Structure level("level");
+        level.setValue("sequence", i);
+        bus->post(QGst::ElementMessage::create(sourceA, level));
+        if (i < 5) {
+            bus->post(QGst::ElementMessage::create(sourceB, level));
+        }
+        if (i < 3) {
+            QGst::Structure spectrum("spectrum");
+            spectrum.setValue("sequence", i);
+            bus->post(QGst::ElementMessage::create(sourceA, spectrum));
+        }
+    }
+    bus->post(QGst::ApplicationMessage::create(bus, QGst::Structure("delivered")));
+    runEventLoop();
+
+    QCOMPARE(m_messagesReceived, 1);
+    QCOMPARE(m_batches, 1);
+    QCOMPARE(m_batch.size(), 3);
+
+    //in order of first appearance, each with its latest message
+    QCOMPARE(m_batch[0]->source(), sourceA.staticCast<QGst::Object>());
+    QCOMPARE(m_batch[0]->internalStructure()->name(), QString("level"));
+    QCOMPARE(m_batch[0]->internalStructure()->value("sequence").get<int>(), 9);
+    QCOMPARE(m_batch[1]->source(), sourceB.staticCast<QGst::Object>());
+    QCOMPARE(m_batch[1]->internalStructure()->value("sequence").get<int>(), 4);
+    QCOMPARE(m_batch[2]->internalStructure()->name(), QString("spectrum"));
+    QCOMPARE(m_batch[2]->internalStructure()->value("sequence").get<int>(), 2);
+
+    bus->unsetCoalescingHandler();
+    bus->removeSignalWatch(QGst::MessageApplication | QGst::MessageElement);
+}
+
+//Removing all the types of a watch that is still referenced must not
+//leave the messages on the bus, which would keep the watch busy forever
+void BusTest::watchNoTypesTest()
+{
+    QGst::BusPtr bus = QGst::Bus::create();
+    m_messagesReceived = 0;
+    bus->addSignalWatch(QGst::MessageEos);
+    bus->addSignalWatch(QGst::MessageError);
+    //this keeps the watch alive without asking for any type
+    bus->addSignalWatch(QGst::MessageTypes());
+    QGlib::connect(bus, "message", this, &BusTest::countingClosure);
+
+    bus->removeSignalWatch(QGst::MessageEos);
+    bus->removeSignalWatch(QGst::MessageError);
+
+    bus->post(QGst::ApplicationMessage::create(bus, QGst::Structure("dropped")));
+    runEventLoop();
+
+    QCOMPARE(m_messagesReceived, 0);
+    QVERIFY(!bus->hasPendingMessages());
+
+    bus->removeSignalWatch(QGst::MessageTypes());
+}
+
 QTEST_MAIN(BusTest)
 
 #include "moc_qgsttest.cpp"
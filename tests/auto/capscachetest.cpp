@@ -0,0 +1,173 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "qgsttest.h"
+#include <QGst/CapsCache>
+#include <QtCore/QThread>
+
+class CapsCacheTest : public QGstTest
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void fromStringTest();
+    void intersectionTest();
+    void subsetTest();
+    void evictionTest();
+    void threadTest();
+};
+
+void CapsCacheTest::fromStringTest()
+{
+    QGst::CapsCache cache;
+
+    QGst::CapsPtr caps = cache.fromString("video/x-raw, width=(int)320");
+    QVERIFY(!caps.isNull());
+    QCOMPARE(caps->toString(), QString("video/x-raw, width=(int)320"));
+
+    //the same string returns the same interned object
+    QGst::CapsPtr caps2 = cache.fromString(QString("video/x-raw, width=(int)320"));
+    QCOMPARE(static_cast<GstCaps*>(caps2), static_cast<GstCaps*>(caps));
+
+    //invalid strings are remembered as well
+    QVERIFY(cache.fromString("this is not caps").isNull());
+    QVERIFY(cache.fromString("this is not caps").isNull());
+
+    QGst::CapsCache::Statistics stats = cache.statistics();
+    QCOMPARE(stats.parseMisses, Q_UINT64_C(2));
+    QCOMPARE(stats.parseHits, Q_UINT64_C(2));
+    QCOMPARE(stats.stringEntries, 2);
+
+    cache.resetStatistics();
+    QCOMPARE(cache.statistics().parseHits, Q_UINT64_C(0));
+    QCOMPARE(cache.statistics().stringEntries, 2);
+
+    cache.clear();
+    QCOMPARE(cache.statistics().stringEntries, 0);
+}
+
+void CapsCacheTest::intersectionTest()
+{
+    QGst::CapsCache cache;
+    QGst::CapsPtr raw = cache.fromString("video/x-raw");
+    QGst::CapsPtr sized = cache.fromString("video/x-raw, width=(int)320");
+    QGst::CapsPtr audio = cache.fromString("audio/x-raw");
+
+    QGst::CapsPtr intersection = cache.getIntersection(raw, sized);
+    QVERIFY(intersection->equals(raw->getIntersection(sized)));
+    QCOMPARE(static_cast<GstCaps*>(cache.getIntersection(raw, sized)),
+             static_cast<GstCaps*>(intersection));
+
+    QGst::CapsCache::Statistics stats = cache.statistics();
+    QCOMPARE(stats.intersectionMisses, Q_UINT64_C(1));
+    QCOMPARE(stats.intersectionHits, Q_UINT64_C(1));
+
+    //answered from the known intersection
+    QVERIFY(cache.canIntersect(sized, raw));
+    QCOMPARE(cache.statistics().intersectionHits, Q_UINT64_C(2));
+
+    QVERIFY(!cache.canIntersect(raw, audio));
+    QVERIFY(!cache.canIntersect(audio, raw));
+    stats = cache.statistics();
+    QCOMPARE(stats.intersectionMisses, Q_UINT64_C(2));
+    QCOMPARE(stats.intersectionHits, Q_UINT64_C(3));
+
+    QVERIFY(cache.getIntersection(raw, audio)->isEmpty());
+    QVERIFY(cache.getIntersection(raw, QGst::CapsPtr()).isNull());
+    QVERIFY(!cache.canIntersect(QGst::CapsPtr(), audio));
+}
+
+void CapsCacheTest::subsetTest()
+{
+    QGst::CapsCache cache;
+    QGst::CapsPtr raw = cache.fromString("video/x-raw");
+    QGst::CapsPtr sized = cache.fromString("video/x-raw, width=(int)320");
+
+    QVERIFY(cache.isSubset(sized, raw));
+    QVERIFY(!cache.isSubset(raw, sized));
+    QVERIFY(cache.isSubset(sized, raw));
+
+    QGst::CapsCache::Statistics stats = cache.statistics();
+    QCOMPARE(stats.subsetMisses, Q_UINT64_C(2));
+    QCOMPARE(stats.subsetHits, Q_UINT64_C(1));
+    QCOMPARE(stats.pairEntries, 2);
+}
+
+void CapsCacheTest::evictionTest()
+{
+    QGst::CapsCache cache(2);
+    QCOMPARE(cache.capacity(), 2);
+
+    QGst::CapsPtr first = cache.fromString("video/x-raw");
+    cache.fromString("audio/x-raw");
+    cache.fromString("video/x-raw"); //now "audio/x-raw" is the least recently used
+    cache.fromString("text/x-raw");
+    QCOMPARE(cache.statistics().stringEntries, 2);
+
+    cache.resetStatistics();
+    QCOMPARE(static_cast<GstCaps*>(cache.fromString("video/x-raw")), static_cast<GstCaps*>(first));
+    cache.fromString("audio/x-raw");
+    QCOMPARE(cache.statistics().parseHits, Q_UINT64_C(1));
+    QCOMPARE(cache.statistics().parseMisses, Q_UINT64_C(1));
+
+    //evicted caps remain valid for whoever holds them
+    cache.setCapacity(0);
+    QCOMPARE(cache.statistics().stringEntries, 0);
+    QCOMPARE(first->toString(), QString("video/x-raw"));
+}
+
+class CapsCacheThread : public QThread
+{
+public:
+    CapsCacheThread(QGst::CapsCache *cache) : m_cache(cache), m_ok(true) {}
+
+    virtual void run()
+    {
+        for (int i = 0; i < 1000; ++i) {
+            QGst::CapsPtr a = m_cache->fromString(QString("video/x-raw, width=(int)%1").arg(i % 10));
+            QGst::CapsPtr b = m_cache->fromString("video/x-raw");
+            m_ok = m_ok && m_cache->canIntersect(a, b) && m_cache->isSubset(a, b)
+                        && !m_cache->getIntersection(a, b)->isEmpty();
+        }
+    }
+
+    QGst::CapsCache *m_cache;
+    bool m_ok;
+};
+
+void CapsCacheTest::threadTest()
+{
+    QGst::CapsCache cache(8);
+    QList<CapsCacheThread*> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.append(new CapsCacheThread(&cache));
+        threads.last()->start();
+    }
+    Q_FOREACH(CapsCacheThread *thread, threads) {
+        QVERIFY(thread->wait(30000));
+        QVERIFY(thread->m_ok);
+        delete thread;
+    }
+
+    QGst::CapsCache::Statistics stats = cache.statistics();
+    QCOMPARE(stats.parseHits + stats.parseMisses, Q_UINT64_C(8000));
+    QVERIFY(stats.stringEntries <= 8);
+    QVERIFY(stats.pairEntries <= 8);
+}
+
+QTEST_APPLESS_MAIN(CapsCacheTest)
+
+#include "moc_qgsttest.cpp"
+#include "capscachetest.moc"
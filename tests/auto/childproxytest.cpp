@@ -25,6 +25,7 @@ private Q_SLOTS:
     void inspectionTest();
     void removeTest();
     void propertiesTest();
+    void setChildPropertyTest();
 };
 
 void ChildProxyTest::inspectionTest()
@@ -90,8 +91,49 @@ void ChildProxyTest::propertiesTest()
         QVERIFY(v.isValid());
         QCOMPARE(v.type(), QGlib::Type(QGlib::Type::Boolean));
     }
+
+    QGst::ElementPtr sink = QGst::ElementFactory::make("fakesink", "mysink");
+    QVERIFY(!sink.isNull());
+    QCOMPARE(bin->add(sink), true);
+
+    {
+        QList< QPair<QByteArray, QGlib::Value> > values;
+        values << qMakePair(QByteArray("mytee::silent"), QGlib::Value(false))
+               << qMakePair(QByteArray("mysink::sync"), QGlib::Value(true))
+               << qMakePair(QByteArray("mytee::foobar"), QGlib::Value(1))
+               << qMakePair(QByteArray("mysink::silent"), QGlib::Value(false));
+        bin->setChildProperties(values);
+
+        QList<QByteArray> names;
+        names << "mytee::silent" << "mysink::sync" << "mytee::foobar" << "mysink::silent";
+        QList<QGlib::Value> result = bin->childProperties(names);
+        QCOMPARE(result.size(), 4);
+        QCOMPARE(result[0].get<bool>(), false);
+        QCOMPARE(result[1].get<bool>(), true);
+        QVERIFY(!result[2].isValid());
+        QCOMPARE(result[3].get<bool>(), false);
+        QCOMPARE(tee->property("silent").get<bool>(), false);
+        QCOMPARE(sink->property("sync").get<bool>(), true);
+    }
 }
 
+void ChildProxyTest::setChildPropertyTest()
+{
+    QGst::BinPtr bin = QGst::Bin::create();
+    QGst::ElementPtr sink = QGst::ElementFactory::make("fakesink", "mysink");
+    QVERIFY(!sink.isNull());
+    QCOMPARE(bin->add(sink), true);
+
+    bin->setChildProperty("mysink::sync", false);
+    QCOMPARE(sink->property("sync").get<bool>(), false);
+
+    //the value is converted to the type of the property, which is gint64 here
+    bin->setChildProperty("mysink::max-lateness", 5);
+    QCOMPARE(sink->property("max-lateness").get<qint64>(), Q_INT64_C(5));
+
+    //properties that do not exist are ignored
+    bin->setChildProperty("mysink::foobar", 1);
+}
 
 QTEST_APPLESS_MAIN(ChildProxyTest)
 
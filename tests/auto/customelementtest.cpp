@@ -0,0 +1,286 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "qgsttest.h"
+#include <QGst/CustomElement>
+#include <QGst/StaticPlugin>
+#include <QGst/ElementFactory>
+#include <QGst/Bus>
+#include <QGst/Message>
+#include <QGst/Parse>
+#include <QGst/Pipeline>
+#include <QGst/Memory>
+#include <cstring>
+
+static const int NumBuffers = 8;
+static const uint BlockSize = 64;
+
+/* Produces NumBuffers buffers, filled with their index */
+class PatternSource : public QGst::CustomSource
+{
+public:
+    PatternSource() : m_index(0) {}
+
+    static void classInit(QGst::ElementClass & klass)
+    {
+        klass.setMetadata("Pattern source", "Source", "Produces test buffers", "QtGStreamer");
+        //fixed caps, as transforms do not accept buffers before caps are negotiated
+        klass.addPadTemplate("src", QGst::PadSrc, QGst::PadAlways,
+                             QGst::Caps::fromString("application/x-qgst-test"));
+    }
+
+protected:
+    virtual void initialize()
+    {
+        setBlockSize(BlockSize);
+    }
+
+    virtual QGst::FlowReturn fill(quint64 offset, uint size, QGst::Buffer *buffer)
+    {
+        Q_UNUSED(offset);
+        if (m_index == NumBuffers) {
+            return QGst::FlowEos;
+        }
+
+        QGst::MapInfo info;
+        if (!buffer->map(info, QGst::MapWrite)) {
+            return QGst::FlowError;
+        }
+        std::memset(info.data(), m_index++, size);
+        buffer->unmap(info);
+        return QGst::FlowOk;
+    }
+
+private:
+    int m_index;
+};
+
+/* Counts the buffers that pass through it */
+class Counter : public QGst::CustomInPlaceTransform
+{
+public:
+    Counter() : m_count(0) {}
+
+    static void classInit(QGst::ElementClass & klass)
+    {
+        klass.setMetadata("Counter", "Filter", "Counts buffers", "QtGStreamer");
+        klass.addPadTemplate("sink", QGst::PadSink, QGst::PadAlways, QGst::Caps::createAny());
+        klass.addPadTemplate("src", QGst::PadSrc, QGst::PadAlways, QGst::Caps::createAny());
+    }
+
+    int count() const { return m_count; }
+
+protected:
+    virtual QGst::FlowReturn transformInPlace(QGst::Buffer *buffer)
+    {
+        Q_UNUSED(buffer);
+        ++m_count;
+        return QGst::FlowOk;
+    }
+
+private:
+    int m_count;
+};
+
+/* Inverts all the bits of its input */
+class Inverter : public QGst::CustomCopyTransform
+{
+public:
+    static void classInit(QGst::ElementClass & klass)
+    {
+        klass.setMetadata("Inverter", "Filter", "Inverts bytes", "QtGStreamer");
+        klass.addPadTemplate("sink", QGst::PadSink, QGst::PadAlways, QGst::Caps::createAny());
+        klass.addPadTemplate("src", QGst::PadSrc, QGst::PadAlways, QGst::Caps::createAny());
+    }
+
+protected:
+    virtual QGst::FlowReturn transform(QGst::Buffer *in, QGst::Buffer *out)
+    {
+        QGst::MapInfo inInfo;
+        QGst::MapInfo outInfo;
+        if (!in->map(inInfo, QGst::MapRead)) {
+            return QGst::FlowError;
+        }
+        if (!out->map(outInfo, QGst::MapWrite)) {
+            in->unmap(inInfo);
+            return QGst::FlowError;
+        }
+        for (size_t i = 0; i < inInfo.size() && i < outInfo.size(); ++i) {
+            outInfo.data()[i] = ~inInfo.data()[i];
+        }
+        out->unmap(outInfo);
+        in->unmap(inInfo);
+        return QGst::FlowOk;
+    }
+};
+
+/* A plain element that pushes its buffers on from its own chain function */
+class Forwarder : public QGst::CustomElement
+{
+public:
+    Forwarder() : m_events(0) {}
+
+    static void classInit(QGst::ElementClass & klass)
+    {
+        klass.setMetadata("Forwarder", "Generic", "Forwards buffers", "QtGStreamer");
+        klass.addPadTemplate("sink", QGst::PadSink, QGst::PadAlways, QGst::Caps::createAny());
+        klass.addPadTemplate("src", QGst::PadSrc, QGst::PadAlways, QGst::Caps::createAny());
+    }
+
+    int events() const { return m_events; }
+
+protected:
+    virtual void initialize()
+    {
+        addPad("sink");
+        m_srcPad = addPad("src");
+    }
+
+    virtual QGst::FlowReturn chain(QGst::Pad *pad, QGst::BufferPtr & buffer)
+    {
+        Q_UNUSED(pad);
+        return m_srcPad->push(buffer);
+    }
+
+    virtual bool event(QGst::Pad *pad, const QGst::EventPtr & event)
+    {
+        ++m_events;
+        return QGst::CustomElement::event(pad, event);
+    }
+
+private:
+    QGst::PadPtr m_srcPad;
+    int m_events;
+};
+
+/* Records the first byte of every buffer */
+class RecordingSink : public QGst::CustomSink
+{
+public:
+    static void classInit(QGst::ElementClass & klass)
+    {
+        klass.setMetadata("Recording sink", "Sink", "Records buffers", "QtGStreamer");
+        klass.addPadTemplate("sink", QGst::PadSink, QGst::PadAlways, QGst::Caps::createAny());
+    }
+
+    QList<int> values() const { return m_values; }
+
+protected:
+    virtual void initialize()
+    {
+        setSync(false);
+    }
+
+    virtual QGst::FlowReturn render(QGst::Buffer *buffer)
+    {
+        quint8 value;
+        if (buffer->extract(0, &value, 1) != 1) {
+            return QGst::FlowError;
+        }
+        m_values.append(value);
+        return QGst::FlowOk;
+    }
+
+private:
+    QList<int> m_values;
+};
+
+class CustomElementTest : public QGstTest
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void factoryTest();
+    void pipelineTest();
+
+private:
+    void registerPlugin();
+};
+
+void CustomElementTest::registerPlugin()
+{
+    static bool registered = false;
+    if (!registered) {
+        QGst::StaticPlugin plugin("qgsttestelements", "QtGStreamer test elements");
+        plugin.addElement<PatternSource>("qgstpatternsrc");
+        plugin.addElement<Counter>("qgstcounter");
+        plugin.addElement<Inverter>("qgstinverter");
+        plugin.addElement<Forwarder>("qgstforwarder");
+        plugin.addElement<RecordingSink>("qgstrecordingsink");
+        QVERIFY(plugin.registerPlugin());
+        registered = true;
+    }
+}
+
+void CustomElementTest::factoryTest()
+{
+    registerPlugin();
+
+    QGst::ElementFactoryPtr factory = QGst::ElementFactory::find("qgstcounter");
+    QVERIFY(factory);
+    QCOMPARE(factory->metadata("long-name"), QString("Counter"));
+    QCOMPARE(factory->padTemplatesCount(), 2U);
+
+    QGst::ElementPtr element = factory->create();
+    QVERIFY(element);
+    QVERIFY(element->getStaticPad("sink"));
+    QVERIFY(element->getStaticPad("src"));
+
+    Counter *counter = dynamic_cast<Counter*>(QGst::CustomElement::fromElement(element));
+    QVERIFY(counter);
+    QCOMPARE(counter->count(), 0);
+    QCOMPARE(static_cast<GstElement*>(counter->element()), static_cast<GstElement*>(element));
+
+    QVERIFY(!QGst::CustomElement::fromElement(QGst::ElementFactory::make("identity")));
+}
+
+void CustomElementTest::pipelineTest()
+{
+    registerPlugin();
+
+    QGst::PipelinePtr pipeline = QGst::Parse::launch(
+        "qgstpatternsrc ! qgstcounter name=counter ! qgstinverter ! "
+        "qgstforwarder name=forwarder ! qgstrecordingsink name=sink").dynamicCast<QGst::Pipeline>();
+    QVERIFY(pipeline);
+
+    pipeline->setState(QGst::StatePlaying);
+    QGst::MessagePtr msg = pipeline->bus()->pop(QGst::MessageEos, QGst::ClockTime::fromSeconds(5));
+    QVERIFY(msg);
+    pipeline->setState(QGst::StateNull);
+
+    Counter *counter = dynamic_cast<Counter*>(
+        QGst::CustomElement::fromElement(pipeline->getElementByName("counter")));
+    QVERIFY(counter);
+    QCOMPARE(counter->count(), NumBuffers);
+
+    Forwarder *forwarder = dynamic_cast<Forwarder*>(
+        QGst::CustomElement::fromElement(pipeline->getElementByName("forwarder")));
+    QVERIFY(forwarder);
+    QVERIFY(forwarder->events() > 0); //at least stream-start, segment and eos
+
+    RecordingSink *sink = dynamic_cast<RecordingSink*>(
+        QGst::CustomElement::fromElement(pipeline->getElementByName("sink")));
+    QVERIFY(sink);
+    QList<int> values = sink->values();
+    QCOMPARE(values.size(), NumBuffers);
+    for (int i = 0; i < NumBuffers; ++i) {
+        QCOMPARE(values.at(i), 0xff - i);
+    }
+}
+
+QTEST_APPLESS_MAIN(CustomElementTest)
+
+#include "moc_qgsttest.cpp"
+#include "customelementtest.moc"
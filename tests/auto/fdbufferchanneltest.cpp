@@ -0,0 +1,131 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "qgsttest.h"
+#include <QGst/Buffer>
+#include <QGst/Memory>
+#include <QGst/Utils/FdBufferChannel>
+#include <cstring>
+#include <unistd.h>
+
+class FdBufferChannelTest : public QGstTest
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void init();
+    void cleanup();
+    void sendReceiveTest();
+    void copyTest();
+    void closedTest();
+
+private:
+    int m_sockets[2];
+};
+
+void FdBufferChannelTest::init()
+{
+    QVERIFY(QGst::Utils::FdBufferChannel::createSocketPair(m_sockets));
+}
+
+void FdBufferChannelTest::cleanup()
+{
+    for (int i = 0; i < 2; ++i) {
+        if (m_sockets[i] >= 0) {
+            close(m_sockets[i]);
+        }
+    }
+}
+
+void FdBufferChannelTest::sendReceiveTest()
+{
+#ifndef Q_OS_LINUX
+    QSKIP_PORT("memfd is only available on Linux", SkipAll);
+#else
+    QGst::Utils::FdBufferChannel sender(m_sockets[0]);
+    QGst::Utils::FdBufferChannel receiver(m_sockets[1]);
+
+    QGst::BufferPtr buffer = QGst::Buffer::createMemfd(8192);
+    if (!buffer) {
+        QSKIP_PORT("QtGStreamer was built without fd memory support", SkipAll);
+    }
+    buffer->appendMemory(QGst::Memory::createMemfd(1024));
+    GST_BUFFER_PTS(static_cast<GstBuffer*>(buffer)) = 1000;
+    GST_BUFFER_DURATION(static_cast<GstBuffer*>(buffer)) = 40;
+
+    QGst::MapInfo info;
+    QVERIFY(buffer->map(info, QGst::MapWrite));
+    memset(info.data(), 'a', info.size());
+    buffer->unmap(info);
+
+    QVERIFY(sender.sendBuffer(buffer));
+    QGst::BufferPtr received = receiver.receiveBuffer();
+    QVERIFY(received);
+    QCOMPARE(received->memoryCount(), 2u);
+    QCOMPARE(received->size(), 8192u + 1024u);
+    QCOMPARE(received->presentationTimeStamp(), QGst::ClockTime(1000));
+    QCOMPARE(received->duration(), QGst::ClockTime(40));
+
+    //both buffers map the same pages
+    QGst::MemoryPtr mem = received->getMemory(1);
+    QVERIFY(mem->isFdMemory());
+    QVERIFY(mem->map(info, QGst::MapWrite));
+    QCOMPARE(info.data()[0], static_cast<quint8>('a'));
+    info.data()[0] = 'b';
+    mem->unmap(info);
+
+    mem = buffer->getMemory(1);
+    QVERIFY(mem->map(info, QGst::MapRead));
+    QCOMPARE(info.data()[0], static_cast<quint8>('b'));
+    mem->unmap(info);
+#endif
+}
+
+void FdBufferChannelTest::copyTest()
+{
+#ifndef Q_OS_LINUX
+    QSKIP_PORT("memfd is only available on Linux", SkipAll);
+#else
+    QGst::Utils::FdBufferChannel sender(m_sockets[0]);
+    QGst::Utils::FdBufferChannel receiver(m_sockets[1]);
+
+    //memory without a descriptor is copied into a memfd
+    QGst::BufferPtr buffer = QGst::Buffer::fromData(QByteArray("hello world"));
+    QVERIFY(sender.sendBuffer(buffer));
+
+    QGst::BufferPtr received = receiver.receiveBuffer();
+    QVERIFY(received);
+    QCOMPARE(received->size(), 11u);
+
+    QGst::MapInfo info;
+    QVERIFY(received->map(info, QGst::MapRead));
+    QCOMPARE(QByteArray(reinterpret_cast<const char*>(info.data()), info.size()),
+             QByteArray("hello world"));
+    received->unmap(info);
+#endif
+}
+
+void FdBufferChannelTest::closedTest()
+{
+    QGst::Utils::FdBufferChannel receiver(m_sockets[1]);
+    close(m_sockets[0]);
+    m_sockets[0] = -1;
+    QVERIFY(receiver.receiveBuffer().isNull());
+}
+
+QTEST_APPLESS_MAIN(FdBufferChannelTest)
+
+#include "moc_qgsttest.cpp"
+#include "fdbufferchanneltest.moc"
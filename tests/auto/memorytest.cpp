@@ -19,12 +19,18 @@
 #include <QGlib/Error>
 #include <QGst/Memory>
 #include <QGst/Allocator>
+#include <cstring>
 
 class MemoryTest : public QGstTest
 {
     Q_OBJECT
 private Q_SLOTS:
     void testMap();
+    void testWrap();
+    void testFdMemory();
+
+private:
+    static void onDataReleased(void *userData) { ++*static_cast<int*>(userData); }
 };
 
 void MemoryTest::testMap()
@@ -46,6 +52,70 @@ void MemoryTest::testMap()
     allocator->free(mem);
 }
 
+void MemoryTest::testWrap()
+{
+    quint8 data[64];
+    int released = 0;
+
+    QGst::MemoryPtr mem = QGst::Memory::wrap(data, sizeof(data), QGst::MemoryFlagReadonly,
+                                             &MemoryTest::onDataReleased, &released);
+    QCOMPARE(mem->size(), sizeof(data));
+
+    QGst::MapInfo info;
+    QVERIFY(mem->map(info, QGst::MapRead));
+    QCOMPARE(info.data(), static_cast<quint8*>(data));
+    mem->unmap(info);
+
+    mem.clear();
+    QCOMPARE(released, 1);
+}
+
+void MemoryTest::testFdMemory()
+{
+#ifndef Q_OS_LINUX
+    QSKIP_PORT("memfd is only available on Linux", SkipAll);
+#else
+    QGst::MemoryPtr mem = QGst::Memory::createMemfd(4096);
+    if (!mem) {
+        QSKIP_PORT("QtGStreamer was built without fd memory support", SkipAll);
+    }
+    QVERIFY(mem->isFdMemory());
+    QVERIFY(mem->fd() >= 0);
+    QCOMPARE(mem->size(), static_cast<size_t>(4096));
+    QCOMPARE(mem->offset(), static_cast<size_t>(0));
+
+    QGst::MapInfo info;
+    QVERIFY(mem->map(info, QGst::MapWrite));
+    memset(info.data(), 0, info.size());
+    info.data()[100] = 42;
+    mem->unmap(info);
+
+    //a second memory on the same descriptor sees the same pages
+    QGst::MemoryPtr other = QGst::Memory::fromFd(mem->fd(), 4096, false);
+    QVERIFY(other);
+#if GST_CHECK_VERSION(1, 10, 0)
+    QCOMPARE(other->fd(), mem->fd());
+#else
+    //older allocators always own the descriptor, so they get a duplicate
+    QVERIFY(other->fd() >= 0);
+#endif
+    QVERIFY(other->map(info, QGst::MapRead));
+    QCOMPARE(info.data()[100], static_cast<quint8>(42));
+    other->unmap(info);
+
+    //the descriptor was not handed over, so it is still valid
+    other.clear();
+    QVERIFY(mem->map(info, QGst::MapRead));
+    QCOMPARE(info.data()[100], static_cast<quint8>(42));
+    mem->unmap(info);
+
+    //other memory has no descriptor
+    QGst::MemoryPtr sys = QGst::Allocator::getSystemMemory()->alloc(100);
+    QVERIFY(!sys->isFdMemory());
+    QCOMPARE(sys->fd(), -1);
+#endif
+}
+
 QTEST_APPLESS_MAIN(MemoryTest)
 
 #include "moc_qgsttest.cpp"
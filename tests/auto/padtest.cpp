@@ -21,12 +21,63 @@
 #include <QGst/Pad>
 #include <QGst/Caps>
 #include <QGst/Event>
+#include <QGst/Buffer>
+#include <QGst/Bus>
+#include <QGst/Message>
+#include <QGst/Parse>
+#include <QGst/Pipeline>
+
+struct BufferCounter
+{
+    explicit BufferCounter(int *count) : m_count(count) {}
+    QGst::PadProbeReturn operator()(QGst::PadProbeInfo & info)
+    {
+        if (info.buffer()) {
+            ++*m_count;
+        }
+        return QGst::PadProbeOk;
+    }
+    int *m_count;
+};
+
+struct BufferViewChecker
+{
+    explicit BufferViewChecker(int *count) : m_count(count) {}
+    QGst::PadProbeReturn operator()(QGst::PadProbeInfo & info)
+    {
+        QGst::Buffer *view = info.bufferView();
+        QGst::Buffer *buffer = info.buffer();
+        //the view is a different wrapper of the same buffer
+        if (view && buffer && view != buffer && view->size() == buffer->size()
+                && info.bufferView() == view && !info.eventView()) {
+            ++*m_count;
+        }
+        return QGst::PadProbeOk;
+    }
+    int *m_count;
+};
 
 class PadTest : public QGstTest
 {
     Q_OBJECT
 private Q_SLOTS:
     void capsTest();
+    void bufferProbeTest();
+    void dropProbeTest();
+    void eventProbeTest();
+    void viewProbeTest();
+    void pushNullTest();
+
+    QGst::PadProbeReturn dropOddBuffers(QGst::PadProbeInfo & info);
+    QGst::PadProbeReturn countEvents(QGst::PadProbeInfo & info);
+
+private:
+    QGst::PipelinePtr createPipeline(const char *description, QGst::PadPtr *sinkPad);
+    void waitForEos(const QGst::PipelinePtr & pipeline);
+
+    int m_seen;
+    int m_events;
+    bool m_sawEos;
 };
 
 void PadTest::capsTest()
@@ -47,6 +98,110 @@ void PadTest::capsTest()
     QVERIFY(caps->equals(caps2));
     queue->setState(QGst::StateNull);
 }
+
+QGst::PipelinePtr PadTest::createPipeline(const char *description, QGst::PadPtr *sinkPad)
+{
+    QGst::PipelinePtr pipeline = QGst::Parse::launch(description).dynamicCast<QGst::Pipeline>();
+    QGst::ElementPtr sink = pipeline->getElementByName("probed");
+    *sinkPad = sink->getStaticPad("sink");
+    return pipeline;
+}
+
+void PadTest::waitForEos(const QGst::PipelinePtr & pipeline)
+{
+    pipeline->setState(QGst::StatePlaying);
+    QGst::MessagePtr msg = pipeline->bus()->pop(QGst::MessageEos, QGst::ClockTime::fromSeconds(5));
+    QVERIFY(msg);
+    pipeline->setState(QGst::StateNull);
+}
+
+void PadTest::bufferProbeTest()
+{
+    QGst::PadPtr pad;
+    QGst::PipelinePtr pipeline = createPipeline("fakesrc num-buffers=10 ! fakesink name=probed", &pad);
+
+    int count = 0;
+    ulong id = pad->addProbe(QGst::PadProbeTypeBuffer, BufferCounter(&count));
+    QVERIFY(id != 0);
+
+    waitForEos(pipeline);
+    QCOMPARE(count, 10);
+
+    pad->removeProbe(id);
+}
+
+QGst::PadProbeReturn PadTest::dropOddBuffers(QGst::PadProbeInfo & info)
+{
+    Q_UNUSED(info);
+    return (m_seen++ % 2) ? QGst::PadProbeDrop : QGst::PadProbeOk;
+}
+
+void PadTest::dropProbeTest()
+{
+    QGst::PadPtr pad;
+    QGst::PipelinePtr pipeline = createPipeline("fakesrc num-buffers=10 ! identity name=probed ! fakesink", &pad);
+
+    QGst::PadPtr srcPad = pipeline->getElementByName("probed")->getStaticPad("src");
+    int count = 0;
+    srcPad->addProbe(QGst::PadProbeTypeBuffer, BufferCounter(&count));
+
+    m_seen = 0;
+    pad->addProbe(QGst::PadProbeTypeBuffer, this, &PadTest::dropOddBuffers);
+
+    waitForEos(pipeline);
+    QCOMPARE(m_seen, 10);
+    QCOMPARE(count, 5);
+}
+
+QGst::PadProbeReturn PadTest::countEvents(QGst::PadProbeInfo & info)
+{
+    QGst::Event *event = info.eventView();
+    if (event) {
+        ++m_events;
+        if (event->type() == QGst::EventEos) {
+            m_sawEos = true;
+            //returning PadProbeRemove removes the probe after this call
+            return QGst::PadProbeRemove;
+        }
+    }
+    return QGst::PadProbeOk;
+}
+
+void PadTest::eventProbeTest()
+{
+    QGst::PadPtr pad;
+    QGst::PipelinePtr pipeline = createPipeline("fakesrc num-buffers=1 ! fakesink name=probed", &pad);
+
+    m_events = 0;
+    m_sawEos = false;
+    pad->addProbe(QGst::PadProbeTypeEventDownstream, this, &PadTest::countEvents);
+
+    waitForEos(pipeline);
+    QVERIFY(m_sawEos);
+    //at least stream-start, caps or segment, and eos
+    QVERIFY(m_events >= 3);
+}
+
+void PadTest::viewProbeTest()
+{
+    QGst::PadPtr pad;
+    QGst::PipelinePtr pipeline = createPipeline("fakesrc num-buffers=10 sizetype=fixed sizemax=32 "
+                                                "! fakesink name=probed", &pad);
+
+    int count = 0;
+    pad->addProbe(QGst::PadProbeTypeBuffer, BufferViewChecker(&count));
+
+    waitForEos(pipeline);
+    QCOMPARE(count, 10);
+}
+
+void PadTest::pushNullTest()
+{
+    QGst::PadPtr pad = QGst::Pad::create(QGst::PadSrc, "src");
+    QGst::BufferPtr buffer;
+    QCOMPARE(pad->push(buffer), QGst::FlowError);
+}
+
 QTEST_APPLESS_MAIN(PadTest)
 
 #include "moc_qgsttest.cpp"
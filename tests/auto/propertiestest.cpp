@@ -17,6 +17,8 @@
 #include "qgsttest.h"
 #include <QGst/Object>
 #include <QGst/Bin>
+#include <QGst/Pipeline>
+#include <QGlib/Connect>
 
 class PropertiesTest : public QGstTest
 {
@@ -25,6 +27,12 @@ private Q_SLOTS:
     void findPropertyTest();
     void listPropertiesTest();
     void getPropertyTest();
+    void propertyHandleTest();
+    void setPropertiesTest();
+
+private:
+    void onAsyncHandlingNotify(const QGlib::ObjectPtr & object, const QGlib::ParamSpecPtr &);
+    bool m_messageForwardOnNotify;
 };
 
 void PropertiesTest::findPropertyTest()
@@ -63,6 +71,95 @@ void PropertiesTest::getPropertyTest()
     }
 }
 
+void PropertiesTest::propertyHandleTest()
+{
+    QGst::BinPtr object = QGst::Bin::create("mybin");
+
+    QGlib::PropertyHandle invalid(QGlib::GetType<QGst::Bin>(), "foobar");
+    QVERIFY(!invalid.isValid());
+    QVERIFY(!object->property(invalid).isValid());
+    QVERIFY(!object->propertyHandle("foobar").isValid());
+
+    //resolved on a base class, the canonical name is used
+    QGlib::PropertyHandle asyncHandling(QGlib::GetType<QGst::Bin>(), "async_handling");
+    QVERIFY(asyncHandling.isValid());
+    QCOMPARE(QByteArray(asyncHandling.name()), QByteArray("async-handling"));
+    QCOMPARE(asyncHandling.valueType(), QGlib::GetType<bool>());
+    QVERIFY(asyncHandling.flags() & QGlib::ParamSpec::Writable);
+    QCOMPARE(asyncHandling.paramSpec()->name(), QString("async-handling"));
+
+    QGlib::PropertyHandle name = object->propertyHandle("name");
+    QVERIFY(name.isValid());
+    QCOMPARE(name.instanceType(), QGlib::GetType<QGst::Bin>());
+    QCOMPARE(object->property<QString>(name), QString("mybin"));
+    QCOMPARE(object->property(name).get<QString>(), QString("mybin"));
+
+    object->setProperty(asyncHandling, true);
+    QCOMPARE(object->property<bool>(asyncHandling), true);
+    QCOMPARE(object->property("async-handling").get<bool>(), true);
+    object->setProperty(asyncHandling, QGlib::Value(false));
+    QCOMPARE(object->property<bool>(asyncHandling), false);
+
+    //the cache behind the string API returns the same ParamSpec
+    QCOMPARE(static_cast<GParamSpec*>(object->findProperty("async-handling")),
+             static_cast<GParamSpec*>(asyncHandling.paramSpec()));
+
+    //a handle that was resolved on an unrelated type is refused
+    QGst::PipelinePtr pipeline = QGst::Pipeline::create();
+    QGlib::PropertyHandle delay(QGlib::GetType<QGst::Pipeline>(), "delay");
+    QVERIFY(delay.isValid());
+    QVERIFY(!object->property(delay).isValid());
+    bool ok = true;
+    QCOMPARE(object->property<quint64>(delay, &ok), quint64(0));
+    QVERIFY(!ok);
+    QVERIFY(pipeline->property(delay).isValid());
+}
+
+void PropertiesTest::onAsyncHandlingNotify(const QGlib::ObjectPtr & object,
+                                           const QGlib::ParamSpecPtr &)
+{
+    m_messageForwardOnNotify = object->property("message-forward").get<bool>();
+}
+
+void PropertiesTest::setPropertiesTest()
+{
+    QGst::BinPtr object = QGst::Bin::create("mybin");
+    QGlib::connect(object, "notify::async-handling",
+                   this, &PropertiesTest::onAsyncHandlingNotify, QGlib::PassSender);
+
+    //notify is frozen until all the properties have been set
+    m_messageForwardOnNotify = false;
+    QList< QPair<QByteArray, QGlib::Value> > values;
+    values << qMakePair(QByteArray("async-handling"), QGlib::Value(true))
+           << qMakePair(QByteArray("foobar"), QGlib::Value(1))
+           << qMakePair(QByteArray("message-forward"), QGlib::Value(true));
+    object->setProperties(values);
+    QCOMPARE(m_messageForwardOnNotify, true);
+
+    QList<QByteArray> names;
+    names << "async-handling" << "foobar" << "message-forward" << "name";
+    QList<QGlib::Value> result = object->properties(names);
+    QCOMPARE(result.size(), 4);
+    QCOMPARE(result[0].get<bool>(), true);
+    QVERIFY(!result[1].isValid());
+    QCOMPARE(result[2].get<bool>(), true);
+    QCOMPARE(result[3].get<QString>(), QString("mybin"));
+
+    QGlib::PropertyHandle asyncHandling = object->propertyHandle("async-handling");
+    QGlib::PropertyHandle messageForward = object->propertyHandle("message-forward");
+    QList< QPair<QGlib::PropertyHandle, QGlib::Value> > handleValues;
+    handleValues << qMakePair(asyncHandling, QGlib::Value(false))
+                 << qMakePair(messageForward, QGlib::Value(false));
+    object->setProperties(handleValues);
+
+    QList<QGlib::PropertyHandle> handles;
+    handles << asyncHandling << messageForward;
+    result = object->properties(handles);
+    QCOMPARE(result.size(), 2);
+    QCOMPARE(result[0].get<bool>(), false);
+    QCOMPARE(result[1].get<bool>(), false);
+}
+
 QTEST_APPLESS_MAIN(PropertiesTest)
 
 #include "moc_qgsttest.cpp"
@@ -17,6 +17,9 @@
 */
 #include "qgsttest.h"
 #include <QGst/Query>
+#include <QGst/Caps>
+#include <QGst/Allocator>
+#include <QGst/BufferPool>
 
 class QueryTest : public QGstTest
 {
@@ -32,6 +35,7 @@ private Q_SLOTS:
     void formatsTest();
     void bufferingTest();
     void uriTest();
+    void allocationTest();
 };
 
 void QueryTest::baseTest()
@@ -179,6 +183,37 @@ void QueryTest::uriTest()
     QCOMPARE(query->uri(), QUrl::fromLocalFile("/bin/sh"));
 }
 
+void QueryTest::allocationTest()
+{
+    QGst::CapsPtr caps = QGst::Caps::fromString("video/x-raw, format=(string)I420");
+    QGst::AllocationQueryPtr query = QGst::AllocationQuery::create(caps, true);
+    QVERIFY(query->type()==QGst::QueryAllocation);
+    QCOMPARE(query->typeName(), QString("allocation"));
+    QVERIFY(query->needPool());
+    QCOMPARE(query->caps()->toString(), caps->toString());
+
+    QCOMPARE(query->allocationParamCount(), 0u);
+    QGst::AllocatorPtr system = QGst::Allocator::getSystemMemory();
+    QGst::AllocationParams params;
+    params.setAlign(15);
+    query->addAllocationParam(system, params);
+    QCOMPARE(query->allocationParamCount(), 1u);
+    QCOMPARE(static_cast<GstAllocator*>(query->allocator(0)), static_cast<GstAllocator*>(system));
+    QCOMPARE(query->allocationParams(0).align(), static_cast<size_t>(15));
+
+    QCOMPARE(query->allocationPoolCount(), 0u);
+    QGst::BufferPoolPtr pool = QGst::BufferPool::create();
+    query->addAllocationPool(pool, 4096, 2, 0);
+    QCOMPARE(query->allocationPoolCount(), 1u);
+
+    uint size, minBuffers, maxBuffers;
+    QGst::BufferPoolPtr p = query->allocationPool(0, &size, &minBuffers, &maxBuffers);
+    QCOMPARE(static_cast<GstBufferPool*>(p), static_cast<GstBufferPool*>(pool));
+    QCOMPARE(size, 4096u);
+    QCOMPARE(minBuffers, 2u);
+    QCOMPARE(maxBuffers, 0u);
+}
+
 QTEST_APPLESS_MAIN(QueryTest)
 
 #include "moc_qgsttest.cpp"
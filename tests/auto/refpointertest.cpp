@@ -23,6 +23,8 @@
 #include <QGst/ElementFactory>
 #include <QGst/UriHandler>
 #include <QGst/StreamVolume>
+#include <QGst/Bin>
+#include <utility>
 
 class RefPointerTest : public QGstTest
 {
@@ -30,11 +32,13 @@ class RefPointerTest : public QGstTest
 private Q_SLOTS:
     void refTest1();
     void refTest2();
+    void moveTest();
     void dynamicCastTest();
     void dynamicCastDownObjectTest();
     void dynamicCastUpObjectTest();
     void dynamicCastObjectToIfaceTest();
     void dynamicCastIfaceToObjectTest();
+    void wrapperTypeCacheTest();
     void cppWrappersTest();
     void messageDynamicCastTest();
     void equalityTest();
@@ -68,6 +72,44 @@ void RefPointerTest::refTest2()
     gst_object_unref(bin);
 }
 
+void RefPointerTest::moveTest()
+{
+#if QGLIB_HAVE_CXX0X
+    GstObject *bin = GST_OBJECT(gst_object_ref_sink(GST_OBJECT(gst_bin_new(NULL))));
+
+    {
+        QGst::ObjectPtr object = QGst::ObjectPtr::wrap(bin);
+        QCOMPARE(GST_OBJECT_REFCOUNT_VALUE(bin), 2);
+
+        QGst::ObjectPtr object2(std::move(object));
+        QVERIFY(object.isNull());
+        QCOMPARE(GST_OBJECT_REFCOUNT_VALUE(bin), 2);
+
+        QGlib::ObjectPtr object3;
+        object3 = std::move(object2);
+        QVERIFY(object2.isNull());
+        QVERIFY(object3 == bin);
+        QCOMPARE(GST_OBJECT_REFCOUNT_VALUE(bin), 2);
+
+# if QGLIB_HAVE_CXX0X_REF_QUALIFIERS
+        QGst::BinPtr binPtr = std::move(object3).dynamicCast<QGst::Bin>();
+        QVERIFY(object3.isNull());
+        QVERIFY(binPtr == bin);
+        QCOMPARE(GST_OBJECT_REFCOUNT_VALUE(bin), 2);
+
+        QGst::ElementPtr element = std::move(binPtr).staticCast<QGst::Element>();
+        QVERIFY(binPtr.isNull());
+        QCOMPARE(GST_OBJECT_REFCOUNT_VALUE(bin), 2);
+# endif
+    }
+
+    QCOMPARE(GST_OBJECT_REFCOUNT_VALUE(bin), 1);
+    gst_object_unref(bin);
+#else
+    QSKIP_PORT("This test requires a compiler with C++0x rvalue references", SkipAll);
+#endif
+}
+
 void RefPointerTest::dynamicCastTest()
 {
     GstObject *bin = GST_OBJECT(gst_object_ref_sink(GST_OBJECT(gst_bin_new(NULL))));
@@ -134,6 +176,30 @@ void RefPointerTest::dynamicCastIfaceToObjectTest()
     QVERIFY(!u.dynamicCast<QGst::Element>().isNull());
 }
 
+void RefPointerTest::wrapperTypeCacheTest()
+{
+    GstElement *e = gst_element_factory_make("filesrc", NULL);
+    gst_object_ref_sink(e);
+
+    //the first wrap resolves the wrapper constructor and the qdata key
+    //of the interface and caches them, the second one uses the cache
+    QGst::UriHandlerPtr u1 = QGst::UriHandlerPtr::wrap(GST_URI_HANDLER(e));
+    QGst::UriHandlerPtr u2 = QGst::UriHandlerPtr::wrap(GST_URI_HANDLER(e));
+    QVERIFY(!u1.isNull());
+    QVERIFY(u1.operator->() == u2.operator->());
+
+    QGst::ElementPtr element = QGst::ElementPtr::wrap(e, false);
+    QVERIFY(element.dynamicCast<QGst::UriHandler>().operator->() == u1.operator->());
+
+    //the wrapper of a subclass is not exactly the requested class,
+    //which must still be handled by RefPointer::wrap()
+    GstElement *p = gst_pipeline_new(NULL);
+    gst_object_ref_sink(p);
+    QGst::ObjectPtr object = QGst::ObjectPtr::wrap(GST_OBJECT(p), false);
+    QVERIFY(!object.isNull());
+    QVERIFY(!object.dynamicCast<QGst::Pipeline>().isNull());
+}
+
 void RefPointerTest::cppWrappersTest()
 {
     QGst::ElementPtr e = QGst::ElementFactory::make("playbin");
@@ -177,10 +243,21 @@ void RefPointerTest::cppWrappersTest()
                  static_cast<QGlib::RefCountedObject*>(msg2.operator->()));
         QVERIFY(msg2 == msg);
 
+        //new wrap() should give the same C++ instance
         QGst::MessagePtr msg3 = QGst::MessagePtr::wrap(msg2);
-        QVERIFY(static_cast<QGlib::RefCountedObject*>(msg3.operator->())
-                != static_cast<QGlib::RefCountedObject*>(msg2.operator->()));
+        QCOMPARE(static_cast<QGlib::RefCountedObject*>(msg3.operator->()),
+                 static_cast<QGlib::RefCountedObject*>(msg2.operator->()));
         QVERIFY(msg3 == msg2);
+        QCOMPARE(GST_MINI_OBJECT_REFCOUNT_VALUE(static_cast<GstMessage*>(msg)), 1);
+
+        //wrapping with a transferred reference must not leak it
+        GstMessage *native = gst_message_ref(msg);
+        {
+            QGst::MessagePtr msg4 = QGst::MessagePtr::wrap(native, false);
+            QCOMPARE(static_cast<QGlib::RefCountedObject*>(msg4.operator->()),
+                     static_cast<QGlib::RefCountedObject*>(msg.operator->()));
+        }
+        QCOMPARE(GST_MINI_OBJECT_REFCOUNT_VALUE(native), 1);
     }
 }
 
@@ -20,6 +20,7 @@
 #include <QGlib/Signal>
 #include <QGlib/Connect>
 #include <QGst/Pipeline>
+#include <QGst/ElementFactory>
 
 class SignalsTest : public QGstTest
 {
@@ -28,14 +29,19 @@ private:
    void closureTestClosure(const QGst::ObjectPtr & obj, const QGst::ObjectPtr & parentObj);
    void emitTestClosure(const QGlib::ObjectPtr & instance, const QGlib::ParamSpecPtr & param);
    void disconnectTestClosure(const QGlib::ParamSpecPtr &) {}
+   void valueArgumentTestClosure(const QGlib::Value & element);
+
+   QGlib::Value m_storedValue;
 
 private Q_SLOTS:
    void closureTest();
    void queryTest();
    void emitTest();
    void emitTypeTest();
+   void signalHandleTest();
    void disconnectTest();
    void autoDisconnectTest();
+   void valueArgumentTest();
 };
 
 static bool closureCalled = false;
@@ -135,6 +141,51 @@ void SignalsTest::emitTypeTest()
     QCOMPARE(closureCalled, true);
 }
 
+void SignalsTest::signalHandleTest()
+{
+    QGlib::SignalHandle invalid(QGlib::GetType<QGst::Bin>(), "foobar");
+    QVERIFY(!invalid.isValid());
+
+    QGlib::SignalHandle signal(QGlib::GetType<QGst::Bin>(), "notify::name");
+    QVERIFY(signal.isValid());
+    QCOMPARE(QByteArray(signal.name()), QByteArray("notify"));
+    QCOMPARE(signal.detail().toString(), QString("name"));
+    QCOMPARE(signal.signal().id(), signal.id());
+    QCOMPARE(signal.instanceType(), QGlib::GetType<QGst::Bin>());
+    QCOMPARE(signal.returnType(), QGlib::Type(QGlib::Type::None));
+    QCOMPARE(signal.paramCount(), 1u);
+    QCOMPARE(signal.paramType(0), QGlib::Type(QGlib::Type::Param));
+
+    QGst::BinPtr bin = QGst::Bin::create("mybin");
+    QVERIFY(QGlib::connect(bin, "notify::name", this, &SignalsTest::emitTestClosure,
+                           QGlib::PassSender));
+
+    closureCalled = false;
+    QGlib::emit<void>(signal, bin, bin->findProperty("name"));
+    QCOMPARE(closureCalled, true);
+
+    //a different detail than the one that the handle was resolved with
+    closureCalled = false;
+    QGlib::emitWithDetail<void>(signal, bin, QGlib::Quark::fromString("async-handling"),
+                                bin->findProperty("async-handling"));
+    QCOMPARE(closureCalled, false);
+
+    //wrong number of arguments. should show error message and *not call* the signal
+    closureCalled = false;
+    QGlib::emit<void>(signal, bin);
+    QCOMPARE(closureCalled, false);
+
+    //an instance that is not of the type that the handle was resolved on
+    closureCalled = false;
+    QGst::ElementPtr element = QGst::ElementFactory::make("fakesink");
+    QVERIFY(!element.isNull());
+    QGlib::emit<void>(signal, element, element->findProperty("name"));
+    QCOMPARE(closureCalled, false);
+
+    //an invalid handle must not emit anything
+    QGlib::emit<void>(invalid, bin);
+}
+
 void SignalsTest::disconnectTest()
 {
     QGst::BinPtr bin = QGst::Bin::create();
@@ -199,6 +250,27 @@ void SignalsTest::autoDisconnectTest()
     QVERIFY(!QGlib::disconnect(binPtr));
 }
 
+void SignalsTest::valueArgumentTestClosure(const QGlib::Value & element)
+{
+    //the argument refers to the GValue of the emission; keeping it must copy it
+    m_storedValue = element;
+}
+
+void SignalsTest::valueArgumentTest()
+{
+    QGst::BinPtr bin = QGst::Bin::create("mybin");
+    QGst::ElementPtr child = QGst::Bin::create("mychild");
+
+    QVERIFY(QGlib::connect(bin, "element-added", this, &SignalsTest::valueArgumentTestClosure));
+    bin->add(child);
+
+    //the GValues of the emission have been unset by now
+    QVERIFY(m_storedValue.isValid());
+    QCOMPARE(static_cast<GstElement*>(m_storedValue.get<QGst::ElementPtr>()),
+             static_cast<GstElement*>(child));
+    m_storedValue = QGlib::Value();
+}
+
 QTEST_APPLESS_MAIN(SignalsTest)
 
 #include "moc_qgsttest.cpp"
@@ -23,6 +23,9 @@
 #include <QGst/Caps>
 #include <QGst/Pad>
 #include <QGst/Event>
+#include <QGst/Buffer>
+#include <QGst/Sample>
+#include <QGst/Segment>
 
 class StructureTest : public QGstTest
 {
@@ -32,6 +35,9 @@ private Q_SLOTS:
     void copyTest();
     void valueTest();
     void sharedStructureTest();
+    void quarkAccessTest();
+    void forEachFieldTest();
+    void sampleInfoTest();
 };
 
 void StructureTest::bindingsTest()
@@ -142,6 +148,150 @@ void StructureTest::sharedStructureTest()
     queue->setState(QGst::StateNull);
 }
 
+void StructureTest::quarkAccessTest()
+{
+    const QGlib::Quark intField = QGlib::Quark::fromString("intfield");
+    const QGlib::Quark uint64Field = QGlib::Quark::fromString("uint64field");
+    const QGlib::Quark doubleField = QGlib::Quark::fromString("doublefield");
+    const QGlib::Quark stringField = QGlib::Quark::fromString("stringfield");
+    const QGlib::Quark fractionField = QGlib::Quark::fromString("fractionfield");
+    const QGlib::Quark boolField = QGlib::Quark::fromString("boolfield");
+    const QGlib::Quark missingField = QGlib::Quark::fromString("missingfield");
+
+    QGst::Structure s("mystructure");
+    s.setInt(intField, -20);
+    s.setUint64(uint64Field, Q_UINT64_C(1) << 40);
+    s.setDouble(doubleField, 0.5);
+    s.setString(stringField, "hello world");
+    s.setFraction(fractionField, QGst::Fraction(30000, 1001));
+    s.setBoolean(boolField, true);
+    QCOMPARE(s.numberOfFields(), static_cast<unsigned int>(6));
+
+    //the typed setters are interchangeable with the generic Value accessors
+    QCOMPARE(s.value("intfield").get<int>(), -20);
+    QCOMPARE(s.value("uint64field").get<quint64>(), Q_UINT64_C(1) << 40);
+    QCOMPARE(s.value("stringfield").get<QString>(), QString("hello world"));
+    QCOMPARE(s.value("fractionfield").get<QGst::Fraction>(), QGst::Fraction(30000, 1001));
+    s.setValue("uintfield", 7U);
+
+    int i = 0;
+    QVERIFY(s.getInt(intField, &i));
+    QCOMPARE(i, -20);
+
+    uint u = 0;
+    QVERIFY(s.getUint(QGlib::Quark::fromString("uintfield"), &u));
+    QCOMPARE(u, 7U);
+
+    quint64 u64 = 0;
+    QVERIFY(s.getUint64(uint64Field, &u64));
+    QCOMPARE(u64, Q_UINT64_C(1) << 40);
+
+    double d = 0;
+    QVERIFY(s.getDouble(doubleField, &d));
+    QCOMPARE(d, 0.5);
+
+    QCOMPARE(QString::fromUtf8(s.getString(stringField)), QString("hello world"));
+
+    QGst::Fraction f;
+    QVERIFY(s.getFraction(fractionField, &f));
+    QCOMPARE(f, QGst::Fraction(30000, 1001));
+
+    bool b = false;
+    QVERIFY(s.getBoolean(boolField, &b));
+    QVERIFY(b);
+
+    //missing fields and type mismatches leave the output untouched
+    i = 42;
+    QVERIFY(!s.getInt(missingField, &i));
+    QVERIFY(!s.getInt(doubleField, &i));
+    QCOMPARE(i, 42);
+    QVERIFY(!s.getInt64(intField, NULL));
+    QVERIFY(!s.getString(intField));
+    QVERIFY(!s.getString(missingField));
+
+    //setting through a quark replaces an existing value
+    s.setInt(intField, 10);
+    QVERIFY(s.getInt(intField, &i));
+    QCOMPARE(i, 10);
+
+    //an invalid structure has no fields
+    QGst::Structure invalid;
+    QVERIFY(!invalid.getInt(intField, &i));
+    QVERIFY(!invalid.getString(stringField));
+}
+
+static bool stopAtStopField(QGlib::Quark field, const GValue *value)
+{
+    Q_UNUSED(value);
+    return field.toString() != QLatin1String("stop");
+}
+
+struct FieldCollector
+{
+    FieldCollector(QStringList *names, int *sum) : names(names), sum(sum) {}
+    bool operator()(QGlib::Quark field, const GValue *value)
+    {
+        names->append(field.toString());
+        //the values are visited in place
+        if (G_VALUE_HOLDS_INT(value)) {
+            *sum += g_value_get_int(value);
+        }
+        return true;
+    }
+
+    QStringList *names;
+    int *sum;
+};
+
+void StructureTest::forEachFieldTest()
+{
+    QGst::Structure s("mystructure");
+    s.setValue("a", 1);
+    s.setValue("b", QString("two"));
+    s.setValue("c", 3);
+
+    QStringList names;
+    int sum = 0;
+    QVERIFY(s.forEachField(FieldCollector(&names, &sum)));
+    QCOMPARE(names, QStringList() << "a" << "b" << "c");
+    QCOMPARE(sum, 4);
+
+    QVERIFY(s.forEachField(&stopAtStopField));
+    s.setValue("stop", 0);
+    QVERIFY(!s.forEachField(&stopAtStopField));
+
+    QVERIFY(QGst::Structure().forEachField(&stopAtStopField));
+}
+
+void StructureTest::sampleInfoTest()
+{
+    QGst::Structure info("myinfo");
+    info.setValue("intfield", 20);
+
+    QGst::SamplePtr sample = QGst::Sample::create(QGst::Buffer::create(10),
+            QGst::Caps::createSimple("video/x-raw"), QGst::Segment(), info);
+
+    QGst::StructureConstPtr view = sample->infoView();
+    QVERIFY(view->isValid());
+    QCOMPARE(view->name(), QString("myinfo"));
+    int i = 0;
+    QVERIFY(view->getInt(QGlib::Quark::fromString("intfield"), &i));
+    QCOMPARE(i, 20);
+
+    //the view shares the sample's structure
+    QCOMPARE(static_cast<const GstStructure*>(*view),
+             gst_sample_get_info(static_cast<GstSample*>(sample)));
+
+    //and keeps the sample alive
+    sample.clear();
+    QCOMPARE(view->name(), QString("myinfo"));
+
+    QGst::SamplePtr noInfo = QGst::Sample::create(QGst::Buffer::create(10),
+            QGst::CapsPtr(), QGst::Segment(), QGst::Structure());
+    QVERIFY(!noInfo->infoView()->isValid());
+    QVERIFY(!noInfo->info().isValid());
+}
+
 
 QTEST_APPLESS_MAIN(StructureTest)
 
@@ -32,9 +32,11 @@ private Q_SLOTS:
     void dateTest();
     void dateTimeTest();
     void copyTest();
+    void copyOnWriteTest();
     void stringsTest();
     void sampleTest();
     void numericTest();
+    void commonTagsTest();
 };
 
 void TagListTest::simpleTest()
@@ -131,6 +133,33 @@ void TagListTest::copyTest()
     QCOMPARE(width, 320);
 }
 
+void TagListTest::copyOnWriteTest()
+{
+    QGst::TagList tl;
+    tl.setTitle("abc");
+
+    //copies share the native list until one of them is modified
+    QGst::TagList tl2(tl);
+    QCOMPARE(static_cast<const GstTagList*>(tl2), static_cast<const GstTagList*>(tl));
+    tl2.setTitle("bcd");
+    QVERIFY(static_cast<const GstTagList*>(tl2) != static_cast<const GstTagList*>(tl));
+    QCOMPARE(tl.title(), QString("abc"));
+    QCOMPARE(tl2.title(), QString("bcd"));
+
+    //a TagList constructed from a native list shares it as well
+    GstTagList *native = gst_tag_list_new(GST_TAG_ARTIST, "def", NULL);
+    QGst::TagList tl3(native);
+    QCOMPARE(static_cast<const GstTagList*>(tl3), static_cast<const GstTagList*>(native));
+    tl3.setArtist("efg");
+    QVERIFY(static_cast<const GstTagList*>(tl3) != static_cast<const GstTagList*>(native));
+    gchar *artist = NULL;
+    QVERIFY(gst_tag_list_get_string(native, GST_TAG_ARTIST, &artist));
+    QCOMPARE(QString::fromUtf8(artist), QString("def"));
+    g_free(artist);
+    QCOMPARE(tl3.artist(), QString("efg"));
+    gst_tag_list_unref(native);
+}
+
 void TagListTest::stringsTest()
 {
     QGst::TagList tl;
@@ -517,6 +546,57 @@ void TagListTest::numericTest()
     QCOMPARE(tl.geoLocationCaptureDirection(), d );
 }
 
+void TagListTest::commonTagsTest()
+{
+    QGst::CommonTags empty = QGst::TagList().commonTags();
+    QVERIFY(empty.title.isEmpty());
+    QCOMPARE(empty.trackNumber, (quint32) 0);
+    QCOMPARE(empty.duration, (quint64) 0);
+    QCOMPARE(empty.imageCount, 0);
+
+    QGst::TagList tl;
+    tl.setTitle("abc");
+    tl.setTitle("bcd", QGst::TagMergeAppend);
+    tl.setArtist("def");
+    tl.setTagValue(GST_TAG_ALBUM, QString("efg"));
+    tl.setGenre("fgh");
+    tl.setComment("ghi");
+    tl.setCodec("hij");
+    tl.setVideoCodec("ijk");
+    tl.setAudioCodec("jkl");
+    tl.setContainerFormat("klm");
+    tl.setLanguageCode("en");
+    tl.setTrackNumber(3);
+    tl.setTrackCount(12);
+    tl.setBitrate(320);
+    tl.setNominalBitrate(256);
+    tl.setDuration(1234567);
+    tl.setPerformer("lmn"); //not a common tag
+
+    QGst::BufferPtr buffer = QGst::Buffer::create(10);
+    QGst::CapsPtr caps = QGst::Caps::createSimple("image/png");
+    QGst::SamplePtr sample = QGst::Sample::create(buffer, caps, QGst::Segment(), QGst::Structure());
+    tl.setImage(sample);
+
+    QGst::CommonTags tags = tl.commonTags();
+    QCOMPARE(tags.title, QString("abc"));
+    QCOMPARE(tags.artist, tl.artist());
+    QCOMPARE(tags.album, QString("efg"));
+    QCOMPARE(tags.genre, tl.genre());
+    QCOMPARE(tags.comment, tl.comment());
+    QCOMPARE(tags.codec, tl.codec());
+    QCOMPARE(tags.videoCodec, tl.videoCodec());
+    QCOMPARE(tags.audioCodec, tl.audioCodec());
+    QCOMPARE(tags.containerFormat, tl.containerFormat());
+    QCOMPARE(tags.languageCode, tl.languageCode());
+    QCOMPARE(tags.trackNumber, (quint32) 3);
+    QCOMPARE(tags.trackCount, (quint32) 12);
+    QCOMPARE(tags.bitrate, (quint32) 320);
+    QCOMPARE(tags.nominalBitrate, (quint32) 256);
+    QCOMPARE(tags.duration, (quint64) 1234567);
+    QCOMPARE(tags.imageCount, 1);
+}
+
 QTEST_APPLESS_MAIN(TagListTest)
 
 #include "moc_qgsttest.cpp"
@@ -43,6 +43,7 @@ private Q_SLOTS:
     void qdebugTest();
     void datetimeTest();
     void errorTest();
+    void valueArrayViewTest();
 };
 
 void ValueTest::intTest()
@@ -275,6 +276,41 @@ void ValueTest::errorTest()
     QCOMPARE(error.code(), 42);
 }
 
+void ValueTest::valueArrayViewTest()
+{
+    {
+        //assigning to the Values of an owned view writes to its GValues
+        QGlib::Private::ValueArrayView values(2);
+        values.at(0) = QGlib::Value(10);
+        QCOMPARE(G_VALUE_TYPE(&values.values()[0]), G_TYPE_INT);
+        QCOMPARE(g_value_get_int(&values.values()[0]), 10);
+
+        values.at(0) = QGlib::Value(QString("foo"));
+        values.at(1) = values.at(0);
+        QCOMPARE(QString::fromUtf8(g_value_get_string(&values.values()[1])), QString("foo"));
+
+        QGlib::Value copy = values.at(1);
+        values.at(0) = QGlib::Value();
+        QVERIFY(!G_IS_VALUE(&values.values()[0]));
+        values.at(1) = QGlib::Value(20);
+        QCOMPARE(copy.get<QString>(), QString("foo"));
+    }
+
+    //assigning to the Values of a borrowed view detaches them
+    GValue gvalue;
+    memset(&gvalue, 0, sizeof(GValue));
+    g_value_init(&gvalue, G_TYPE_INT);
+    g_value_set_int(&gvalue, 5);
+    {
+        QGlib::Private::ValueArrayView values(&gvalue, 1);
+        QCOMPARE(values.at(0).get<int>(), 5);
+        values.at(0) = QGlib::Value(7);
+        QCOMPARE(values.at(0).get<int>(), 7);
+        QCOMPARE(g_value_get_int(&gvalue), 5);
+    }
+    g_value_unset(&gvalue);
+}
+
 QTEST_APPLESS_MAIN(ValueTest)
 
 #include "moc_qgsttest.cpp"
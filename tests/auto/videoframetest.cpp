@@ -0,0 +1,122 @@
+/*
+    Copyright (C) 2026  agent <agent@local>
+
+    This library is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "qgsttest.h"
+#include <QGst/VideoFrame>
+#include <QGst/Segment>
+#include <QGst/Structure>
+
+class VideoFrameTest : public QGstTest
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void planarTest();
+    void packedTest();
+    void sampleTest();
+    void invalidTest();
+};
+
+static QGst::CapsPtr videoCaps(const char *format)
+{
+    return QGst::Caps::fromString(QString("video/x-raw, format=(string)%1, width=(int)320, "
+                                          "height=(int)240, framerate=(fraction)30/1")
+                                          .arg(format));
+}
+
+void VideoFrameTest::planarTest()
+{
+    QGst::BufferPtr buffer = QGst::Buffer::create(320 * 240 * 3 / 2);
+    QGst::VideoFrame frame(buffer, videoCaps("I420"));
+
+    QVERIFY(frame.isValid());
+    QCOMPARE(frame.width(), 320);
+    QCOMPARE(frame.height(), 240);
+    QCOMPARE(QByteArray(frame.formatName()), QByteArray("I420"));
+    QCOMPARE(frame.planeCount(), 3U);
+    QCOMPARE(frame.componentCount(), 3U);
+    QCOMPARE(static_cast<GstBuffer*>(frame.buffer()), static_cast<GstBuffer*>(buffer));
+
+    QGst::VideoPlane y = frame.plane(0);
+    QGst::VideoPlane u = frame.plane(1);
+    QCOMPARE(y.stride(), 320);
+    QCOMPARE(u.stride(), 160);
+    QCOMPARE(u.data(), y.data() + 320 * 240);
+    QCOMPARE(y.line(2), y.data() + 2 * 320);
+    QVERIFY(frame.plane(3).isNull());
+
+    QGst::VideoComponent v = frame.component(2);
+    QCOMPARE(v.width(), 160);
+    QCOMPARE(v.height(), 120);
+    QCOMPARE(v.pixelStride(), 1);
+    QCOMPARE(v.depth(), 8);
+    QCOMPARE(v.plane(), 2U);
+    QCOMPARE(v.data(), frame.plane(2).data());
+}
+
+void VideoFrameTest::packedTest()
+{
+    QGst::BufferPtr buffer = QGst::Buffer::create(320 * 240 * 4);
+    QGst::VideoFrame frame(buffer, videoCaps("xRGB"), QGst::MapRead | QGst::MapWrite);
+
+    QVERIFY(frame.isValid());
+    QVERIFY(frame.flags() & QGst::MapWrite);
+    QCOMPARE(frame.planeCount(), 1U);
+    QCOMPARE(frame.componentCount(), 3U);
+
+    //red is the second byte of each pixel
+    QGst::VideoComponent red = frame.component(0);
+    QCOMPARE(red.data(), frame.plane(0).data() + 1);
+    QCOMPARE(red.pixelStride(), 4);
+    QCOMPARE(red.stride(), 320 * 4);
+}
+
+void VideoFrameTest::sampleTest()
+{
+    QGst::BufferPtr buffer = QGst::Buffer::create(320 * 240 * 4);
+    QGst::SamplePtr sample = QGst::Sample::create(buffer, videoCaps("RGBA"),
+                                                  QGst::Segment(), QGst::Structure());
+    QGst::VideoFrame frame(sample);
+    QVERIFY(frame.isValid());
+    QCOMPARE(frame.size(), static_cast<size_t>(320 * 240 * 4));
+
+    //a read-only map of a shared buffer must not copy it
+    QGst::MapInfo info;
+    QVERIFY(buffer->map(info, QGst::MapRead));
+    QCOMPARE(frame.plane(0).data(), info.data());
+    buffer->unmap(info);
+
+    frame.unmap();
+    QVERIFY(!frame.isValid());
+    QCOMPARE(frame.planeCount(), 0U);
+}
+
+void VideoFrameTest::invalidTest()
+{
+    QGst::VideoFrame frame;
+    QVERIFY(!frame.isValid());
+    QVERIFY(frame.buffer().isNull());
+
+    //too small for the format
+    QVERIFY(!frame.map(QGst::Buffer::create(16), videoCaps("I420")));
+    //not raw video
+    QVERIFY(!frame.map(QGst::Buffer::create(16), QGst::Caps::fromString("audio/x-raw")));
+    QVERIFY(!frame.map(QGst::SamplePtr()));
+}
+
+QTEST_APPLESS_MAIN(VideoFrameTest)
+
+#include "moc_qgsttest.cpp"
+#include "videoframetest.moc"